@@ -7,106 +7,319 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "api_types.h"
 
 #define MLD_44_PUBLICKEYBYTES 1312
 #define MLD_44_SECRETKEYBYTES 2560
+#define MLD_44_EXPANDEDPUBLICKEYBYTES 13152
 #define MLD_44_BYTES 2420
 
 #define MLD_44_ref_PUBLICKEYBYTES MLD_44_PUBLICKEYBYTES
 #define MLD_44_ref_SECRETKEYBYTES MLD_44_SECRETKEYBYTES
+#define MLD_44_ref_EXPANDEDPUBLICKEYBYTES MLD_44_EXPANDEDPUBLICKEYBYTES
 #define MLD_44_ref_BYTES MLD_44_BYTES
 
 int MLD_44_ref_keypair(uint8_t *pk, uint8_t *sk);
 
+int MLD_44_ref_keypair_batch(uint8_t *pks, uint8_t *sks,
+                             const uint8_t *seeds, size_t n);
+
 int MLD_44_ref_signature(uint8_t *sig, size_t *siglen, const uint8_t *m,
                          size_t mlen, const uint8_t *ctx, size_t ctxlen,
                          const uint8_t *sk);
 
+int MLD_44_ref_signature_iov(uint8_t *sig, size_t *siglen,
+                             const mld_iovec *iov, size_t iovcnt,
+                             const uint8_t *ctx, size_t ctxlen,
+                             const uint8_t *sk);
+
 int MLD_44_ref(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen,
                const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
 
+int MLD_44_ref_inplace(uint8_t *sm, size_t *smlen, size_t mlen,
+                       const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
+
 int MLD_44_ref_verify(const uint8_t *sig, size_t siglen, const uint8_t *m,
                       size_t mlen, const uint8_t *ctx, size_t ctxlen,
                       const uint8_t *pk);
 
+int MLD_44_ref_verify_iov(const uint8_t *sig, size_t siglen,
+                          const mld_iovec *iov, size_t iovcnt,
+                          const uint8_t *ctx, size_t ctxlen,
+                          const uint8_t *pk);
+
 int MLD_44_ref_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen,
                     const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
 
+int MLD_44_ref_open_inplace(const uint8_t **m, size_t *mlen,
+                            const uint8_t *sm, size_t smlen,
+                            const uint8_t *ctx, size_t ctxlen,
+                            const uint8_t *pk);
+
+/* Only available if MLD_CONFIG_VERIFY_CACHE is set, see config.h */
+void MLD_44_ref_verify_cache_clear(void);
+
+void MLD_44_ref_verify_cache_counters(uint64_t *hits, uint64_t *misses);
+
+/* Only available if MLD_CONFIG_STATS is set, see config.h */
+void MLD_44_ref_stats_get(mld_sign_stats *stats);
+
+void MLD_44_ref_stats_reset(void);
+
+/* Only available if MLD_CONFIG_OPCOUNT is set, see config.h. In multilevel
+ * builds, the counters are shared by all levels; use MLD_ref_opcount_get()
+ * and MLD_ref_opcount_reset() instead. */
+void MLD_44_ref_opcount_get(mld_opcount *counts);
+
+void MLD_44_ref_opcount_reset(void);
+
+int MLD_44_ref_sig_precheck(const uint8_t *sig, size_t siglen);
+
+int MLD_44_ref_expand_pk(uint8_t *epk, const uint8_t *pk);
+
+int MLD_44_ref_verify_expanded(const uint8_t *sig, size_t siglen,
+                               const uint8_t *m, size_t mlen,
+                               const uint8_t *ctx, size_t ctxlen,
+                               const uint8_t *epk);
+
 #define MLD_65_PUBLICKEYBYTES 1952
 #define MLD_65_SECRETKEYBYTES 4032
+#define MLD_65_EXPANDEDPUBLICKEYBYTES 24096
 #define MLD_65_BYTES 3309
 
 #define MLD_65_ref_PUBLICKEYBYTES MLD_65_PUBLICKEYBYTES
 #define MLD_65_ref_SECRETKEYBYTES MLD_65_SECRETKEYBYTES
+#define MLD_65_ref_EXPANDEDPUBLICKEYBYTES MLD_65_EXPANDEDPUBLICKEYBYTES
 #define MLD_65_ref_BYTES MLD_65_BYTES
 
 int MLD_65_ref_keypair(uint8_t *pk, uint8_t *sk);
 
+int MLD_65_ref_keypair_batch(uint8_t *pks, uint8_t *sks,
+                             const uint8_t *seeds, size_t n);
+
 int MLD_65_ref_signature(uint8_t *sig, size_t *siglen, const uint8_t *m,
                          size_t mlen, const uint8_t *ctx, size_t ctxlen,
                          const uint8_t *sk);
 
+int MLD_65_ref_signature_iov(uint8_t *sig, size_t *siglen,
+                             const mld_iovec *iov, size_t iovcnt,
+                             const uint8_t *ctx, size_t ctxlen,
+                             const uint8_t *sk);
+
 int MLD_65_ref(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen,
                const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
 
+int MLD_65_ref_inplace(uint8_t *sm, size_t *smlen, size_t mlen,
+                       const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
+
 int MLD_65_ref_verify(const uint8_t *sig, size_t siglen, const uint8_t *m,
                       size_t mlen, const uint8_t *ctx, size_t ctxlen,
                       const uint8_t *pk);
 
+int MLD_65_ref_verify_iov(const uint8_t *sig, size_t siglen,
+                          const mld_iovec *iov, size_t iovcnt,
+                          const uint8_t *ctx, size_t ctxlen,
+                          const uint8_t *pk);
+
 int MLD_65_ref_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen,
                     const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
 
+int MLD_65_ref_open_inplace(const uint8_t **m, size_t *mlen,
+                            const uint8_t *sm, size_t smlen,
+                            const uint8_t *ctx, size_t ctxlen,
+                            const uint8_t *pk);
+
+/* Only available if MLD_CONFIG_VERIFY_CACHE is set, see config.h */
+void MLD_65_ref_verify_cache_clear(void);
+
+void MLD_65_ref_verify_cache_counters(uint64_t *hits, uint64_t *misses);
+
+/* Only available if MLD_CONFIG_STATS is set, see config.h */
+void MLD_65_ref_stats_get(mld_sign_stats *stats);
+
+void MLD_65_ref_stats_reset(void);
+
+/* Only available if MLD_CONFIG_OPCOUNT is set, see config.h. In multilevel
+ * builds, the counters are shared by all levels; use MLD_ref_opcount_get()
+ * and MLD_ref_opcount_reset() instead. */
+void MLD_65_ref_opcount_get(mld_opcount *counts);
+
+void MLD_65_ref_opcount_reset(void);
+
+int MLD_65_ref_sig_precheck(const uint8_t *sig, size_t siglen);
+
+int MLD_65_ref_expand_pk(uint8_t *epk, const uint8_t *pk);
+
+int MLD_65_ref_verify_expanded(const uint8_t *sig, size_t siglen,
+                               const uint8_t *m, size_t mlen,
+                               const uint8_t *ctx, size_t ctxlen,
+                               const uint8_t *epk);
+
 #define MLD_87_PUBLICKEYBYTES 2592
 #define MLD_87_SECRETKEYBYTES 4896
+#define MLD_87_EXPANDEDPUBLICKEYBYTES 43872
 #define MLD_87_BYTES 4627
 
 #define MLD_87_ref_PUBLICKEYBYTES MLD_87_PUBLICKEYBYTES
 #define MLD_87_ref_SECRETKEYBYTES MLD_87_SECRETKEYBYTES
+#define MLD_87_ref_EXPANDEDPUBLICKEYBYTES MLD_87_EXPANDEDPUBLICKEYBYTES
 #define MLD_87_ref_BYTES MLD_87_BYTES
 
 int MLD_87_ref_keypair(uint8_t *pk, uint8_t *sk);
 
+int MLD_87_ref_keypair_batch(uint8_t *pks, uint8_t *sks,
+                             const uint8_t *seeds, size_t n);
+
 int MLD_87_ref_signature(uint8_t *sig, size_t *siglen, const uint8_t *m,
                          size_t mlen, const uint8_t *ctx, size_t ctxlen,
                          const uint8_t *sk);
 
+int MLD_87_ref_signature_iov(uint8_t *sig, size_t *siglen,
+                             const mld_iovec *iov, size_t iovcnt,
+                             const uint8_t *ctx, size_t ctxlen,
+                             const uint8_t *sk);
+
 int MLD_87_ref(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen,
                const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
 
+int MLD_87_ref_inplace(uint8_t *sm, size_t *smlen, size_t mlen,
+                       const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
+
 int MLD_87_ref_verify(const uint8_t *sig, size_t siglen, const uint8_t *m,
                       size_t mlen, const uint8_t *ctx, size_t ctxlen,
                       const uint8_t *pk);
 
+int MLD_87_ref_verify_iov(const uint8_t *sig, size_t siglen,
+                          const mld_iovec *iov, size_t iovcnt,
+                          const uint8_t *ctx, size_t ctxlen,
+                          const uint8_t *pk);
+
 int MLD_87_ref_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen,
                     const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
 
+int MLD_87_ref_open_inplace(const uint8_t **m, size_t *mlen,
+                            const uint8_t *sm, size_t smlen,
+                            const uint8_t *ctx, size_t ctxlen,
+                            const uint8_t *pk);
+
+/* Only available if MLD_CONFIG_VERIFY_CACHE is set, see config.h */
+void MLD_87_ref_verify_cache_clear(void);
+
+void MLD_87_ref_verify_cache_counters(uint64_t *hits, uint64_t *misses);
+
+/* Only available if MLD_CONFIG_STATS is set, see config.h */
+void MLD_87_ref_stats_get(mld_sign_stats *stats);
+
+void MLD_87_ref_stats_reset(void);
+
+/* Only available if MLD_CONFIG_OPCOUNT is set, see config.h. In multilevel
+ * builds, the counters are shared by all levels; use MLD_ref_opcount_get()
+ * and MLD_ref_opcount_reset() instead. */
+void MLD_87_ref_opcount_get(mld_opcount *counts);
+
+void MLD_87_ref_opcount_reset(void);
+
+int MLD_87_ref_sig_precheck(const uint8_t *sig, size_t siglen);
+
+int MLD_87_ref_expand_pk(uint8_t *epk, const uint8_t *pk);
+
+int MLD_87_ref_verify_expanded(const uint8_t *sig, size_t siglen,
+                               const uint8_t *m, size_t mlen,
+                               const uint8_t *ctx, size_t ctxlen,
+                               const uint8_t *epk);
+
+/* Runtime-selected parameter set; only available in multilevel builds, see
+ * MLD_CONFIG_MULTILEVEL_BUILD in config.h. `level` is one of 44, 65, 87.
+ * The functions return -1 for any other level, and otherwise behave like
+ * the corresponding MLD_{44,65,87}_ref_* functions. */
+int mldsa_keypair(int level, uint8_t *pk, uint8_t *sk);
+
+int mldsa_sign(int level, uint8_t *sig, size_t *siglen, const uint8_t *m,
+               size_t mlen, const uint8_t *ctx, size_t ctxlen,
+               const uint8_t *sk);
+
+int mldsa_verify(int level, const uint8_t *sig, size_t siglen,
+                 const uint8_t *m, size_t mlen, const uint8_t *ctx,
+                 size_t ctxlen, const uint8_t *pk);
+
+/* Only available in multilevel builds with MLD_CONFIG_OPCOUNT set, see
+ * config.h. The counters are shared by all levels. */
+void MLD_ref_opcount_get(mld_opcount *counts);
+
+void MLD_ref_opcount_reset(void);
+
 #if MLDSA_MODE == 2
 #define CRYPTO_PUBLICKEYBYTES MLD_44_PUBLICKEYBYTES
 #define CRYPTO_SECRETKEYBYTES MLD_44_SECRETKEYBYTES
+#define CRYPTO_EXPANDEDPUBLICKEYBYTES MLD_44_EXPANDEDPUBLICKEYBYTES
 #define CRYPTO_BYTES MLD_44_BYTES
 #define crypto_sign_keypair MLD_44_ref_keypair
+#define crypto_sign_keypair_batch MLD_44_ref_keypair_batch
 #define crypto_sign_signature MLD_44_ref_signature
+#define crypto_sign_signature_iov MLD_44_ref_signature_iov
 #define crypto_sign MLD_44_ref
+#define crypto_sign_inplace MLD_44_ref_inplace
 #define crypto_sign_verify MLD_44_ref_verify
+#define crypto_sign_verify_iov MLD_44_ref_verify_iov
 #define crypto_sign_open MLD_44_ref_open
+#define crypto_sign_open_inplace MLD_44_ref_open_inplace
+#define crypto_sign_sig_precheck MLD_44_ref_sig_precheck
+#define crypto_sign_verify_cache_clear MLD_44_ref_verify_cache_clear
+#define crypto_sign_verify_cache_counters MLD_44_ref_verify_cache_counters
+#define crypto_sign_stats_get MLD_44_ref_stats_get
+#define crypto_sign_stats_reset MLD_44_ref_stats_reset
+#define crypto_sign_opcount_get MLD_44_ref_opcount_get
+#define crypto_sign_opcount_reset MLD_44_ref_opcount_reset
+#define crypto_sign_expand_pk MLD_44_ref_expand_pk
+#define crypto_sign_verify_expanded MLD_44_ref_verify_expanded
 #elif MLDSA_MODE == 3
 #define CRYPTO_PUBLICKEYBYTES MLD_65_PUBLICKEYBYTES
 #define CRYPTO_SECRETKEYBYTES MLD_65_SECRETKEYBYTES
+#define CRYPTO_EXPANDEDPUBLICKEYBYTES MLD_65_EXPANDEDPUBLICKEYBYTES
 #define CRYPTO_BYTES MLD_65_BYTES
 #define crypto_sign_keypair MLD_65_ref_keypair
+#define crypto_sign_keypair_batch MLD_65_ref_keypair_batch
 #define crypto_sign_signature MLD_65_ref_signature
+#define crypto_sign_signature_iov MLD_65_ref_signature_iov
 #define crypto_sign MLD_65_ref
+#define crypto_sign_inplace MLD_65_ref_inplace
 #define crypto_sign_verify MLD_65_ref_verify
+#define crypto_sign_verify_iov MLD_65_ref_verify_iov
 #define crypto_sign_open MLD_65_ref_open
+#define crypto_sign_open_inplace MLD_65_ref_open_inplace
+#define crypto_sign_sig_precheck MLD_65_ref_sig_precheck
+#define crypto_sign_verify_cache_clear MLD_65_ref_verify_cache_clear
+#define crypto_sign_verify_cache_counters MLD_65_ref_verify_cache_counters
+#define crypto_sign_stats_get MLD_65_ref_stats_get
+#define crypto_sign_stats_reset MLD_65_ref_stats_reset
+#define crypto_sign_opcount_get MLD_65_ref_opcount_get
+#define crypto_sign_opcount_reset MLD_65_ref_opcount_reset
+#define crypto_sign_expand_pk MLD_65_ref_expand_pk
+#define crypto_sign_verify_expanded MLD_65_ref_verify_expanded
 #elif MLDSA_MODE == 5
 #define CRYPTO_PUBLICKEYBYTES MLD_87_PUBLICKEYBYTES
 #define CRYPTO_SECRETKEYBYTES MLD_87_SECRETKEYBYTES
+#define CRYPTO_EXPANDEDPUBLICKEYBYTES MLD_87_EXPANDEDPUBLICKEYBYTES
 #define CRYPTO_BYTES MLD_87_BYTES
 #define crypto_sign_keypair MLD_87_ref_keypair
+#define crypto_sign_keypair_batch MLD_87_ref_keypair_batch
 #define crypto_sign_signature MLD_87_ref_signature
+#define crypto_sign_signature_iov MLD_87_ref_signature_iov
 #define crypto_sign MLD_87_ref
+#define crypto_sign_inplace MLD_87_ref_inplace
 #define crypto_sign_verify MLD_87_ref_verify
+#define crypto_sign_verify_iov MLD_87_ref_verify_iov
 #define crypto_sign_open MLD_87_ref_open
+#define crypto_sign_open_inplace MLD_87_ref_open_inplace
+#define crypto_sign_sig_precheck MLD_87_ref_sig_precheck
+#define crypto_sign_verify_cache_clear MLD_87_ref_verify_cache_clear
+#define crypto_sign_verify_cache_counters MLD_87_ref_verify_cache_counters
+#define crypto_sign_stats_get MLD_87_ref_stats_get
+#define crypto_sign_stats_reset MLD_87_ref_stats_reset
+#define crypto_sign_opcount_get MLD_87_ref_opcount_get
+#define crypto_sign_opcount_reset MLD_87_ref_opcount_reset
+#define crypto_sign_expand_pk MLD_87_ref_expand_pk
+#define crypto_sign_verify_expanded MLD_87_ref_verify_expanded
 #endif /* MLDSA_MODE == 5 */
 
 
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#ifndef MLD_API_TYPES_H
+#define MLD_API_TYPES_H
+
+/* Types of the public API. They are shared by api.h and the internal
+ * headers, so this header must not depend on the parameter set or the
+ * configuration. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* One segment of a message given as a list of buffers, see
+ * crypto_sign_signature_iov() and crypto_sign_verify_iov(). */
+typedef struct
+{
+  const uint8_t *ptr;
+  size_t len;
+} mld_iovec;
+
+/* Reasons for rejecting a signing attempt, indexing mld_sign_stats.rejects */
+#define MLD_STATS_REJECT_Z 0    /* ||z||_inf >= GAMMA1 - BETA */
+#define MLD_STATS_REJECT_W0 1   /* ||r0||_inf >= GAMMA2 - BETA */
+#define MLD_STATS_REJECT_H 2    /* ||ct0||_inf >= GAMMA2 */
+#define MLD_STATS_REJECT_HINT 3 /* more than OMEGA hints */
+#define MLD_STATS_NUM_REJECTS 4
+
+/* Number of buckets of the histogram of attempts per signature */
+#define MLD_STATS_MAX_ATTEMPTS 16
+
+/* Signing statistics of the calling thread, see crypto_sign_stats_get()
+ * and MLD_CONFIG_STATS */
+typedef struct
+{
+  /* Number of signatures produced */
+  uint64_t signatures;
+  /* Number of signing attempts, including rejected ones */
+  uint64_t attempts;
+  /* Number of attempts of the most recent signature */
+  uint64_t last_attempts;
+  /* attempts_hist[i] is the number of signatures that took i + 1 attempts;
+   * the last bucket also counts all signatures taking more attempts. */
+  uint64_t attempts_hist[MLD_STATS_MAX_ATTEMPTS];
+  /* Number of rejected attempts by reason, see MLD_STATS_REJECT_xxx */
+  uint64_t rejects[MLD_STATS_NUM_REJECTS];
+  /* Number of XOF blocks squeezed by the rejection samplers on top of
+   * the initial estimate. Blocks of the 4-way XOF count individually. */
+  uint64_t xof_extra_blocks;
+} mld_sign_stats;
+
+/* Operations counted by MLD_CONFIG_OPCOUNT, indexing mld_opcount.count */
+#define MLD_OPCOUNT_KECCAK_X1 0   /* Keccak-f[1600] permutations */
+#define MLD_OPCOUNT_KECCAK_X4 1   /* 4-way Keccak-f[1600] permutations */
+#define MLD_OPCOUNT_NTT 2         /* forward NTTs of a polynomial */
+#define MLD_OPCOUNT_INVNTT 3      /* inverse NTTs of a polynomial */
+#define MLD_OPCOUNT_MATRIX_POLY 4 /* polynomials of A expanded from rho */
+#define MLD_OPCOUNT_XOF_REFILL 5  /* refill iterations of rejection samplers */
+#define MLD_OPCOUNT_NUM 6
+
+/* Operation counts of the calling thread, see crypto_sign_opcount_get()
+ * and MLD_CONFIG_OPCOUNT */
+typedef struct
+{
+  uint64_t count[MLD_OPCOUNT_NUM];
+} mld_opcount;
+
+#endif /* !MLD_API_TYPES_H */
@@ -12,10 +12,41 @@
 #include "config.h"
 #endif
 
+/* Namespace for level-independent code. In a multilevel build, this code
+ * is compiled once and shared between the parameter sets; otherwise, it is
+ * namespaced per level like everything else. */
+#if defined(MLD_CONFIG_MULTILEVEL_BUILD)
+#define MLD_NAMESPACE_SHARED(s) MLD_ref_##s
+#else
+#define MLD_NAMESPACE_SHARED(s) MLD_NAMESPACE(s)
+#endif
+
 #include "cbmc.h"
 #include "params.h"
 #include "sys.h"
 
+/* Native backend functions that may decline to handle an input return
+ * MLD_NATIVE_FUNC_FALLBACK, in which case the caller uses the C code. */
+#define MLD_NATIVE_FUNC_SUCCESS (0)
+#define MLD_NATIVE_FUNC_FALLBACK (-1)
+
+#if !defined(__ASSEMBLER__)
+#if defined(MLD_SYS_X86_64_AVX2_DISPATCH)
+#define mld_sys_has_avx2 MLD_NAMESPACE_SHARED(sys_has_avx2)
+/*************************************************
+ * Name:        mld_sys_has_avx2
+ *
+ * Description: Check whether the CPU and OS support the instruction set
+ *              extensions used by the AVX2 backends. CPUID is only queried
+ *              on the first call; see sys.c.
+ *
+ * Returns 1 if AVX2 backends can be used, 0 otherwise.
+ **************************************************/
+int mld_sys_has_avx2(void);
+#elif defined(MLD_SYS_X86_64_AVX2)
+#define mld_sys_has_avx2() 1
+#endif
+#endif /* !__ASSEMBLER__ */
 
 #if defined(MLD_CONFIG_USE_NATIVE_BACKEND_ARITH) && \
     !defined(MLD_CONFIG_ARITH_BACKEND_FILE)
@@ -33,9 +64,9 @@
  * in front of assembly symbols. We thus introducee a separate
  * namespace wrapper for ASM symbols. */
 #if !defined(__APPLE__)
-#define MLD_ASM_NAMESPACE(sym) MLD_NAMESPACE(sym)
+#define MLD_ASM_NAMESPACE(sym) MLD_NAMESPACE_SHARED(sym)
 #else
-#define MLD_ASM_NAMESPACE(sym) MLD_CONCAT(_, MLD_NAMESPACE(sym))
+#define MLD_ASM_NAMESPACE(sym) MLD_CONCAT(_, MLD_NAMESPACE_SHARED(sym))
 #endif
 
 /*
@@ -89,8 +120,26 @@ static MLD_INLINE void mld_zeroize(void *ptr, size_t len)
   SecureZeroMemory(ptr, len);
 }
 #elif defined(MLD_HAVE_INLINE_ASM)
+/* Buffers of at least this many bytes are wiped with `rep stosb` on x86_64.
+ * On CPUs with enhanced `rep movsb/stosb` (ERMS), this uses full cache-line
+ * stores (without read-for-ownership) and beats an out-of-line memset()
+ * for the large signing workspaces. The threshold follows glibc's default
+ * for switching to `rep stosb`. */
+#define MLD_ZEROIZE_REP_STOSB_THRESHOLD 2048
 static MLD_INLINE void mld_zeroize(void *ptr, size_t len)
 {
+#if defined(MLD_SYS_X86_64) && !defined(CBMC)
+  if (len >= MLD_ZEROIZE_REP_STOSB_THRESHOLD)
+  {
+    /* The volatile asm with memory clobber cannot be elided by the
+     * compiler, so no additional barrier is needed. */
+    __asm__ __volatile__("rep stosb"
+                         : "+D"(ptr), "+c"(len)
+                         : "a"(0)
+                         : "memory");
+    return;
+  }
+#endif /* MLD_SYS_X86_64 && !CBMC */
   memset(ptr, 0, len);
   /* This follows OpenSSL and seems sufficient to prevent the compiler
    * from optimizing away the memset.
@@ -41,6 +41,39 @@
  *****************************************************************************/
 /* #define MLD_CONFIG_FILE "config.h" */
 
+/******************************************************************************
+ * Name:        MLD_CONFIG_MULTILEVEL_BUILD
+ *
+ * Description: Set this option when building mldsa-native for multiple
+ *              parameter sets into a single library or binary.
+ *
+ *              Level-independent code (FIPS202, NTT, modular reduction,
+ *              constant-time helpers, native backends) is then namespaced
+ *              without the parameter set (MLD_ref_*) and shared between
+ *              the levels. The dispatchers mldsa_keypair(), mldsa_sign()
+ *              and mldsa_verify() from api.h are also provided.
+ *
+ *              Exactly one of the builds must include the shared code;
+ *              all others must set MLD_CONFIG_MULTILEVEL_NO_SHARED.
+ *              All builds must use the same configuration apart from
+ *              MLDSA_MODE and MLD_CONFIG_MULTILEVEL_NO_SHARED.
+ *
+ *              See the `$(BUILD_DIR)/libmldsa_multilevel.a` target in
+ *              test/mk/components.mk, which `make lib` builds.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_MULTILEVEL_BUILD */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_MULTILEVEL_NO_SHARED
+ *
+ * Description: If this option is set, level-independent code is omitted
+ *              from the build. This is used for all but one of the builds
+ *              in a multilevel build; see MLD_CONFIG_MULTILEVEL_BUILD.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_MULTILEVEL_NO_SHARED */
+
 /******************************************************************************
  * Name:        MLD_CONFIG_ARITH_BACKEND_FILE
  *
@@ -205,6 +238,222 @@
  *****************************************************************************/
 /* #define MLD_CONFIG_NO_ASM_VALUE_BARRIER */
 
+/******************************************************************************
+ * Name:        MLD_CONFIG_RUNTIME_CPU_DISPATCH
+ *
+ * Description: If this option is set, the x86_64 AVX2 backends for
+ *              arithmetic and FIPS202 are compiled in even if the compiler
+ *              does not target AVX2 (i.e. __AVX2__ is unset). On first use,
+ *              CPUID is queried once, and the native functions fall back to
+ *              the portable C code if the CPU or OS lacks AVX2/BMI2 support.
+ *
+ *              This allows a single binary built for baseline x86_64 to run
+ *              at full speed on AVX2-capable CPUs. If AVX2 is enabled at
+ *              compile-time, this option has no effect.
+ *
+ *              Requires GCC or clang, and inline assembly (CPUID).
+ *
+ *              Note: The output of crypto_sign_expand_pk() uses the backend's
+ *              NTT order and must not be shared between machines.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_RUNTIME_CPU_DISPATCH */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_RUNTIME_CPU_DISPATCH_FALLBACK_TEST
+ *
+ * Description: If this option is set, the user must provide a runtime
+ *              function `static inline int mld_force_cpu_fallback() { ... }`
+ *              to indicate whether the CPU check should report AVX2 as
+ *              unavailable. This allows testing the portable fallback on
+ *              AVX2-capable machines. Like CPUID, the function is only
+ *              evaluated once.
+ *
+ *              This option only has an effect if
+ *              MLD_CONFIG_RUNTIME_CPU_DISPATCH is set.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_RUNTIME_CPU_DISPATCH_FALLBACK_TEST
+   #if !defined(__ASSEMBLER__)
+   #include "sys.h"
+   static MLD_INLINE int mld_force_cpu_fallback(void)
+   {
+       ... return 0/1 depending on whether AVX2 should be ignored ...
+   }
+   #endif
+*/
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_SMALL_SECRETS
+ *
+ * Description: If this option is set, the secret vectors s1 and s2 are kept
+ *              in normal domain with int16_t coefficients during signing,
+ *              rather than in NTT domain with int32_t coefficients. The
+ *              products c*s1 and c*s2 are then computed directly from the
+ *              sparse challenge c, without NTT.
+ *
+ *              This halves the memory footprint of s1 and s2 and avoids
+ *              MLDSA_K + MLDSA_L inverse NTTs per signing attempt.
+ *              On targets with a fast native NTT, the sparse multiplication
+ *              is typically slower, so this is not enabled by default.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_SMALL_SECRETS */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_REDUCE_RAM
+ *
+ * Description: If this option is set, the matrix A is never held in memory
+ *              as a whole. Instead, each row is regenerated from rho when
+ *              it is needed, so that only a single row is live at any time.
+ *              In addition, signing keeps the mask vector y bit-packed
+ *              between its uses, computes z one polynomial at a time and
+ *              bit-packs it straight into the signature, and lets the NTT
+ *              of y share storage with w0, and w1 with the hint vector.
+ *
+ *              This roughly halves the peak stack usage of key generation,
+ *              signing and verification, at the cost of re-sampling A in
+ *              every signing attempt. The remaining footprint is dominated
+ *              by the unpacked secret key (s1, s2, t0) and the K-vectors
+ *              w0, w2 and h. Use `make run_stack` to measure the effect on
+ *              a given target.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_REDUCE_RAM */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_REDUCE_RAM_CACHE_ROWS
+ *
+ * Description: Only relevant if MLD_CONFIG_REDUCE_RAM is set.
+ *
+ *              If this option is set, signing generates the rows of A once
+ *              per signature and caches them in the 23-bit packed format of
+ *              mld_polyvec_matrix_pack(), rather than re-sampling them in
+ *              every rejection-sampling attempt. This trades
+ *              MLDSA_POLYMAT_PACKEDBYTES of memory for signing speed.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_REDUCE_RAM_CACHE_ROWS */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_VERIFY_CACHE
+ *
+ * Description: If this option is set, crypto_sign_verify() (and hence
+ *              crypto_sign_open()) remembers successful verifications in a
+ *              bounded in-memory cache keyed by a SHAKE256 digest of the
+ *              public key, signature, context string and message. Verifying
+ *              the same tuple again then costs one hash and a lookup.
+ *              Failed verifications are never cached.
+ *
+ *              The cache holds MLD_CONFIG_VERIFY_CACHE_SIZE entries
+ *              (default 256) per parameter set, in sets of 8 selected by
+ *              the digest, so that a lookup only compares 8 entries. Each
+ *              set evicts entries using the CLOCK policy. If the size is
+ *              not a multiple of 8, the remaining entries are unused.
+ *              crypto_sign_verify_cache_clear() empties the cache, and
+ *              crypto_sign_verify_cache_counters() reports the number of
+ *              cache hits and misses.
+ *
+ *              Accesses are serialized by a spinlock based on the GCC/clang
+ *              __atomic builtins. To use a different lock, or if those are
+ *              unavailable, set MLD_CONFIG_VERIFY_CACHE_CUSTOM_LOCK and
+ *              define `mld_verify_cache_lock_native()` and
+ *              `mld_verify_cache_unlock_native()`.
+ *
+ *              Note: The time taken by crypto_sign_verify() reveals whether
+ *              a tuple has been verified before. Verification inputs are
+ *              usually public, but consider this before enabling the cache.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_VERIFY_CACHE */
+/* #define MLD_CONFIG_VERIFY_CACHE_SIZE 256 */
+/* #define MLD_CONFIG_VERIFY_CACHE_CUSTOM_LOCK
+   #if !defined(__ASSEMBLER__)
+   static MLD_INLINE void mld_verify_cache_lock_native(void)
+   {
+       ... your implementation ...
+   }
+   static MLD_INLINE void mld_verify_cache_unlock_native(void)
+   {
+       ... your implementation ...
+   }
+   #endif
+*/
+
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_STATS
+ *
+ * Description: If this option is set, the signing functions record
+ *              statistics about the rejection loop in thread-local
+ *              counters: the number of attempts per signature, the
+ *              reasons for rejected attempts, and the number of XOF blocks
+ *              the rejection samplers squeeze beyond their initial
+ *              estimate. crypto_sign_stats_get() and
+ *              crypto_sign_stats_reset() read and clear the counters of
+ *              the calling thread.
+ *
+ *              Thread-local storage requires C11 or a compiler supporting
+ *              `__thread` (GCC, clang) or `__declspec(thread)` (MSVC).
+ *
+ *              Note: The counters reveal the number of signing attempts,
+ *              which is not secret but also observable through timing.
+ *              This option is meant for profiling and is unset by default.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_STATS */
+
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_PROFILE_HOOK
+ *
+ * Description: If this option is set, key generation, signing and
+ *              verification call the hooks
+ *
+ *              void mld_profile_begin(unsigned phase);
+ *              void mld_profile_end(unsigned phase);
+ *
+ *              at the start and end of each of their phases (hashing,
+ *              matrix expansion, sampling, NTTs, rounding, packing, ...),
+ *              see mldsa/profile.h for the list of phases. The hooks must
+ *              be provided by the user; test/hal/profile.c is a reference
+ *              implementation producing a per-phase cycle breakdown in
+ *              flame graph format.
+ *
+ *              If this option is unset (the default), the hooks compile to
+ *              nothing.
+ *
+ *              Note: The hooks observe the number of signing attempts,
+ *              which is not secret but also observable through timing.
+ *              This option is meant for profiling only.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_PROFILE_HOOK */
+
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_OPCOUNT
+ *
+ * Description: If this option is set, the library counts, in thread-local
+ *              counters, the Keccak-f[1600] permutations (1-way and 4-way),
+ *              the forward and inverse NTTs, the polynomials of the matrix
+ *              A expanded from rho, and the refill iterations of the
+ *              rejection samplers. crypto_sign_opcount_get() and
+ *              crypto_sign_opcount_reset() read and clear the counters of
+ *              the calling thread.
+ *
+ *              Unlike cycle counts, these counts are deterministic for a
+ *              fixed key, message and randomness, and are meant as a cost
+ *              model for regression tracking; see test/bench_opcount.c.
+ *
+ *              In multilevel builds, the counters are level-independent
+ *              and shared between all parameter sets.
+ *
+ *              Thread-local storage is required as for MLD_CONFIG_STATS.
+ *              This option is meant for profiling and is unset by default.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_OPCOUNT */
 
 
 #endif /* !MLD_CONFIG_H */
@@ -67,7 +67,7 @@
  * Declaration of global volatile that the global value barrier
  * is loading from and masking with.
  */
-#define mld_ct_opt_blocker_u64 MLD_NAMESPACE(ct_opt_blocker_u64)
+#define mld_ct_opt_blocker_u64 MLD_NAMESPACE_SHARED(ct_opt_blocker_u64)
 extern volatile uint64_t mld_ct_opt_blocker_u64;
 
 
@@ -8,7 +8,7 @@
 
 #include "common.h"
 
-#if defined(MLDSA_DEBUG)
+#if defined(MLDSA_DEBUG) && !defined(MLD_CONFIG_MULTILEVEL_NO_SHARED)
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -53,11 +53,11 @@ void mld_debug_check_bounds(const char *file, int line, const int32_t *ptr,
   }
 }
 
-#else /* MLDSA_DEBUG */
+#else /* MLDSA_DEBUG && !MLD_CONFIG_MULTILEVEL_NO_SHARED */
 
 MLD_EMPTY_CU(debug)
 
-#endif /* !MLDSA_DEBUG */
+#endif /* !(MLDSA_DEBUG && !MLD_CONFIG_MULTILEVEL_NO_SHARED) */
 
 /* To facilitate single-compilation-unit (SCU) builds, undefine all macros.
  * Don't modify by hand -- this is auto-generated by scripts/autogen. */
@@ -10,9 +10,12 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "../opcount.h"
 #include "fips202.h"
 #include "keccakf1600.h"
 
+#if !defined(MLD_CONFIG_MULTILEVEL_NO_SHARED)
+
 #define NROUNDS 24
 #define ROL(a, offset) ((a << offset) ^ (a >> (64 - offset)))
 
@@ -140,6 +143,7 @@ __contract__(
       s[i / 8] ^= (uint64_t)*in++ << 8 * (i % 8);
     }
     inlen -= r - pos;
+    MLD_OPCOUNT(MLD_OPCOUNT_KECCAK_X1, 1);
     mld_keccakf1600_permute(s);
     pos = 0;
   }
@@ -228,6 +232,7 @@ __contract__(
   {
     if (pos == r)
     {
+      MLD_OPCOUNT(MLD_OPCOUNT_KECCAK_X1, 1);
       mld_keccakf1600_permute(s);
       pos = 0;
     }
@@ -291,6 +296,7 @@ __contract__(
     }
     in += r;
     inlen -= r;
+    MLD_OPCOUNT(MLD_OPCOUNT_KECCAK_X1, 1);
     mld_keccakf1600_permute(s);
   }
 
@@ -336,6 +342,7 @@ __contract__(
     invariant(out == loop_entry(out) + r * (loop_entry(nblocks) - nblocks))
   )
   {
+    MLD_OPCOUNT(MLD_OPCOUNT_KECCAK_X1, 1);
     mld_keccakf1600_permute(s);
     mld_keccakf1600_extract_bytes(s, out, 0, r);
     out += r;
@@ -606,6 +613,7 @@ void sha3_256(uint8_t h[SHA3_256_HASHBYTES], const uint8_t *in, size_t inlen)
   uint64_t s[MLD_KECCAK_LANES];
 
   keccak_absorb_once(s, SHA3_256_RATE, in, inlen, 0x06);
+  MLD_OPCOUNT(MLD_OPCOUNT_KECCAK_X1, 1);
   mld_keccakf1600_permute(s);
   for (i = 0; i < 4; i++)
   __loop__(invariant(i <= 4))
@@ -632,6 +640,7 @@ void sha3_512(uint8_t h[SHA3_512_HASHBYTES], const uint8_t *in, size_t inlen)
   uint64_t s[MLD_KECCAK_LANES];
 
   keccak_absorb_once(s, SHA3_512_RATE, in, inlen, 0x06);
+  MLD_OPCOUNT(MLD_OPCOUNT_KECCAK_X1, 1);
   mld_keccakf1600_permute(s);
   for (i = 0; i < 8; i++)
   __loop__(invariant(i <= 8))
@@ -642,3 +651,9 @@ void sha3_512(uint8_t h[SHA3_512_HASHBYTES], const uint8_t *in, size_t inlen)
   /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
   mld_zeroize(s, sizeof(s));
 }
+
+#else /* !MLD_CONFIG_MULTILEVEL_NO_SHARED */
+
+MLD_EMPTY_CU(fips202)
+
+#endif /* MLD_CONFIG_MULTILEVEL_NO_SHARED */
@@ -7,10 +7,13 @@
 #include "../common.h"
 
 #include <string.h>
+#include "../opcount.h"
 #include "fips202.h"
 #include "fips202x4.h"
 #include "keccakf1600.h"
 
+#if !defined(MLD_CONFIG_MULTILEVEL_NO_SHARED)
+
 static void mld_keccak_absorb_once_x4(uint64_t *s, uint32_t r,
                                       const uint8_t *in0, const uint8_t *in1,
                                       const uint8_t *in2, const uint8_t *in3,
@@ -34,6 +37,7 @@ __contract__(
     invariant(in3 == loop_entry(in3) + (loop_entry(inlen) - inlen)))
   {
     mld_keccakf1600x4_xor_bytes(s, in0, in1, in2, in3, 0, r);
+    MLD_OPCOUNT(MLD_OPCOUNT_KECCAK_X4, 1);
     mld_keccakf1600x4_permute(s);
 
     in0 += r;
@@ -92,6 +96,7 @@ __contract__(
       out2 == loop_entry(out2) + r * (loop_entry(nblocks) - nblocks) &&
       out3 == loop_entry(out3) + r * (loop_entry(nblocks) - nblocks)))
   {
+    MLD_OPCOUNT(MLD_OPCOUNT_KECCAK_X4, 1);
     mld_keccakf1600x4_permute(s);
     mld_keccakf1600x4_extract_bytes(s, out0, out1, out2, out3, 0, r);
 
@@ -151,3 +156,9 @@ void mld_shake256x4_release(mld_shake256x4ctx *state)
   /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
   mld_zeroize(state, sizeof(mld_shake256x4ctx));
 }
+
+#else /* !MLD_CONFIG_MULTILEVEL_NO_SHARED */
+
+MLD_EMPTY_CU(fips202x4)
+
+#endif /* MLD_CONFIG_MULTILEVEL_NO_SHARED */
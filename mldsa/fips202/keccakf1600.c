@@ -112,17 +112,21 @@ void mld_keccakf1600x4_xor_bytes(uint64_t *state, const unsigned char *data0,
 
 void mld_keccakf1600x4_permute(uint64_t *state)
 {
-#if defined(MLD_USE_FIPS202_X4_NATIVE)
-  mld_keccak_f1600_x4_native(state);
-#elif defined(MLD_USE_FIPS202_X2_NATIVE)
+#if defined(MLD_USE_FIPS202_X2_NATIVE) && !defined(MLD_USE_FIPS202_X4_NATIVE)
   mld_keccak_f1600_x2_native(state + 0 * MLD_KECCAK_LANES);
   mld_keccak_f1600_x2_native(state + 2 * MLD_KECCAK_LANES);
 #else
+#if defined(MLD_USE_FIPS202_X4_NATIVE)
+  if (mld_keccak_f1600_x4_native(state) == MLD_NATIVE_FUNC_SUCCESS)
+  {
+    return;
+  }
+#endif
   mld_keccakf1600_permute(state + MLD_KECCAK_LANES * 0);
   mld_keccakf1600_permute(state + MLD_KECCAK_LANES * 1);
   mld_keccakf1600_permute(state + MLD_KECCAK_LANES * 2);
   mld_keccakf1600_permute(state + MLD_KECCAK_LANES * 3);
-#endif /* !MLD_USE_FIPS202_X4_NATIVE && !MLD_USE_FIPS202_X2_NATIVE */
+#endif /* !MLD_USE_FIPS202_X2_NATIVE || MLD_USE_FIPS202_X4_NATIVE */
 }
 
 #if !defined(MLD_USE_FIPS202_X1_NATIVE)
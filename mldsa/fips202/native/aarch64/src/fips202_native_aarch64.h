@@ -12,10 +12,11 @@
 
 
 #define mld_keccakf1600_round_constants \
-  MLD_NAMESPACE(keccakf1600_round_constants)
+  MLD_NAMESPACE_SHARED(keccakf1600_round_constants)
 extern const uint64_t mld_keccakf1600_round_constants[];
 
-#define mld_keccak_f1600_x1_scalar_asm MLD_NAMESPACE(keccak_f1600_x1_scalar_asm)
+#define mld_keccak_f1600_x1_scalar_asm \
+  MLD_NAMESPACE_SHARED(keccak_f1600_x1_scalar_asm)
 void mld_keccak_f1600_x1_scalar_asm(uint64_t *state, uint64_t const *rc)
 __contract__(
   requires(memory_no_alias(state, sizeof(uint64_t) * 25 * 1))
@@ -23,7 +24,8 @@ __contract__(
   assigns(memory_slice(state, sizeof(uint64_t) * 25 * 1))
 );
 
-#define mld_keccak_f1600_x1_v84a_asm MLD_NAMESPACE(keccak_f1600_x1_v84a_asm)
+#define mld_keccak_f1600_x1_v84a_asm \
+  MLD_NAMESPACE_SHARED(keccak_f1600_x1_v84a_asm)
 void mld_keccak_f1600_x1_v84a_asm(uint64_t *state, uint64_t const *rc)
 __contract__(
   requires(memory_no_alias(state, sizeof(uint64_t) * 25 * 1))
@@ -31,7 +33,8 @@ __contract__(
   assigns(memory_slice(state, sizeof(uint64_t) * 25 * 1))
 );
 
-#define mld_keccak_f1600_x2_v84a_asm MLD_NAMESPACE(keccak_f1600_x2_v84a_asm)
+#define mld_keccak_f1600_x2_v84a_asm \
+  MLD_NAMESPACE_SHARED(keccak_f1600_x2_v84a_asm)
 void mld_keccak_f1600_x2_v84a_asm(uint64_t *state, uint64_t const *rc)
 __contract__(
   requires(memory_no_alias(state, sizeof(uint64_t) * 25 * 2))
@@ -40,7 +43,7 @@ __contract__(
 );
 
 #define mld_keccak_f1600_x4_scalar_v8a_hybrid_asm \
-  MLD_NAMESPACE(keccak_f1600_x4_scalar_v8a_hybrid_asm)
+  MLD_NAMESPACE_SHARED(keccak_f1600_x4_scalar_v8a_hybrid_asm)
 void mld_keccak_f1600_x4_scalar_v8a_hybrid_asm(uint64_t *state,
                                                uint64_t const *rc)
 __contract__(
@@ -50,7 +53,7 @@ __contract__(
 );
 
 #define mld_keccak_f1600_x4_scalar_v8a_v84a_hybrid_asm \
-  MLD_NAMESPACE(keccak_f1600_x4_scalar_v8a_v84a_hybrid_asm)
+  MLD_NAMESPACE_SHARED(keccak_f1600_x4_scalar_v8a_v84a_hybrid_asm)
 void mld_keccak_f1600_x4_scalar_v8a_v84a_hybrid_asm(uint64_t *state,
                                                     uint64_t const *rc)
 __contract__(
@@ -14,10 +14,11 @@
 
 #if !defined(__ASSEMBLER__)
 #include "src/fips202_native_aarch64.h"
-static MLD_INLINE void mld_keccak_f1600_x4_native(uint64_t *state)
+static MLD_INLINE int mld_keccak_f1600_x4_native(uint64_t *state)
 {
   mld_keccak_f1600_x4_scalar_v8a_hybrid_asm(state,
                                             mld_keccakf1600_round_constants);
+  return MLD_NATIVE_FUNC_SUCCESS;
 }
 #endif /* !__ASSEMBLER__ */
 
@@ -35,7 +35,9 @@ static MLD_INLINE void mld_keccak_f1600_x1_native(uint64_t *state);
 static MLD_INLINE void mld_keccak_f1600_x2_native(uint64_t *state);
 #endif
 #if defined(MLD_USE_FIPS202_X4_NATIVE)
-static MLD_INLINE void mld_keccak_f1600_x4_native(uint64_t *state);
+/* Returns MLD_NATIVE_FUNC_SUCCESS, or MLD_NATIVE_FUNC_FALLBACK (leaving the
+ * state unmodified) if the implementation cannot be used on this CPU. */
+static MLD_INLINE int mld_keccak_f1600_x4_native(uint64_t *state);
 #endif
 
 #endif /* !MLD_FIPS202_NATIVE_API_H */
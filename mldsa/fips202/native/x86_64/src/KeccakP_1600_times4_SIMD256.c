@@ -448,7 +448,7 @@ static MLD_ALIGN const uint64_t keccakf1600RoundConstants[24] = {
     thetaRhoPiChiIota(23, E, A)
 /* clang-format on */
 
-void mld_keccakf1600x4_permute24(void *states)
+MLD_TARGET_AVX2 void mld_keccakf1600x4_permute24(void *states)
 {
   __m256i *statesAsLanes = (__m256i *)states;
   declareABCDE copyFromState(A, statesAsLanes)
@@ -10,7 +10,7 @@
 #include "../../../../common.h"
 
 #define mld_keccakf1600x4_permute24 \
-  MLD_NAMESPACE(KeccakP1600times4_PermuteAll_24rounds)
+  MLD_NAMESPACE_SHARED(KeccakP1600times4_PermuteAll_24rounds)
 void mld_keccakf1600x4_permute24(void *states);
 
 #endif /* !MLD_FIPS202_NATIVE_X86_64_SRC_KECCAKP_1600_TIMES4_SIMD256_H */
@@ -16,9 +16,14 @@
 #include "src/KeccakP_1600_times4_SIMD256.h"
 
 #define MLD_USE_FIPS202_X4_NATIVE
-static MLD_INLINE void mld_keccak_f1600_x4_native(uint64_t *state)
+static MLD_INLINE int mld_keccak_f1600_x4_native(uint64_t *state)
 {
+  if (!mld_sys_has_avx2())
+  {
+    return MLD_NATIVE_FUNC_FALLBACK;
+  }
   mld_keccakf1600x4_permute24(state);
+  return MLD_NATIVE_FUNC_SUCCESS;
 }
 #endif /* !__ASSEMBLER__ */
 
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+
+/*
+ * WARNING: This file is auto-generated from scripts/autogen
+ *          Do not modify it directly.
+ */
+
+/*
+ * Single-compilation-unit (SCU) build of mldsa-native for the
+ * parameter set selected by MLDSA_MODE.
+ *
+ * Compiling this file instead of the individual C sources allows the
+ * compiler to inline across modules without link-time optimization.
+ * Assembly sources (*.S) of the native backends are not included and
+ * must still be compiled and linked separately.
+ *
+ * To link several parameter sets into one binary, compile this file
+ * once per level as a multilevel build, see MLD_CONFIG_MULTILEVEL_BUILD
+ * and MLD_CONFIG_MULTILEVEL_NO_SHARED in config.h. Otherwise, the
+ * level-independent code is defined once per level.
+ */
+
+#include "ct.c"
+#include "debug.c"
+#include "ntt.c"
+#include "opcount.c"
+#include "packing.c"
+#include "poly.c"
+#include "polyvec.c"
+#include "reduce.c"
+#include "rounding.c"
+#include "sign.c"
+#include "stats.c"
+#include "sys.c"
+#include "verify_cache.c"
+#include "fips202/fips202.c"
+#include "fips202/fips202x4.c"
+#include "fips202/keccakf1600.c"
+#include "native/aarch64/src/aarch64_zetas.c"
+#include "native/aarch64/src/rej_uniform_eta_table.c"
+#include "native/aarch64/src/rej_uniform_table.c"
+#include "native/x86_64/src/consts.c"
+#include "native/x86_64/src/rej_uniform_avx2.c"
+#include "native/x86_64/src/rej_uniform_eta2_avx2.c"
+#include "native/x86_64/src/rej_uniform_eta4_avx2.c"
+#include "native/x86_64/src/rej_uniform_table.c"
+#include "fips202/native/aarch64/src/keccakf1600_round_constants.c"
+#include "fips202/native/x86_64/src/KeccakP_1600_times4_SIMD256.c"
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+/* The dispatchers only use the public API. The internal headers are not
+ * included, as they define the same CRYPTO_* and crypto_sign_* names. */
+#if defined(MLD_CONFIG_FILE)
+#include MLD_CONFIG_FILE
+#else
+#include "config.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+#if defined(MLD_CONFIG_MULTILEVEL_BUILD) && \
+    !defined(MLD_CONFIG_MULTILEVEL_NO_SHARED)
+
+int mldsa_keypair(int level, uint8_t *pk, uint8_t *sk)
+{
+  switch (level)
+  {
+    case 44:
+      return MLD_44_ref_keypair(pk, sk);
+    case 65:
+      return MLD_65_ref_keypair(pk, sk);
+    case 87:
+      return MLD_87_ref_keypair(pk, sk);
+    default:
+      return -1;
+  }
+}
+
+int mldsa_sign(int level, uint8_t *sig, size_t *siglen, const uint8_t *m,
+               size_t mlen, const uint8_t *ctx, size_t ctxlen,
+               const uint8_t *sk)
+{
+  switch (level)
+  {
+    case 44:
+      return MLD_44_ref_signature(sig, siglen, m, mlen, ctx, ctxlen, sk);
+    case 65:
+      return MLD_65_ref_signature(sig, siglen, m, mlen, ctx, ctxlen, sk);
+    case 87:
+      return MLD_87_ref_signature(sig, siglen, m, mlen, ctx, ctxlen, sk);
+    default:
+      return -1;
+  }
+}
+
+int mldsa_verify(int level, const uint8_t *sig, size_t siglen,
+                 const uint8_t *m, size_t mlen, const uint8_t *ctx,
+                 size_t ctxlen, const uint8_t *pk)
+{
+  switch (level)
+  {
+    case 44:
+      return MLD_44_ref_verify(sig, siglen, m, mlen, ctx, ctxlen, pk);
+    case 65:
+      return MLD_65_ref_verify(sig, siglen, m, mlen, ctx, ctxlen, pk);
+    case 87:
+      return MLD_87_ref_verify(sig, siglen, m, mlen, ctx, ctxlen, pk);
+    default:
+      return -1;
+  }
+}
+
+#else /* MLD_CONFIG_MULTILEVEL_BUILD && !MLD_CONFIG_MULTILEVEL_NO_SHARED */
+
+/* See MLD_EMPTY_CU() in common.h */
+extern int MLD_NAMESPACE(empty_cu_multilevel);
+
+#endif /* !(MLD_CONFIG_MULTILEVEL_BUILD && \
+          !MLD_CONFIG_MULTILEVEL_NO_SHARED) */
@@ -11,14 +11,14 @@
 #include "../../../common.h"
 
 #define mld_aarch64_ntt_zetas_layer123456 \
-  MLD_NAMESPACE(mld_aarch64_ntt_zetas_layer123456)
+  MLD_NAMESPACE_SHARED(mld_aarch64_ntt_zetas_layer123456)
 #define mld_aarch64_ntt_zetas_layer78 \
-  MLD_NAMESPACE(mld_aarch64_ntt_zetas_layer78)
+  MLD_NAMESPACE_SHARED(mld_aarch64_ntt_zetas_layer78)
 
 #define mld_aarch64_intt_zetas_layer78 \
-  MLD_NAMESPACE(mld_aarch64_intt_zetas_layer78)
+  MLD_NAMESPACE_SHARED(mld_aarch64_intt_zetas_layer78)
 #define mld_aarch64_intt_zetas_layer123456 \
-  MLD_NAMESPACE(mld_aarch64_intt_zetas_layer123456)
+  MLD_NAMESPACE_SHARED(mld_aarch64_intt_zetas_layer123456)
 
 extern const int32_t mld_aarch64_ntt_zetas_layer123456[];
 extern const int32_t mld_aarch64_ntt_zetas_layer78[];
@@ -44,21 +44,21 @@ extern const uint8_t mld_rej_uniform_eta_table[];
  */
 #define MLD_AARCH64_REJ_UNIFORM_ETA4_BUFLEN (2 * 136)
 
-#define mld_ntt_asm MLD_NAMESPACE(ntt_asm)
+#define mld_ntt_asm MLD_NAMESPACE_SHARED(ntt_asm)
 void mld_ntt_asm(int32_t *, const int32_t *, const int32_t *);
 
-#define mld_intt_asm MLD_NAMESPACE(intt_asm)
+#define mld_intt_asm MLD_NAMESPACE_SHARED(intt_asm)
 void mld_intt_asm(int32_t *, const int32_t *, const int32_t *);
 
-#define mld_rej_uniform_asm MLD_NAMESPACE(rej_uniform_asm)
+#define mld_rej_uniform_asm MLD_NAMESPACE_SHARED(rej_uniform_asm)
 uint64_t mld_rej_uniform_asm(int32_t *r, const uint8_t *buf, unsigned buflen,
                              const uint8_t *table);
 
-#define mld_rej_uniform_eta2_asm MLD_NAMESPACE(rej_uniform_eta2_asm)
+#define mld_rej_uniform_eta2_asm MLD_NAMESPACE_SHARED(rej_uniform_eta2_asm)
 unsigned mld_rej_uniform_eta2_asm(int32_t *r, const uint8_t *buf,
                                   unsigned buflen, const uint8_t *table);
 
-#define mld_rej_uniform_eta4_asm MLD_NAMESPACE(rej_uniform_eta4_asm)
+#define mld_rej_uniform_eta4_asm MLD_NAMESPACE_SHARED(rej_uniform_eta4_asm)
 unsigned mld_rej_uniform_eta4_asm(int32_t *r, const uint8_t *buf,
                                   unsigned buflen, const uint8_t *table);
 
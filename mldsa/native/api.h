@@ -51,8 +51,12 @@
  *              The output polynomial is in bitreversed order.
  *
  * Arguments:   - int32_t p[MLDSA_N]: pointer to in/output polynomial
+ *
+ * Return MLD_NATIVE_FUNC_FALLBACK if the native implementation cannot be
+ * used (e.g. the CPU lacks a required extension), leaving p unmodified.
+ * Otherwise, returns MLD_NATIVE_FUNC_SUCCESS.
  **************************************************/
-static MLD_INLINE void mld_ntt_native(int32_t p[MLDSA_N]);
+static MLD_INLINE int mld_ntt_native(int32_t p[MLDSA_N]);
 #endif /* MLD_USE_NATIVE_NTT */
 
 
@@ -79,8 +83,11 @@ set if there are native implementations for NTT and INTT."
  *
  * Arguments:   - int32_t p[MLDSA_N]: pointer to in/output polynomial
  *
+ * Return MLD_NATIVE_FUNC_FALLBACK, leaving p unmodified, exactly if the
+ * native NTT and INTT fall back to the C implementation. Otherwise, returns
+ * MLD_NATIVE_FUNC_SUCCESS.
  **************************************************/
-static MLD_INLINE void mld_poly_permute_bitrev_to_custom(int32_t p[MLDSA_N]);
+static MLD_INLINE int mld_poly_permute_bitrev_to_custom(int32_t p[MLDSA_N]);
 #endif /* MLD_USE_NATIVE_NTT_CUSTOM_ORDER */
 
 
@@ -95,8 +102,11 @@ static MLD_INLINE void mld_poly_permute_bitrev_to_custom(int32_t p[MLDSA_N]);
  *              The output polynomial is assumed to be in normal order.
  *
  * Arguments:   - uint32_t p[MLDSA_N]: pointer to in/output polynomial
+ *
+ * Return MLD_NATIVE_FUNC_FALLBACK if the native implementation cannot be
+ * used, leaving p unmodified. Otherwise, returns MLD_NATIVE_FUNC_SUCCESS.
  **************************************************/
-static MLD_INLINE void mld_intt_native(int16_t p[MLDSA_N]);
+static MLD_INLINE int mld_intt_native(int16_t p[MLDSA_N]);
 #endif /* MLD_USE_NATIVE_INTT */
 
 #if defined(MLD_USE_NATIVE_REJ_UNIFORM)
@@ -16,7 +16,7 @@
 #include "aarch64/meta.h"
 #endif
 
-#ifdef MLD_SYS_X86_64_AVX2
+#if defined(MLD_SYS_X86_64_AVX2) || defined(MLD_SYS_X86_64_AVX2_DISPATCH)
 #include "x86_64/meta.h"
 #endif
 
@@ -23,18 +23,36 @@
 #include "../../common.h"
 #include "src/arith_native_x86_64.h"
 
-static MLD_INLINE void mld_poly_permute_bitrev_to_custom(int32_t data[MLDSA_N])
+/* With MLD_CONFIG_RUNTIME_CPU_DISPATCH, all functions fall back to the C
+ * implementation if AVX2 is unavailable. The custom NTT order is then not
+ * used either, so that the permutation and the (I)NTT stay consistent. */
+static MLD_INLINE int mld_poly_permute_bitrev_to_custom(int32_t data[MLDSA_N])
 {
+  if (!mld_sys_has_avx2())
+  {
+    return MLD_NATIVE_FUNC_FALLBACK;
+  }
   mld_nttunpack_avx2((__m256i *)(data));
+  return MLD_NATIVE_FUNC_SUCCESS;
 }
 
-static MLD_INLINE void mld_ntt_native(int32_t data[MLDSA_N])
+static MLD_INLINE int mld_ntt_native(int32_t data[MLDSA_N])
 {
+  if (!mld_sys_has_avx2())
+  {
+    return MLD_NATIVE_FUNC_FALLBACK;
+  }
   mld_ntt_avx2((__m256i *)data, mld_qdata.vec);
+  return MLD_NATIVE_FUNC_SUCCESS;
 }
-static MLD_INLINE void mld_intt_native(int32_t data[MLDSA_N])
+static MLD_INLINE int mld_intt_native(int32_t data[MLDSA_N])
 {
+  if (!mld_sys_has_avx2())
+  {
+    return MLD_NATIVE_FUNC_FALLBACK;
+  }
   mld_invntt_avx2((__m256i *)data, mld_qdata.vec);
+  return MLD_NATIVE_FUNC_SUCCESS;
 }
 
 static MLD_INLINE int mld_rej_uniform_native(int32_t *r, unsigned len,
@@ -42,7 +60,8 @@ static MLD_INLINE int mld_rej_uniform_native(int32_t *r, unsigned len,
                                              unsigned buflen)
 {
   /* AVX2 implementation assumes specific buffer lengths */
-  if (len != MLDSA_N || buflen != MLD_AVX2_REJ_UNIFORM_BUFLEN)
+  if (!mld_sys_has_avx2() || len != MLDSA_N ||
+      buflen != MLD_AVX2_REJ_UNIFORM_BUFLEN)
   {
     return -1;
   }
@@ -56,7 +75,8 @@ static MLD_INLINE int mld_rej_uniform_eta2_native(int32_t *r, unsigned len,
 {
   int outlen;
   /* AVX2 implementation assumes specific buffer lengths */
-  if (len != MLDSA_N || buflen != MLD_AVX2_REJ_UNIFORM_ETA2_BUFLEN)
+  if (!mld_sys_has_avx2() || len != MLDSA_N ||
+      buflen != MLD_AVX2_REJ_UNIFORM_ETA2_BUFLEN)
   {
     return -1;
   }
@@ -80,7 +100,8 @@ static MLD_INLINE int mld_rej_uniform_eta4_native(int32_t *r, unsigned len,
 {
   int outlen;
   /* AVX2 implementation assumes specific buffer lengths */
-  if (len != MLDSA_N || buflen != MLD_AVX2_REJ_UNIFORM_ETA4_BUFLEN)
+  if (!mld_sys_has_avx2() || len != MLDSA_N ||
+      buflen != MLD_AVX2_REJ_UNIFORM_ETA4_BUFLEN)
   {
     return -1;
   }
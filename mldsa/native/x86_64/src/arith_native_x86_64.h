@@ -30,27 +30,29 @@
  */
 #define MLD_AVX2_REJ_UNIFORM_ETA4_BUFLEN (2 * 136)
 
-#define mld_rej_uniform_table MLD_NAMESPACE(mld_rej_uniform_table)
+#define mld_rej_uniform_table MLD_NAMESPACE_SHARED(mld_rej_uniform_table)
 extern const uint8_t mld_rej_uniform_table[256][8];
 
-#define mld_ntt_avx2 MLD_NAMESPACE(ntt_avx2)
+#define mld_ntt_avx2 MLD_NAMESPACE_SHARED(ntt_avx2)
 void mld_ntt_avx2(__m256i *r, const __m256i *mld_qdata);
 
-#define mld_invntt_avx2 MLD_NAMESPACE(invntt_avx2)
+#define mld_invntt_avx2 MLD_NAMESPACE_SHARED(invntt_avx2)
 void mld_invntt_avx2(__m256i *r, const __m256i *mld_qdata);
 
-#define mld_nttunpack_avx2 MLD_NAMESPACE(nttunpack_avx2)
+#define mld_nttunpack_avx2 MLD_NAMESPACE_SHARED(nttunpack_avx2)
 void mld_nttunpack_avx2(__m256i *r);
 
-#define mld_rej_uniform_avx2 MLD_NAMESPACE(mld_rej_uniform_avx2)
+#define mld_rej_uniform_avx2 MLD_NAMESPACE_SHARED(mld_rej_uniform_avx2)
 unsigned mld_rej_uniform_avx2(int32_t *r,
                               const uint8_t buf[MLD_AVX2_REJ_UNIFORM_BUFLEN]);
 
-#define mld_rej_uniform_eta2_avx2 MLD_NAMESPACE(mld_rej_uniform_eta2_avx2)
+#define mld_rej_uniform_eta2_avx2 \
+  MLD_NAMESPACE_SHARED(mld_rej_uniform_eta2_avx2)
 unsigned mld_rej_uniform_eta2_avx2(
     int32_t *r, const uint8_t buf[MLD_AVX2_REJ_UNIFORM_ETA2_BUFLEN]);
 
-#define mld_rej_uniform_eta4_avx2 MLD_NAMESPACE(mld_rej_uniform_eta4_avx2)
+#define mld_rej_uniform_eta4_avx2 \
+  MLD_NAMESPACE_SHARED(mld_rej_uniform_eta4_avx2)
 unsigned mld_rej_uniform_eta4_avx2(
     int32_t *r, const uint8_t buf[MLD_AVX2_REJ_UNIFORM_ETA4_BUFLEN]);
 
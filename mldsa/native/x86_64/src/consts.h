@@ -23,7 +23,7 @@
 #ifndef __ASSEMBLER__
 #include "align.h"
 typedef MLD_ALIGNED_INT32(624) qdata_t;
-#define mld_qdata MLD_NAMESPACE(qdata)
+#define mld_qdata MLD_NAMESPACE_SHARED(qdata)
 extern const qdata_t mld_qdata;
 #endif /* !__ASSEMBLER__ */
 
@@ -28,7 +28,7 @@
  *            frontend to perform the unintuitive padding.
  */
 
-unsigned int mld_rej_uniform_avx2(
+MLD_TARGET_AVX2 unsigned int mld_rej_uniform_avx2(
     int32_t *MLD_RESTRICT r, const uint8_t buf[MLD_AVX2_REJ_UNIFORM_BUFLEN])
 {
   unsigned int ctr, pos;
@@ -27,7 +27,7 @@
  *            rej_eta_avx and supports multiple values for ETA via preprocessor
  *            conditionals. We move the conditionals to the frontend.
  */
-unsigned int mld_rej_uniform_eta2_avx2(
+MLD_TARGET_AVX2 unsigned int mld_rej_uniform_eta2_avx2(
     int32_t *MLD_RESTRICT r,
     const uint8_t buf[MLD_AVX2_REJ_UNIFORM_ETA2_BUFLEN])
 {
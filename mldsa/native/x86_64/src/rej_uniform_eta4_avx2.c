@@ -28,7 +28,7 @@
  *            conditionals. We move the conditionals to the frontend.
  */
 
-unsigned int mld_rej_uniform_eta4_avx2(
+MLD_TARGET_AVX2 unsigned int mld_rej_uniform_eta4_avx2(
     int32_t *MLD_RESTRICT r,
     const uint8_t buf[MLD_AVX2_REJ_UNIFORM_ETA4_BUFLEN])
 {
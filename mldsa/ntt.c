@@ -7,6 +7,8 @@
 #include "ntt.h"
 #include "reduce.h"
 
+#if !defined(MLD_CONFIG_MULTILEVEL_NO_SHARED)
+
 static int32_t mld_fqmul(int32_t a, int32_t b)
 __contract__(
   requires(b > -MLDSA_Q_HALF && b < MLDSA_Q_HALF)
@@ -232,3 +234,9 @@ void mld_invntt_tomont(int32_t a[MLDSA_N])
     a[j] = mld_fqscale(a[j]);
   }
 }
+
+#else /* !MLD_CONFIG_MULTILEVEL_NO_SHARED */
+
+MLD_EMPTY_CU(ntt)
+
+#endif /* MLD_CONFIG_MULTILEVEL_NO_SHARED */
@@ -14,7 +14,7 @@
 /* Absolute exclusive upper bound for the output of the inverse NTT*/
 #define MLD_INTT_BOUND 4211139
 
-#define mld_ntt MLD_NAMESPACE(ntt)
+#define mld_ntt MLD_NAMESPACE_SHARED(ntt)
 /*************************************************
  * Name:        mld_ntt
  *
@@ -43,7 +43,7 @@ __contract__(
   ensures(array_abs_bound(a, 0, MLDSA_N, MLD_NTT_BOUND))
 );
 
-#define mld_invntt_tomont MLD_NAMESPACE(invntt_tomont)
+#define mld_invntt_tomont MLD_NAMESPACE_SHARED(invntt_tomont)
 /*************************************************
  * Name:        mld_invntt_tomont
  *
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#include "common.h"
+
+#if defined(MLD_CONFIG_OPCOUNT) && !defined(MLD_CONFIG_MULTILEVEL_NO_SHARED)
+
+#include <string.h>
+#include "opcount.h"
+
+/* The counters are thread-local, so that recording them requires neither
+ * locks nor atomics. */
+#if !defined(MLD_THREAD_LOCAL)
+#error No thread-local storage available for MLD_CONFIG_OPCOUNT.
+#endif
+
+static MLD_THREAD_LOCAL mld_opcount mld_opcounts;
+
+void mld_opcount_add(unsigned op, unsigned n)
+{
+  if (op < MLD_OPCOUNT_NUM)
+  {
+    mld_opcounts.count[op] += n;
+  }
+}
+
+void crypto_sign_opcount_get(mld_opcount *counts) { *counts = mld_opcounts; }
+
+void crypto_sign_opcount_reset(void)
+{
+  memset(&mld_opcounts, 0, sizeof(mld_opcounts));
+}
+
+#else /* MLD_CONFIG_OPCOUNT && !MLD_CONFIG_MULTILEVEL_NO_SHARED */
+
+MLD_EMPTY_CU(opcount)
+
+#endif /* !(MLD_CONFIG_OPCOUNT && !MLD_CONFIG_MULTILEVEL_NO_SHARED) */
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#ifndef MLD_OPCOUNT_H
+#define MLD_OPCOUNT_H
+
+#include <stdint.h>
+#include "api_types.h"
+#include "common.h"
+
+#if defined(MLD_CONFIG_OPCOUNT)
+
+/* The counters are level-independent: in a multilevel build, all parameter
+ * sets share one set of counters, as they share the Keccak code. */
+
+#define mld_opcount_add MLD_NAMESPACE_SHARED(opcount_add)
+/*************************************************
+ * Name:        mld_opcount_add
+ *
+ * Description: Records operations.
+ *
+ * Arguments:   - unsigned op: one of MLD_OPCOUNT_xxx
+ *              - unsigned n:  number of operations
+ **************************************************/
+void mld_opcount_add(unsigned op, unsigned n);
+
+#define crypto_sign_opcount_get MLD_NAMESPACE_SHARED(opcount_get)
+/*************************************************
+ * Name:        crypto_sign_opcount_get
+ *
+ * Description: Returns the operation counts of the calling thread,
+ *              accumulated since the thread started or since the last call
+ *              to crypto_sign_opcount_reset().
+ *
+ * Arguments:   - mld_opcount *counts: pointer to output counts
+ **************************************************/
+void crypto_sign_opcount_get(mld_opcount *counts);
+
+#define crypto_sign_opcount_reset MLD_NAMESPACE_SHARED(opcount_reset)
+/*************************************************
+ * Name:        crypto_sign_opcount_reset
+ *
+ * Description: Resets the operation counts of the calling thread.
+ **************************************************/
+void crypto_sign_opcount_reset(void);
+
+#define MLD_OPCOUNT(op, n) mld_opcount_add(op, n)
+
+#else /* MLD_CONFIG_OPCOUNT */
+
+#define MLD_OPCOUNT(op, n) \
+  do                       \
+  {                        \
+  } while (0)
+
+#endif /* !MLD_CONFIG_OPCOUNT */
+
+#endif /* !MLD_OPCOUNT_H */
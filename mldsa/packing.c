@@ -65,6 +65,12 @@ void mld_pack_sk(uint8_t sk[CRYPTO_SECRETKEYBYTES],
   mld_polyveck_pack_t0(sk, t0);
 }
 
+void mld_pack_sk_tr(uint8_t sk[CRYPTO_SECRETKEYBYTES],
+                    const uint8_t tr[MLDSA_TRBYTES])
+{
+  memcpy(sk + 2 * MLDSA_SEEDBYTES, tr, MLDSA_TRBYTES);
+}
+
 void mld_unpack_sk(uint8_t rho[MLDSA_SEEDBYTES], uint8_t tr[MLDSA_TRBYTES],
                    uint8_t key[MLDSA_SEEDBYTES], mld_polyveck *t0,
                    mld_polyvecl *s1, mld_polyveck *s2,
@@ -88,19 +94,56 @@ void mld_unpack_sk(uint8_t rho[MLDSA_SEEDBYTES], uint8_t tr[MLDSA_TRBYTES],
   mld_polyveck_unpack_t0(t0, sk);
 }
 
-void mld_pack_sig(uint8_t sig[CRYPTO_BYTES], const uint8_t c[MLDSA_CTILDEBYTES],
-                  const mld_polyvecl *z, const mld_polyveck *h,
-                  const unsigned int number_of_hints)
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+void mld_unpack_sk_small(uint8_t rho[MLDSA_SEEDBYTES],
+                         uint8_t tr[MLDSA_TRBYTES],
+                         uint8_t key[MLDSA_SEEDBYTES], mld_polyveck *t0,
+                         mld_polyvecl_small *s1, mld_polyveck_small *s2,
+                         const uint8_t sk[CRYPTO_SECRETKEYBYTES])
 {
-  unsigned int i, j, k;
+  memcpy(rho, sk, MLDSA_SEEDBYTES);
+  sk += MLDSA_SEEDBYTES;
 
-  memcpy(sig, c, MLDSA_CTILDEBYTES);
-  sig += MLDSA_CTILDEBYTES;
+  memcpy(key, sk, MLDSA_SEEDBYTES);
+  sk += MLDSA_SEEDBYTES;
 
-  mld_polyvecl_pack_z(sig, z);
-  sig += MLDSA_L * MLDSA_POLYZ_PACKEDBYTES;
+  memcpy(tr, sk, MLDSA_TRBYTES);
+  sk += MLDSA_TRBYTES;
+
+  mld_polyvecl_unpack_eta_small(s1, sk);
+  sk += MLDSA_L * MLDSA_POLYETA_PACKEDBYTES;
 
-  /* Encode hints h */
+  mld_polyveck_unpack_eta_small(s2, sk);
+  sk += MLDSA_K * MLDSA_POLYETA_PACKEDBYTES;
+
+  mld_polyveck_unpack_t0(t0, sk);
+}
+#endif /* MLD_CONFIG_SMALL_SECRETS */
+
+/*************************************************
+ * Name:        mld_pack_hints
+ *
+ * Description: Encode a hint vector into the final
+ *              MLDSA_POLYVECH_PACKEDBYTES bytes of a signature
+ *
+ * Arguments:   - uint8_t sig[]: output raw hint bytes
+ *              - const mld_polyveck *h: pointer to hint vector h
+ *              - const unsigned int number_of_hints: total
+ *                                   hints in *h
+ **************************************************/
+static void mld_pack_hints(uint8_t sig[MLDSA_POLYVECH_PACKEDBYTES],
+                           const mld_polyveck *h,
+                           const unsigned int number_of_hints)
+__contract__(
+  requires(memory_no_alias(sig, MLDSA_POLYVECH_PACKEDBYTES))
+  requires(memory_no_alias(h, sizeof(mld_polyveck)))
+  requires(forall(k1, 0, MLDSA_K,
+    array_bound(h->vec[k1].coeffs, 0, MLDSA_N, 0, 2)))
+  requires(number_of_hints <= MLDSA_OMEGA)
+  assigns(memory_slice(sig, MLDSA_POLYVECH_PACKEDBYTES))
+)
+{
+  unsigned int i, j, k;
 
   /* The final section of sig[] is MLDSA_POLYVECH_PACKEDBYTES long, where
    * MLDSA_POLYVECH_PACKEDBYTES = MLDSA_OMEGA + MLDSA_K
@@ -157,6 +200,30 @@ void mld_pack_sig(uint8_t sig[CRYPTO_BYTES], const uint8_t c[MLDSA_CTILDEBYTES],
   }
 }
 
+void mld_pack_sig(uint8_t sig[CRYPTO_BYTES], const uint8_t c[MLDSA_CTILDEBYTES],
+                  const mld_polyvecl *z, const mld_polyveck *h,
+                  const unsigned int number_of_hints)
+{
+  memcpy(sig, c, MLDSA_CTILDEBYTES);
+  sig += MLDSA_CTILDEBYTES;
+
+  mld_polyvecl_pack_z(sig, z);
+  sig += MLDSA_L * MLDSA_POLYZ_PACKEDBYTES;
+
+  mld_pack_hints(sig, h, number_of_hints);
+}
+
+#if defined(MLD_CONFIG_REDUCE_RAM)
+void mld_pack_sig_c_h(uint8_t sig[CRYPTO_BYTES],
+                      const uint8_t c[MLDSA_CTILDEBYTES], const mld_polyveck *h,
+                      const unsigned int number_of_hints)
+{
+  memcpy(sig, c, MLDSA_CTILDEBYTES);
+  mld_pack_hints(sig + MLDSA_CTILDEBYTES + MLDSA_L * MLDSA_POLYZ_PACKEDBYTES, h,
+                 number_of_hints);
+}
+#endif /* MLD_CONFIG_REDUCE_RAM */
+
 /*************************************************
  * Name:        mld_unpack_hints
  *
@@ -172,7 +239,7 @@ void mld_pack_sig(uint8_t sig[CRYPTO_BYTES], const uint8_t c[MLDSA_CTILDEBYTES],
 static int mld_unpack_hints(
     mld_polyveck *h, const uint8_t packed_hints[MLDSA_POLYVECH_PACKEDBYTES])
 __contract__(
-  requires(memory_no_alias(packed_hints, MLDSA_POLYVECH_PACKEDBYTES))
+  requires(memory_no_alias(sig, MLDSA_POLYVECH_PACKEDBYTES))
   requires(memory_no_alias(h, sizeof(mld_polyveck)))
   assigns(object_whole(h))
   /* All returned coefficients are either 0 or 1 */
@@ -67,6 +67,26 @@ __contract__(
 );
 
 
+#define mld_pack_sk_tr MLD_NAMESPACE(pack_sk_tr)
+/*************************************************
+ * Name:        mld_pack_sk_tr
+ *
+ * Description: Overwrite the component tr of a packed secret key.
+ *              Used by batched key generation, where tr is only known
+ *              once all public keys of a batch have been packed.
+ *
+ * Arguments:   - uint8_t sk[]: secret key to update
+ *              - const uint8_t tr[]: byte array containing tr
+ **************************************************/
+void mld_pack_sk_tr(uint8_t sk[CRYPTO_SECRETKEYBYTES],
+                    const uint8_t tr[MLDSA_TRBYTES])
+__contract__(
+  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  requires(memory_no_alias(tr, MLDSA_TRBYTES))
+  assigns(memory_slice(sk, CRYPTO_SECRETKEYBYTES))
+);
+
+
 #define mld_pack_sig MLD_NAMESPACE(pack_sig)
 /*************************************************
  * Name:        mld_pack_sig
@@ -101,6 +121,36 @@ __contract__(
   assigns(memory_slice(sig, CRYPTO_BYTES))
 );
 
+#if defined(MLD_CONFIG_REDUCE_RAM)
+#define mld_pack_sig_c_h MLD_NAMESPACE(pack_sig_c_h)
+/*************************************************
+ * Name:        mld_pack_sig_c_h
+ *
+ * Description: Same as mld_pack_sig(), but leaves the bytes of sig that
+ *              hold z untouched, for callers that have already written
+ *              z in place with mld_polyz_pack().
+ *
+ * Arguments:   - uint8_t sig[]: output byte array
+ *              - const uint8_t *c:  pointer to challenge hash length
+ *                                   MLDSA_SEEDBYTES
+ *              - const mld_polyveck *h: pointer to hint vector h
+ *              - const unsigned int number_of_hints: total
+ *                                   hints in *h
+ **************************************************/
+void mld_pack_sig_c_h(uint8_t sig[CRYPTO_BYTES],
+                      const uint8_t c[MLDSA_CTILDEBYTES], const mld_polyveck *h,
+                      const unsigned int number_of_hints)
+__contract__(
+  requires(memory_no_alias(sig, CRYPTO_BYTES))
+  requires(memory_no_alias(c, MLDSA_CTILDEBYTES))
+  requires(memory_no_alias(h, sizeof(mld_polyveck)))
+  requires(forall(k1, 0, MLDSA_K,
+    array_bound(h->vec[k1].coeffs, 0, MLDSA_N, 0, 2)))
+  requires(number_of_hints <= MLDSA_OMEGA)
+  assigns(memory_slice(sig, CRYPTO_BYTES))
+);
+#endif /* MLD_CONFIG_REDUCE_RAM */
+
 #define mld_unpack_pk MLD_NAMESPACE(unpack_pk)
 /*************************************************
  * Name:        mld_unpack_pk
@@ -164,6 +214,50 @@ __contract__(
     array_bound(s2->vec[k2].coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
 );
 
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+#define mld_unpack_sk_small MLD_NAMESPACE(unpack_sk_small)
+/*************************************************
+ * Name:        mld_unpack_sk_small
+ *
+ * Description: Same as mld_unpack_sk(), but unpacking s1 and s2 into
+ *              half-width storage.
+ *
+ * Arguments:   - const uint8_t rho[]: output byte array for rho
+ *              - const uint8_t tr[]: output byte array for tr
+ *              - const uint8_t key[]: output byte array for key
+ *              - const mld_polyveck *t0: pointer to output vector t0
+ *              - const mld_polyvecl_small *s1: pointer to output vector s1
+ *              - const mld_polyveck_small *s2: pointer to output vector s2
+ *              - uint8_t sk[]: byte array containing bit-packed sk
+ **************************************************/
+void mld_unpack_sk_small(uint8_t rho[MLDSA_SEEDBYTES],
+                         uint8_t tr[MLDSA_TRBYTES],
+                         uint8_t key[MLDSA_SEEDBYTES], mld_polyveck *t0,
+                         mld_polyvecl_small *s1, mld_polyveck_small *s2,
+                         const uint8_t sk[CRYPTO_SECRETKEYBYTES])
+__contract__(
+  requires(memory_no_alias(rho, MLDSA_SEEDBYTES))
+  requires(memory_no_alias(tr, MLDSA_TRBYTES))
+  requires(memory_no_alias(key, MLDSA_SEEDBYTES))
+  requires(memory_no_alias(t0, sizeof(mld_polyveck)))
+  requires(memory_no_alias(s1, sizeof(mld_polyvecl_small)))
+  requires(memory_no_alias(s2, sizeof(mld_polyveck_small)))
+  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  assigns(object_whole(rho))
+  assigns(object_whole(tr))
+  assigns(object_whole(key))
+  assigns(object_whole(t0))
+  assigns(object_whole(s1))
+  assigns(object_whole(s2))
+  ensures(forall(k0, 0, MLDSA_K,
+    array_bound(t0->vec[k0].coeffs, 0, MLDSA_N, -(1<<(MLDSA_D-1)) + 1, (1<<(MLDSA_D-1)) + 1)))
+  ensures(forall(k1, 0, MLDSA_L,
+    array_bound(s1->vec[k1].coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
+  ensures(forall(k2, 0, MLDSA_K,
+    array_bound(s2->vec[k2].coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
+);
+#endif /* MLD_CONFIG_SMALL_SECRETS */
+
 #define mld_unpack_sig MLD_NAMESPACE(unpack_sig)
 /*************************************************
  * Name:        mld_unpack_sig
@@ -67,6 +67,10 @@
 #define MLDSA_POLYT0_PACKEDBYTES 416
 #define MLDSA_POLYVECH_PACKEDBYTES (MLDSA_OMEGA + MLDSA_K)
 
+/* Compact 23-bit in-memory encoding of the expanded matrix A */
+#define MLDSA_POLYA_PACKEDBYTES 736
+#define MLDSA_POLYMAT_PACKEDBYTES (MLDSA_K * MLDSA_L * MLDSA_POLYA_PACKEDBYTES)
+
 #define CRYPTO_PUBLICKEYBYTES \
   (MLDSA_SEEDBYTES + MLDSA_K * MLDSA_POLYT1_PACKEDBYTES)
 #define CRYPTO_SECRETKEYBYTES                                                  \
@@ -75,5 +79,7 @@
 #define CRYPTO_BYTES                                       \
   (MLDSA_CTILDEBYTES + MLDSA_L * MLDSA_POLYZ_PACKEDBYTES + \
    MLDSA_POLYVECH_PACKEDBYTES)
+#define CRYPTO_EXPANDEDPUBLICKEYBYTES \
+  (CRYPTO_PUBLICKEYBYTES + MLDSA_TRBYTES + MLDSA_POLYMAT_PACKEDBYTES)
 
 #endif /* !MLD_PARAMS_H */
@@ -10,9 +10,11 @@
 #include "debug.h"
 #include "fips202/fips202x4.h"
 #include "ntt.h"
+#include "opcount.h"
 #include "poly.h"
 #include "reduce.h"
 #include "rounding.h"
+#include "stats.h"
 #include "symmetric.h"
 
 void mld_poly_reduce(mld_poly *a)
@@ -104,37 +106,35 @@ void mld_poly_shiftl(mld_poly *a)
   }
 }
 
-#if !defined(MLD_USE_NATIVE_NTT)
 void mld_poly_ntt(mld_poly *a)
 {
   mld_assert_abs_bound(a->coeffs, MLDSA_N, MLDSA_Q);
+  MLD_OPCOUNT(MLD_OPCOUNT_NTT, 1);
+#if defined(MLD_USE_NATIVE_NTT)
+  if (mld_ntt_native(a->coeffs) == MLD_NATIVE_FUNC_SUCCESS)
+  {
+    mld_assert_abs_bound(a->coeffs, MLDSA_N, MLD_NTT_BOUND);
+    return;
+  }
+#endif /* MLD_USE_NATIVE_NTT */
   mld_ntt(a->coeffs);
   mld_assert_abs_bound(a->coeffs, MLDSA_N, MLD_NTT_BOUND);
 }
-#else  /* !MLD_USE_NATIVE_NTT */
-void mld_poly_ntt(mld_poly *p)
-{
-  mld_assert_abs_bound(p->coeffs, MLDSA_N, MLDSA_Q);
-  mld_ntt_native(p->coeffs);
-  mld_assert_abs_bound(p->coeffs, MLDSA_N, MLD_NTT_BOUND);
-}
-#endif /* MLD_USE_NATIVE_NTT */
 
-#if !defined(MLD_USE_NATIVE_INTT)
 void mld_poly_invntt_tomont(mld_poly *a)
 {
   mld_assert_abs_bound(a->coeffs, MLDSA_N, MLDSA_Q);
+  MLD_OPCOUNT(MLD_OPCOUNT_INVNTT, 1);
+#if defined(MLD_USE_NATIVE_INTT)
+  if (mld_intt_native(a->coeffs) == MLD_NATIVE_FUNC_SUCCESS)
+  {
+    mld_assert_abs_bound(a->coeffs, MLDSA_N, MLDSA_Q);
+    return;
+  }
+#endif /* MLD_USE_NATIVE_INTT */
   mld_invntt_tomont(a->coeffs);
   mld_assert_abs_bound(a->coeffs, MLDSA_N, MLD_INTT_BOUND);
 }
-#else  /* !MLD_USE_NATIVE_INTT */
-void mld_poly_invntt_tomont(mld_poly *a)
-{
-  mld_assert_abs_bound(a->coeffs, MLDSA_N, MLDSA_Q);
-  mld_intt_native(a->coeffs);
-  mld_assert_abs_bound(a->coeffs, MLDSA_N, MLDSA_Q);
-}
-#endif /* MLD_USE_NATIVE_INTT */
 
 void mld_poly_pointwise_montgomery(mld_poly *c, const mld_poly *a,
                                    const mld_poly *b)
@@ -359,6 +359,7 @@ void mld_poly_uniform(mld_poly *a, const uint8_t seed[MLDSA_SEEDBYTES + 2])
   MLD_ALIGN uint8_t buf[POLY_UNIFORM_NBLOCKS * STREAM128_BLOCKBYTES];
   mld_xof128_ctx state;
 
+  MLD_OPCOUNT(MLD_OPCOUNT_MATRIX_POLY, 1);
   mld_xof128_init(&state);
   mld_xof128_absorb(&state, seed, MLDSA_SEEDBYTES + 2);
   mld_xof128_squeezeblocks(buf, POLY_UNIFORM_NBLOCKS, &state);
@@ -373,6 +374,8 @@ void mld_poly_uniform(mld_poly *a, const uint8_t seed[MLDSA_SEEDBYTES + 2])
     invariant(array_bound(a->coeffs, 0, ctr, 0, MLDSA_Q)))
   {
     mld_xof128_squeezeblocks(buf, 1, &state);
+    MLD_STATS_XOF_BLOCKS(1);
+    MLD_OPCOUNT(MLD_OPCOUNT_XOF_REFILL, 1);
     ctr = mld_rej_uniform(a->coeffs, MLDSA_N, ctr, buf, buflen);
   }
   mld_xof128_release(&state);
@@ -394,6 +397,7 @@ void mld_poly_uniform_4x(mld_poly *vec0, mld_poly *vec1, mld_poly *vec2,
   mld_xof128_x4_ctx state;
   unsigned buflen;
 
+  MLD_OPCOUNT(MLD_OPCOUNT_MATRIX_POLY, 4);
   mld_xof128_x4_init(&state);
   mld_xof128_x4_absorb(&state, seed, MLDSA_SEEDBYTES + 2);
 
@@ -428,6 +432,8 @@ void mld_poly_uniform_4x(mld_poly *vec0, mld_poly *vec1, mld_poly *vec2,
     invariant(array_bound(vec3->coeffs, 0, ctr[3], 0, MLDSA_Q)))
   {
     mld_xof128_x4_squeezeblocks(buf, 1, &state);
+    MLD_STATS_XOF_BLOCKS(4);
+    MLD_OPCOUNT(MLD_OPCOUNT_XOF_REFILL, 1);
     ctr[0] = mld_rej_uniform(vec0->coeffs, MLDSA_N, ctr[0], buf[0], buflen);
     ctr[1] = mld_rej_uniform(vec1->coeffs, MLDSA_N, ctr[1], buf[1], buflen);
     ctr[2] = mld_rej_uniform(vec2->coeffs, MLDSA_N, ctr[2], buf[2], buflen);
@@ -576,35 +582,19 @@ __contract__(
   return ctr;
 }
 
-void mld_poly_uniform_eta_4x(mld_poly *r0, mld_poly *r1, mld_poly *r2,
-                             mld_poly *r3, const uint8_t seed[MLDSA_CRHBYTES],
-                             uint8_t nonce0, uint8_t nonce1, uint8_t nonce2,
-                             uint8_t nonce3)
+void mld_poly_uniform_eta_4x_seeds(
+    mld_poly *r0, mld_poly *r1, mld_poly *r2, mld_poly *r3,
+    uint8_t extseed[4][MLD_ALIGN_UP(MLDSA_CRHBYTES + 2)])
 {
   /* Temporary buffers for XOF output before rejection sampling */
   MLD_ALIGN uint8_t
       buf[4][MLD_ALIGN_UP(POLY_UNIFORM_ETA_NBLOCKS * STREAM256_BLOCKBYTES)];
 
-  MLD_ALIGN uint8_t extseed[4][MLD_ALIGN_UP(MLDSA_CRHBYTES + 2)];
-
   /* Tracks the number of coefficients we have already sampled */
   unsigned ctr[4];
   mld_xof256_x4_ctx state;
   unsigned buflen;
 
-  memcpy(extseed[0], seed, MLDSA_CRHBYTES);
-  memcpy(extseed[1], seed, MLDSA_CRHBYTES);
-  memcpy(extseed[2], seed, MLDSA_CRHBYTES);
-  memcpy(extseed[3], seed, MLDSA_CRHBYTES);
-  extseed[0][MLDSA_CRHBYTES] = nonce0;
-  extseed[1][MLDSA_CRHBYTES] = nonce1;
-  extseed[2][MLDSA_CRHBYTES] = nonce2;
-  extseed[3][MLDSA_CRHBYTES] = nonce3;
-  extseed[0][MLDSA_CRHBYTES + 1] = 0;
-  extseed[1][MLDSA_CRHBYTES + 1] = 0;
-  extseed[2][MLDSA_CRHBYTES + 1] = 0;
-  extseed[3][MLDSA_CRHBYTES + 1] = 0;
-
   mld_xof256_x4_init(&state);
   mld_xof256_x4_absorb(&state, extseed, MLDSA_CRHBYTES + 2);
 
@@ -641,6 +631,8 @@ void mld_poly_uniform_eta_4x(mld_poly *r0, mld_poly *r1, mld_poly *r2,
     invariant(array_abs_bound(r3->coeffs, 0, ctr[3], MLDSA_ETA + 1)))
   {
     mld_xof256_x4_squeezeblocks(buf, 1, &state);
+    MLD_STATS_XOF_BLOCKS(4);
+    MLD_OPCOUNT(MLD_OPCOUNT_XOF_REFILL, 1);
     ctr[0] = mld_rej_eta(r0->coeffs, MLDSA_N, ctr[0], buf[0], buflen);
     ctr[1] = mld_rej_eta(r1->coeffs, MLDSA_N, ctr[1], buf[1], buflen);
     ctr[2] = mld_rej_eta(r2->coeffs, MLDSA_N, ctr[2], buf[2], buflen);
@@ -651,6 +643,31 @@ void mld_poly_uniform_eta_4x(mld_poly *r0, mld_poly *r1, mld_poly *r2,
 
   /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
   mld_zeroize(buf, sizeof(buf));
+}
+
+void mld_poly_uniform_eta_4x(mld_poly *r0, mld_poly *r1, mld_poly *r2,
+                             mld_poly *r3, const uint8_t seed[MLDSA_CRHBYTES],
+                             uint8_t nonce0, uint8_t nonce1, uint8_t nonce2,
+                             uint8_t nonce3)
+{
+  MLD_ALIGN uint8_t extseed[4][MLD_ALIGN_UP(MLDSA_CRHBYTES + 2)];
+
+  memcpy(extseed[0], seed, MLDSA_CRHBYTES);
+  memcpy(extseed[1], seed, MLDSA_CRHBYTES);
+  memcpy(extseed[2], seed, MLDSA_CRHBYTES);
+  memcpy(extseed[3], seed, MLDSA_CRHBYTES);
+  extseed[0][MLDSA_CRHBYTES] = nonce0;
+  extseed[1][MLDSA_CRHBYTES] = nonce1;
+  extseed[2][MLDSA_CRHBYTES] = nonce2;
+  extseed[3][MLDSA_CRHBYTES] = nonce3;
+  extseed[0][MLDSA_CRHBYTES + 1] = 0;
+  extseed[1][MLDSA_CRHBYTES + 1] = 0;
+  extseed[2][MLDSA_CRHBYTES + 1] = 0;
+  extseed[3][MLDSA_CRHBYTES + 1] = 0;
+
+  mld_poly_uniform_eta_4x_seeds(r0, r1, r2, r3, extseed);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
   mld_zeroize(extseed, sizeof(extseed));
 }
 
@@ -773,6 +790,8 @@ void mld_poly_challenge(mld_poly *c, const uint8_t seed[MLDSA_CTILDEBYTES])
       if (pos >= SHAKE256_RATE)
       {
         shake256_squeezeblocks(buf, 1, &state);
+        MLD_STATS_XOF_BLOCKS(1);
+        MLD_OPCOUNT(MLD_OPCOUNT_XOF_REFILL, 1);
         pos = 0;
       }
       j = buf[pos++];
@@ -1035,6 +1054,202 @@ void mld_polyt0_unpack(mld_poly *r, const uint8_t *a)
                    (1 << (MLDSA_D - 1)) + 1);
 }
 
+void mld_polya_pack(uint8_t *r, const mld_poly *a)
+{
+  unsigned int i;
+  uint32_t t[8];
+
+  mld_assert_bound(a->coeffs, MLDSA_N, 0, MLDSA_Q);
+
+  for (i = 0; i < MLDSA_N / 8; ++i)
+  __loop__(
+    invariant(i <= MLDSA_N/8))
+  {
+    t[0] = a->coeffs[8 * i + 0];
+    t[1] = a->coeffs[8 * i + 1];
+    t[2] = a->coeffs[8 * i + 2];
+    t[3] = a->coeffs[8 * i + 3];
+    t[4] = a->coeffs[8 * i + 4];
+    t[5] = a->coeffs[8 * i + 5];
+    t[6] = a->coeffs[8 * i + 6];
+    t[7] = a->coeffs[8 * i + 7];
+
+    r[23 * i + 0] = (t[0] >> 0) & 0xFF;
+    r[23 * i + 1] = (t[0] >> 8) & 0xFF;
+    r[23 * i + 2] = ((t[0] >> 16) | (t[1] << 7)) & 0xFF;
+    r[23 * i + 3] = (t[1] >> 1) & 0xFF;
+    r[23 * i + 4] = (t[1] >> 9) & 0xFF;
+    r[23 * i + 5] = ((t[1] >> 17) | (t[2] << 6)) & 0xFF;
+    r[23 * i + 6] = (t[2] >> 2) & 0xFF;
+    r[23 * i + 7] = (t[2] >> 10) & 0xFF;
+    r[23 * i + 8] = ((t[2] >> 18) | (t[3] << 5)) & 0xFF;
+    r[23 * i + 9] = (t[3] >> 3) & 0xFF;
+    r[23 * i + 10] = (t[3] >> 11) & 0xFF;
+    r[23 * i + 11] = ((t[3] >> 19) | (t[4] << 4)) & 0xFF;
+    r[23 * i + 12] = (t[4] >> 4) & 0xFF;
+    r[23 * i + 13] = (t[4] >> 12) & 0xFF;
+    r[23 * i + 14] = ((t[4] >> 20) | (t[5] << 3)) & 0xFF;
+    r[23 * i + 15] = (t[5] >> 5) & 0xFF;
+    r[23 * i + 16] = (t[5] >> 13) & 0xFF;
+    r[23 * i + 17] = ((t[5] >> 21) | (t[6] << 2)) & 0xFF;
+    r[23 * i + 18] = (t[6] >> 6) & 0xFF;
+    r[23 * i + 19] = (t[6] >> 14) & 0xFF;
+    r[23 * i + 20] = ((t[6] >> 22) | (t[7] << 1)) & 0xFF;
+    r[23 * i + 21] = (t[7] >> 7) & 0xFF;
+    r[23 * i + 22] = (t[7] >> 15) & 0xFF;
+  }
+}
+
+/*************************************************
+ * Name:        mld_polya_unpack_8x
+ *
+ * Description: Unpack 8 consecutive 23-bit coefficients of a polynomial
+ *              packed by mld_polya_pack().
+ *
+ *              A well-formed encoding only contains values in [0, Q-1],
+ *              but 23 bits can represent values up to 2^23 - 1 = Q + 8190.
+ *              To keep the output bound unconditional, values >= Q are
+ *              conditionally reduced by Q.
+ *
+ * Arguments:   - int32_t r[8]: output coefficients
+ *              - const uint8_t a[23]: input bytes
+ **************************************************/
+static MLD_INLINE void mld_polya_unpack_8x(int32_t r[8], const uint8_t a[23])
+__contract__(
+  requires(memory_no_alias(r, 8 * sizeof(int32_t)))
+  requires(memory_no_alias(a, 23))
+  assigns(memory_slice(r, 8 * sizeof(int32_t)))
+  ensures(array_bound(r, 0, 8, 0, MLDSA_Q))
+)
+{
+  unsigned int j;
+  uint32_t t[8];
+
+  t[0] = a[0];
+  t[0] |= (uint32_t)a[1] << 8;
+  t[0] |= (uint32_t)a[2] << 16;
+
+  t[1] = a[2] >> 7;
+  t[1] |= (uint32_t)a[3] << 1;
+  t[1] |= (uint32_t)a[4] << 9;
+  t[1] |= (uint32_t)a[5] << 17;
+
+  t[2] = a[5] >> 6;
+  t[2] |= (uint32_t)a[6] << 2;
+  t[2] |= (uint32_t)a[7] << 10;
+  t[2] |= (uint32_t)a[8] << 18;
+
+  t[3] = a[8] >> 5;
+  t[3] |= (uint32_t)a[9] << 3;
+  t[3] |= (uint32_t)a[10] << 11;
+  t[3] |= (uint32_t)a[11] << 19;
+
+  t[4] = a[11] >> 4;
+  t[4] |= (uint32_t)a[12] << 4;
+  t[4] |= (uint32_t)a[13] << 12;
+  t[4] |= (uint32_t)a[14] << 20;
+
+  t[5] = a[14] >> 3;
+  t[5] |= (uint32_t)a[15] << 5;
+  t[5] |= (uint32_t)a[16] << 13;
+  t[5] |= (uint32_t)a[17] << 21;
+
+  t[6] = a[17] >> 2;
+  t[6] |= (uint32_t)a[18] << 6;
+  t[6] |= (uint32_t)a[19] << 14;
+  t[6] |= (uint32_t)a[20] << 22;
+
+  t[7] = a[20] >> 1;
+  t[7] |= (uint32_t)a[21] << 7;
+  t[7] |= (uint32_t)a[22] << 15;
+
+  for (j = 0; j < 8; j++)
+  __loop__(
+    invariant(j <= 8)
+    invariant(array_bound(r, 0, j, 0, MLDSA_Q)))
+  {
+    /* t[j] < 2^23 < 2*Q, hence a single conditional subtraction suffices */
+    const int32_t s = (int32_t)(t[j] & 0x7FFFFF) - MLDSA_Q;
+    r[j] = s + (int32_t)(mld_ct_cmask_neg_i32(s) & MLDSA_Q);
+  }
+}
+
+void mld_polya_unpack(mld_poly *r, const uint8_t *a)
+{
+  unsigned int i;
+
+  for (i = 0; i < MLDSA_N / 8; ++i)
+  __loop__(
+    invariant(i <= MLDSA_N/8)
+    invariant(array_bound(r->coeffs, 0, i*8, 0, MLDSA_Q)))
+  {
+    mld_polya_unpack_8x(&r->coeffs[8 * i], &a[23 * i]);
+  }
+
+  mld_assert_bound(r->coeffs, MLDSA_N, 0, MLDSA_Q);
+}
+
+void mld_polya_pointwise_acc_montgomery(mld_poly *w, const uint8_t *a,
+                                        const mld_poly v[MLDSA_L])
+{
+  unsigned int i, j, k;
+  int32_t t[8];
+  int64_t acc[8];
+
+  /* Same bounds reasoning as in mld_polyvecl_pointwise_acc_montgomery():
+   * unpacked coefficients of a are in [0, Q-1] and coefficients of v are
+   * bounded by MLD_NTT_BOUND in absolute value, so the accumulation over
+   * MLDSA_L products fits the strong domain of mld_montgomery_reduce(). */
+  for (i = 0; i < MLDSA_N / 8; i++)
+  __loop__(
+    assigns(i, j, k, memory_slice(t, sizeof(t)), memory_slice(acc, sizeof(acc)),
+            object_whole(w))
+    invariant(i <= MLDSA_N / 8)
+    invariant(array_abs_bound(w->coeffs, 0, 8 * i, MLDSA_Q))
+  )
+  {
+    for (k = 0; k < 8; k++)
+    __loop__(
+      assigns(k, memory_slice(acc, sizeof(acc)))
+      invariant(k <= 8)
+      invariant(forall(k0, 0, k, acc[k0] == 0))
+    )
+    {
+      acc[k] = 0;
+    }
+
+    for (j = 0; j < MLDSA_L; j++)
+    __loop__(
+      assigns(j, k, memory_slice(t, sizeof(t)), memory_slice(acc, sizeof(acc)))
+      invariant(j <= MLDSA_L)
+      invariant(forall(k1, 0, 8,
+        acc[k1] >= -(int64_t)j*(MLDSA_Q - 1)*(MLD_NTT_BOUND - 1) &&
+        acc[k1] <= (int64_t)j*(MLDSA_Q - 1)*(MLD_NTT_BOUND - 1)))
+    )
+    {
+      mld_polya_unpack_8x(t, &a[j * MLDSA_POLYA_PACKEDBYTES + 23 * i]);
+      for (k = 0; k < 8; k++)
+      __loop__(
+        assigns(k, memory_slice(acc, sizeof(acc)))
+        invariant(k <= 8)
+      )
+      {
+        acc[k] += (int64_t)t[k] * v[j].coeffs[8 * i + k];
+      }
+    }
+
+    for (k = 0; k < 8; k++)
+    __loop__(
+      assigns(k, memory_slice(w, sizeof(mld_poly)))
+      invariant(k <= 8)
+      invariant(array_abs_bound(w->coeffs, 0, 8 * i + k, MLDSA_Q))
+    )
+    {
+      w->coeffs[8 * i + k] = mld_montgomery_reduce(acc[k]);
+    }
+  }
+}
+
 void mld_polyz_pack(uint8_t *r, const mld_poly *a)
 {
   unsigned int i;
@@ -1170,3 +1385,80 @@ void mld_polyw1_pack(uint8_t r[MLDSA_POLYW1_PACKEDBYTES], const mld_poly *a)
   }
 #endif /* MLDSA_MODE != 2 */
 }
+
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+void mld_poly_small_from_poly(mld_poly_small *r, const mld_poly *a)
+{
+  unsigned int i;
+
+  for (i = 0; i < MLDSA_N; ++i)
+  __loop__(
+    invariant(i <= MLDSA_N)
+    invariant(array_bound(r->coeffs, 0, i, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
+  {
+    r->coeffs[i] = (int16_t)a->coeffs[i];
+  }
+}
+
+void mld_poly_challenge_mul_small(mld_poly *r, const mld_poly *c,
+                                  const mld_poly_small *s)
+{
+  unsigned int i, j;
+  /* Accumulate at half width: see MLD_POLY_SMALL_MUL_BOUND */
+  MLD_ALIGN int16_t t[MLDSA_N];
+
+  memset(t, 0, sizeof(t));
+
+  for (i = 0; i < MLDSA_N; ++i)
+  __loop__(
+    assigns(i, j, memory_slice(t, sizeof(t)))
+    invariant(i <= MLDSA_N)
+    invariant(array_abs_bound(t, 0, MLDSA_N, i * -MLD_POLYETA_UNPACK_LOWER_BOUND + 1))
+  )
+  {
+    /* Multiply by c_i * X^i, using X^N = -1 for the wrapped-around part.
+     * As c_i is in {-1, 0, 1}, this amounts to adding or subtracting a
+     * rotated copy of s. */
+    const int16_t sign = (int16_t)c->coeffs[i];
+    if (sign == 0)
+    {
+      continue;
+    }
+
+    for (j = 0; j < MLDSA_N - i; ++j)
+    __loop__(
+      assigns(j, memory_slice(t, sizeof(t)))
+      invariant(j <= MLDSA_N - i)
+      invariant(array_abs_bound(t, 0, i, i * -MLD_POLYETA_UNPACK_LOWER_BOUND + 1))
+      invariant(array_abs_bound(t, i, i + j, (i + 1) * -MLD_POLYETA_UNPACK_LOWER_BOUND + 1))
+      invariant(array_abs_bound(t, i + j, MLDSA_N, i * -MLD_POLYETA_UNPACK_LOWER_BOUND + 1))
+    )
+    {
+      t[i + j] = (int16_t)(t[i + j] + sign * s->coeffs[j]);
+    }
+
+    for (j = MLDSA_N - i; j < MLDSA_N; ++j)
+    __loop__(
+      assigns(j, memory_slice(t, sizeof(t)))
+      invariant(MLDSA_N - i <= j && j <= MLDSA_N)
+      invariant(array_abs_bound(t, 0, j + i - MLDSA_N, (i + 1) * -MLD_POLYETA_UNPACK_LOWER_BOUND + 1))
+      invariant(array_abs_bound(t, j + i - MLDSA_N, i, i * -MLD_POLYETA_UNPACK_LOWER_BOUND + 1))
+      invariant(array_abs_bound(t, i, MLDSA_N, (i + 1) * -MLD_POLYETA_UNPACK_LOWER_BOUND + 1))
+    )
+    {
+      t[i + j - MLDSA_N] = (int16_t)(t[i + j - MLDSA_N] - sign * s->coeffs[j]);
+    }
+  }
+
+  for (i = 0; i < MLDSA_N; ++i)
+  __loop__(
+    invariant(i <= MLDSA_N)
+    invariant(array_abs_bound(r->coeffs, 0, i, MLD_POLY_SMALL_MUL_BOUND)))
+  {
+    r->coeffs[i] = t[i];
+  }
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(t, sizeof(t));
+}
+#endif /* MLD_CONFIG_SMALL_SECRETS */
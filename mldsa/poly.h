@@ -400,6 +400,41 @@ __contract__(
   ensures(array_abs_bound(r3->coeffs, 0, MLDSA_N, MLDSA_ETA + 1))
 );
 
+#define mld_poly_uniform_eta_4x_seeds MLD_NAMESPACE(poly_uniform_eta_4x_seeds)
+/*************************************************
+ * Name:        mld_poly_uniform_eta_4x_seeds
+ *
+ * Description: Sample four polynomials with uniformly random coefficients
+ *              in [-MLDSA_ETA,MLDSA_ETA] by performing rejection sampling on
+ *              the output stream from SHAKE256(extseed[i]). Unlike
+ *              mld_poly_uniform_eta_4x, each lane has its own seed.
+ *
+ * Arguments:   - mld_poly *r0, *r1, *r2, *r3:
+ *                Pointers to 4 polynomials to be sampled.
+ *              - uint8_t extseed[4][MLD_ALIGN_UP(MLDSA_CRHBYTES + 2)]:
+ *                Consecutive array of seed buffers, each holding a seed of
+ *                MLDSA_CRHBYTES bytes followed by a 16-bit little-endian
+ *                nonce, plus padding for alignment.
+ **************************************************/
+void mld_poly_uniform_eta_4x_seeds(
+    mld_poly *r0, mld_poly *r1, mld_poly *r2, mld_poly *r3,
+    uint8_t extseed[4][MLD_ALIGN_UP(MLDSA_CRHBYTES + 2)])
+__contract__(
+  requires(memory_no_alias(r0, sizeof(mld_poly)))
+  requires(memory_no_alias(r1, sizeof(mld_poly)))
+  requires(memory_no_alias(r2, sizeof(mld_poly)))
+  requires(memory_no_alias(r3, sizeof(mld_poly)))
+  requires(memory_no_alias(extseed, 4 * MLD_ALIGN_UP(MLDSA_CRHBYTES + 2)))
+  assigns(memory_slice(r0, sizeof(mld_poly)))
+  assigns(memory_slice(r1, sizeof(mld_poly)))
+  assigns(memory_slice(r2, sizeof(mld_poly)))
+  assigns(memory_slice(r3, sizeof(mld_poly)))
+  ensures(array_abs_bound(r0->coeffs, 0, MLDSA_N, MLDSA_ETA + 1))
+  ensures(array_abs_bound(r1->coeffs, 0, MLDSA_N, MLDSA_ETA + 1))
+  ensures(array_abs_bound(r2->coeffs, 0, MLDSA_N, MLDSA_ETA + 1))
+  ensures(array_abs_bound(r3->coeffs, 0, MLDSA_N, MLDSA_ETA + 1))
+);
+
 #define mld_poly_uniform_gamma1 MLD_NAMESPACE(poly_uniform_gamma1)
 /*************************************************
  * Name:        mld_poly_uniform_gamma1
@@ -605,6 +640,81 @@ __contract__(
   ensures(array_bound(r->coeffs, 0, MLDSA_N, -(1<<(MLDSA_D-1)) + 1, (1<<(MLDSA_D-1)) + 1))
 );
 
+#define mld_polya_pack MLD_NAMESPACE(polya_pack)
+/*************************************************
+ * Name:        mld_polya_pack
+ *
+ * Description: Bit-pack a polynomial of the expanded matrix A with
+ *              coefficients in [0, Q-1] into 23 bits per coefficient.
+ *              This is a compact in-memory representation for cached
+ *              matrices and is not part of any FIPS 204 encoding.
+ *
+ * Arguments:   - uint8_t *r: pointer to output byte array with at least
+ *                            MLDSA_POLYA_PACKEDBYTES bytes
+ *              - const mld_poly *a: pointer to input polynomial
+ **************************************************/
+void mld_polya_pack(uint8_t *r, const mld_poly *a)
+__contract__(
+  requires(memory_no_alias(r, MLDSA_POLYA_PACKEDBYTES))
+  requires(memory_no_alias(a, sizeof(mld_poly)))
+  requires(array_bound(a->coeffs, 0, MLDSA_N, 0, MLDSA_Q))
+  assigns(object_whole(r))
+);
+
+#define mld_polya_unpack MLD_NAMESPACE(polya_unpack)
+/*************************************************
+ * Name:        mld_polya_unpack
+ *
+ * Description: Unpack polynomial of the expanded matrix A with 23-bit
+ *              coefficients. Output coefficients are standard
+ *              representatives, even for malformed input.
+ *
+ * Arguments:   - mld_poly *r: pointer to output polynomial
+ *              - const uint8_t *a: byte array with bit-packed polynomial
+ **************************************************/
+void mld_polya_unpack(mld_poly *r, const uint8_t *a)
+__contract__(
+  requires(memory_no_alias(r, sizeof(mld_poly)))
+  requires(memory_no_alias(a, MLDSA_POLYA_PACKEDBYTES))
+  assigns(memory_slice(r, sizeof(mld_poly)))
+  ensures(array_bound(r->coeffs, 0, MLDSA_N, 0, MLDSA_Q))
+);
+
+#define mld_polya_pointwise_acc_montgomery \
+  MLD_NAMESPACE(polya_pointwise_acc_montgomery)
+/*************************************************
+ * Name:        mld_polya_pointwise_acc_montgomery
+ *
+ * Description: Pointwise multiply a row of MLDSA_L bit-packed polynomials
+ *              (as produced by mld_polya_pack()) with MLDSA_L polynomials
+ *              in NTT domain, multiply the resulting vector by 2^{-32}
+ *              and add (accumulate) polynomials in it.
+ *
+ *              Unpacking is fused with the multiply-accumulate: the packed
+ *              row is decoded 8 coefficients at a time and never expanded
+ *              into a full mld_poly.
+ *
+ *              The second input "v" is assumed to be output of an NTT, and
+ *              hence must have coefficients bounded by [-9q+1, +9q-1]
+ *              inclusive.
+ *
+ * Arguments:   - mld_poly *w: output polynomial
+ *              - const uint8_t *a: byte array of MLDSA_L bit-packed
+ *                polynomials
+ *              - const mld_poly v[MLDSA_L]: input polynomials
+ **************************************************/
+void mld_polya_pointwise_acc_montgomery(mld_poly *w, const uint8_t *a,
+                                        const mld_poly v[MLDSA_L])
+__contract__(
+  requires(memory_no_alias(w, sizeof(mld_poly)))
+  requires(memory_no_alias(a, MLDSA_L * MLDSA_POLYA_PACKEDBYTES))
+  requires(memory_no_alias(v, MLDSA_L * sizeof(mld_poly)))
+  requires(forall(l0, 0, MLDSA_L,
+                  array_abs_bound(v[l0].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
+  assigns(memory_slice(w, sizeof(mld_poly)))
+  ensures(array_abs_bound(w->coeffs, 0, MLDSA_N, MLDSA_Q))
+);
+
 #define mld_polyz_pack MLD_NAMESPACE(polyz_pack)
 /*************************************************
  * Name:        mld_polyz_pack
@@ -662,4 +772,70 @@ __contract__(
   assigns(object_whole(r))
 );
 
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+/* Polynomial with small coefficients, such as the secret vectors s1 and s2,
+ * stored at half width. */
+typedef struct
+{
+  int16_t coeffs[MLDSA_N];
+} MLD_ALIGN mld_poly_small;
+
+/* Absolute bound for the coefficients of products computed by
+ * mld_poly_challenge_mul_small(). For a valid challenge with MLDSA_TAU
+ * non-zero coefficients, the product is bounded by MLDSA_BETA; this bound
+ * holds for any challenge with coefficients in [-1, 1] and fits in int16_t. */
+#define MLD_POLY_SMALL_MUL_BOUND (MLDSA_N * -MLD_POLYETA_UNPACK_LOWER_BOUND + 1)
+
+#define mld_poly_small_from_poly MLD_NAMESPACE(poly_small_from_poly)
+/*************************************************
+ * Name:        mld_poly_small_from_poly
+ *
+ * Description: Narrow a polynomial with coefficients as produced by
+ *              mld_polyeta_unpack() to half-width storage.
+ *
+ * Arguments:   - mld_poly_small *r: pointer to output polynomial
+ *              - const mld_poly *a: pointer to input polynomial
+ **************************************************/
+void mld_poly_small_from_poly(mld_poly_small *r, const mld_poly *a)
+__contract__(
+  requires(memory_no_alias(r, sizeof(mld_poly_small)))
+  requires(memory_no_alias(a, sizeof(mld_poly)))
+  requires(array_bound(a->coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1))
+  assigns(memory_slice(r, sizeof(mld_poly_small)))
+  ensures(array_bound(r->coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1))
+);
+
+#define mld_poly_challenge_mul_small MLD_NAMESPACE(poly_challenge_mul_small)
+/*************************************************
+ * Name:        mld_poly_challenge_mul_small
+ *
+ * Description: Compute the product c*s in Z[X]/(X^N + 1) of a challenge
+ *              polynomial c (as output by mld_poly_challenge(), in normal
+ *              domain) and a polynomial s with small coefficients.
+ *
+ *              The product is computed directly as a sparse, negacyclic
+ *              sum of shifted copies of s, without NTT. The result is exact
+ *              (not reduced mod q).
+ *
+ *              The run-time depends on the positions of the non-zero
+ *              coefficients of c. This is fine since the challenge is
+ *              public, see mld_attempt_signature_generation().
+ *
+ * Arguments:   - mld_poly *r: pointer to output polynomial
+ *              - const mld_poly *c: pointer to challenge polynomial
+ *              - const mld_poly_small *s: pointer to small polynomial
+ **************************************************/
+void mld_poly_challenge_mul_small(mld_poly *r, const mld_poly *c,
+                                  const mld_poly_small *s)
+__contract__(
+  requires(memory_no_alias(r, sizeof(mld_poly)))
+  requires(memory_no_alias(c, sizeof(mld_poly)))
+  requires(memory_no_alias(s, sizeof(mld_poly_small)))
+  requires(array_bound(c->coeffs, 0, MLDSA_N, -1, 2))
+  requires(array_bound(s->coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1))
+  assigns(memory_slice(r, sizeof(mld_poly)))
+  ensures(array_abs_bound(r->coeffs, 0, MLDSA_N, MLD_POLY_SMALL_MUL_BOUND))
+);
+#endif /* MLD_CONFIG_SMALL_SECRETS */
+
 #endif /* !MLD_POLY_H */
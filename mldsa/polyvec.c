@@ -133,6 +133,148 @@ void mld_polyvec_matrix_pointwise_montgomery(mld_polyveck *t,
   }
 }
 
+void mld_polyvec_matrix_pack(uint8_t r[MLDSA_POLYMAT_PACKEDBYTES],
+                             const mld_polyvecl mat[MLDSA_K])
+{
+  unsigned int i, j;
+
+  for (i = 0; i < MLDSA_K; ++i)
+  __loop__(
+    assigns(i, j, object_whole(r))
+    invariant(i <= MLDSA_K)
+  )
+  {
+    for (j = 0; j < MLDSA_L; ++j)
+    __loop__(
+      assigns(j, object_whole(r))
+      invariant(i < MLDSA_K)
+      invariant(j <= MLDSA_L)
+    )
+    {
+      mld_polya_pack(&r[(i * MLDSA_L + j) * MLDSA_POLYA_PACKEDBYTES],
+                     &mat[i].vec[j]);
+    }
+  }
+}
+
+void mld_polyvec_matrix_pointwise_montgomery_packed(
+    mld_polyveck *t, const uint8_t mat[MLDSA_POLYMAT_PACKEDBYTES],
+    const mld_polyvecl *v)
+{
+  unsigned int i;
+
+  for (i = 0; i < MLDSA_K; ++i)
+  __loop__(
+    assigns(i, memory_slice(t, sizeof(mld_polyveck)))
+    invariant(i <= MLDSA_K)
+    invariant(forall(k0, 0, i,
+                     array_abs_bound(t->vec[k0].coeffs, 0, MLDSA_N, MLDSA_Q)))
+  )
+  {
+    mld_polya_pointwise_acc_montgomery(
+        &t->vec[i], &mat[i * MLDSA_L * MLDSA_POLYA_PACKEDBYTES], v->vec);
+  }
+}
+
+#if defined(MLD_CONFIG_REDUCE_RAM)
+void mld_polyvec_matrix_expand_row(mld_polyvecl *row,
+                                   const uint8_t rho[MLDSA_SEEDBYTES],
+                                   unsigned int i)
+{
+  unsigned int j;
+  MLD_ALIGN uint8_t seed_ext[4][MLD_ALIGN_UP(MLDSA_SEEDBYTES + 2)];
+
+  for (j = 0; j < 4; j++)
+  __loop__(
+    assigns(j, object_whole(seed_ext))
+    invariant(j <= 4)
+  )
+  {
+    memcpy(seed_ext[j], rho, MLDSA_SEEDBYTES);
+    seed_ext[j][MLDSA_SEEDBYTES + 0] = (uint8_t)j;
+    seed_ext[j][MLDSA_SEEDBYTES + 1] = (uint8_t)i;
+  }
+
+  /* MLDSA_L >= 4 for all parameter sets: sample the first 4 entries at
+   * once, and the remaining MLDSA_L - 4 individually. */
+  mld_poly_uniform_4x(&row->vec[0], &row->vec[1], &row->vec[2], &row->vec[3],
+                      seed_ext);
+
+  for (j = 4; j < MLDSA_L; j++)
+  __loop__(
+    assigns(j, object_whole(seed_ext), memory_slice(row, sizeof(mld_polyvecl)))
+    invariant(4 <= j && j <= MLDSA_L)
+    invariant(forall(l1, 0, j,
+      array_bound(row->vec[l1].coeffs, 0, MLDSA_N, 0, MLDSA_Q)))
+  )
+  {
+    seed_ext[0][MLDSA_SEEDBYTES + 0] = (uint8_t)j;
+    mld_poly_uniform(&row->vec[j], seed_ext[0]);
+  }
+
+  /* See mld_polyvec_matrix_expand() */
+  for (j = 0; j < MLDSA_L; j++)
+  {
+    mld_poly_permute_bitrev_to_custom(row->vec[j].coeffs);
+  }
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(seed_ext, sizeof(seed_ext));
+}
+
+void mld_polyvec_matrix_expand_packed(uint8_t r[MLDSA_POLYMAT_PACKEDBYTES],
+                                      const uint8_t rho[MLDSA_SEEDBYTES])
+{
+  unsigned int i, j;
+  mld_polyvecl row;
+
+  for (i = 0; i < MLDSA_K; ++i)
+  __loop__(
+    assigns(i, j, object_whole(r), object_whole(&row))
+    invariant(i <= MLDSA_K)
+  )
+  {
+    mld_polyvec_matrix_expand_row(&row, rho, i);
+    for (j = 0; j < MLDSA_L; ++j)
+    __loop__(
+      assigns(j, object_whole(r))
+      invariant(i < MLDSA_K)
+      invariant(j <= MLDSA_L)
+    )
+    {
+      mld_polya_pack(&r[(i * MLDSA_L + j) * MLDSA_POLYA_PACKEDBYTES],
+                     &row.vec[j]);
+    }
+  }
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&row, sizeof(row));
+}
+
+void mld_polyvec_matrix_pointwise_montgomery_stream(
+    mld_polyveck *t, const uint8_t rho[MLDSA_SEEDBYTES],
+    const mld_polyvecl *v)
+{
+  unsigned int i;
+  mld_polyvecl row;
+
+  for (i = 0; i < MLDSA_K; ++i)
+  __loop__(
+    assigns(i, object_whole(&row), memory_slice(t, sizeof(mld_polyveck)))
+    invariant(i <= MLDSA_K)
+    invariant(forall(k0, 0, i,
+                     array_abs_bound(t->vec[k0].coeffs, 0, MLDSA_N, MLDSA_Q)))
+  )
+  {
+    mld_polyvec_matrix_expand_row(&row, rho, i);
+    mld_polyvecl_pointwise_acc_montgomery(&t->vec[i], &row, v);
+  }
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&row, sizeof(row));
+}
+#endif /* MLD_CONFIG_REDUCE_RAM */
+
 /**************************************************************/
 /************ Vectors of polynomials of length MLDSA_L **************/
 /**************************************************************/
@@ -656,3 +798,83 @@ void mld_polyveck_unpack_t0(mld_polyveck *p,
     mld_polyt0_unpack(&p->vec[i], r + i * MLDSA_POLYT0_PACKEDBYTES);
   }
 }
+
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+void mld_polyvecl_unpack_eta_small(
+    mld_polyvecl_small *p, const uint8_t r[MLDSA_L * MLDSA_POLYETA_PACKEDBYTES])
+{
+  unsigned int i;
+  mld_poly t;
+
+  for (i = 0; i < MLDSA_L; ++i)
+  __loop__(
+    assigns(i, t, object_whole(p))
+    invariant(i <= MLDSA_L)
+    invariant(forall(k1, 0, i,
+      array_bound(p->vec[k1].coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
+  )
+  {
+    mld_polyeta_unpack(&t, r + i * MLDSA_POLYETA_PACKEDBYTES);
+    mld_poly_small_from_poly(&p->vec[i], &t);
+  }
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&t, sizeof(t));
+}
+
+void mld_polyveck_unpack_eta_small(
+    mld_polyveck_small *p, const uint8_t r[MLDSA_K * MLDSA_POLYETA_PACKEDBYTES])
+{
+  unsigned int i;
+  mld_poly t;
+
+  for (i = 0; i < MLDSA_K; ++i)
+  __loop__(
+    assigns(i, t, object_whole(p))
+    invariant(i <= MLDSA_K)
+    invariant(forall(k1, 0, i,
+      array_bound(p->vec[k1].coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
+  )
+  {
+    mld_polyeta_unpack(&t, r + i * MLDSA_POLYETA_PACKEDBYTES);
+    mld_poly_small_from_poly(&p->vec[i], &t);
+  }
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&t, sizeof(t));
+}
+
+void mld_polyvecl_challenge_mul_small(mld_polyvecl *r, const mld_poly *c,
+                                      const mld_polyvecl_small *s)
+{
+  unsigned int i;
+
+  for (i = 0; i < MLDSA_L; ++i)
+  __loop__(
+    assigns(i, memory_slice(r, sizeof(mld_polyvecl)))
+    invariant(i <= MLDSA_L)
+    invariant(forall(k1, 0, i,
+      array_abs_bound(r->vec[k1].coeffs, 0, MLDSA_N, MLD_POLY_SMALL_MUL_BOUND)))
+  )
+  {
+    mld_poly_challenge_mul_small(&r->vec[i], c, &s->vec[i]);
+  }
+}
+
+void mld_polyveck_challenge_mul_small(mld_polyveck *r, const mld_poly *c,
+                                      const mld_polyveck_small *s)
+{
+  unsigned int i;
+
+  for (i = 0; i < MLDSA_K; ++i)
+  __loop__(
+    assigns(i, memory_slice(r, sizeof(mld_polyveck)))
+    invariant(i <= MLDSA_K)
+    invariant(forall(k1, 0, i,
+      array_abs_bound(r->vec[k1].coeffs, 0, MLDSA_N, MLD_POLY_SMALL_MUL_BOUND)))
+  )
+  {
+    mld_poly_challenge_mul_small(&r->vec[i], c, &s->vec[i]);
+  }
+}
+#endif /* MLD_CONFIG_SMALL_SECRETS */
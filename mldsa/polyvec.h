@@ -756,4 +756,237 @@ __contract__(
                  array_abs_bound(t->vec[k0].coeffs, 0, MLDSA_N, MLDSA_Q)))
 );
 
+#define mld_polyvec_matrix_pack MLD_NAMESPACE(polyvec_matrix_pack)
+/*************************************************
+ * Name:        mld_polyvec_matrix_pack
+ *
+ * Description: Pack an expanded matrix A into the compact 23-bit
+ *              representation of mld_polya_pack(), with polynomials
+ *              stored row by row.
+ *
+ *              This is a lossless in-memory format for caching expanded
+ *              matrices: MLDSA_POLYA_PACKEDBYTES instead of sizeof(mld_poly)
+ *              bytes per entry.
+ *
+ * Arguments:   - uint8_t r[MLDSA_POLYMAT_PACKEDBYTES]: output byte array
+ *              - const mld_polyvecl mat[MLDSA_K]: input matrix, as
+ *                produced by mld_polyvec_matrix_expand()
+ **************************************************/
+void mld_polyvec_matrix_pack(uint8_t r[MLDSA_POLYMAT_PACKEDBYTES],
+                             const mld_polyvecl mat[MLDSA_K])
+__contract__(
+  requires(memory_no_alias(r, MLDSA_POLYMAT_PACKEDBYTES))
+  requires(memory_no_alias(mat, MLDSA_K * sizeof(mld_polyvecl)))
+  requires(forall(k1, 0, MLDSA_K, forall(l1, 0, MLDSA_L,
+                                         array_bound(mat[k1].vec[l1].coeffs, 0, MLDSA_N, 0, MLDSA_Q))))
+  assigns(object_whole(r))
+);
+
+#define mld_polyvec_matrix_pointwise_montgomery_packed \
+  MLD_NAMESPACE(polyvec_matrix_pointwise_montgomery_packed)
+/*************************************************
+ * Name:        mld_polyvec_matrix_pointwise_montgomery_packed
+ *
+ * Description: Same as mld_polyvec_matrix_pointwise_montgomery(), but
+ *              reading the matrix from the packed representation of
+ *              mld_polyvec_matrix_pack(). Unpacking is fused with the
+ *              pointwise multiply-accumulate.
+ *
+ * Arguments:   - mld_polyveck *t: pointer to output vector t
+ *              - const uint8_t mat[MLDSA_POLYMAT_PACKEDBYTES]: packed
+ *                input matrix
+ *              - const mld_polyvecl *v: pointer to input vector v
+ **************************************************/
+void mld_polyvec_matrix_pointwise_montgomery_packed(
+    mld_polyveck *t, const uint8_t mat[MLDSA_POLYMAT_PACKEDBYTES],
+    const mld_polyvecl *v)
+__contract__(
+  requires(memory_no_alias(t, sizeof(mld_polyveck)))
+  requires(memory_no_alias(mat, MLDSA_POLYMAT_PACKEDBYTES))
+  requires(memory_no_alias(v, sizeof(mld_polyvecl)))
+  requires(forall(l1, 0, MLDSA_L,
+                  array_abs_bound(v->vec[l1].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
+  assigns(object_whole(t))
+  ensures(forall(k0, 0, MLDSA_K,
+                 array_abs_bound(t->vec[k0].coeffs, 0, MLDSA_N, MLDSA_Q)))
+);
+
+#if defined(MLD_CONFIG_REDUCE_RAM)
+#define mld_polyvec_matrix_expand_row MLD_NAMESPACE(polyvec_matrix_expand_row)
+/*************************************************
+ * Name:        mld_polyvec_matrix_expand_row
+ *
+ * Description: Generate row i of the matrix A, i.e. the same MLDSA_L
+ *              polynomials that mld_polyvec_matrix_expand() writes to
+ *              mat[i].
+ *
+ * Arguments:   - mld_polyvecl *row: output row
+ *              - const uint8_t rho[]: byte array containing seed rho
+ *              - unsigned int i: row index, in [0, MLDSA_K-1]
+ **************************************************/
+void mld_polyvec_matrix_expand_row(mld_polyvecl *row,
+                                   const uint8_t rho[MLDSA_SEEDBYTES],
+                                   unsigned int i)
+__contract__(
+  requires(memory_no_alias(row, sizeof(mld_polyvecl)))
+  requires(memory_no_alias(rho, MLDSA_SEEDBYTES))
+  requires(i < MLDSA_K)
+  assigns(memory_slice(row, sizeof(mld_polyvecl)))
+  ensures(forall(l1, 0, MLDSA_L,
+    array_bound(row->vec[l1].coeffs, 0, MLDSA_N, 0, MLDSA_Q)))
+);
+
+#define mld_polyvec_matrix_expand_packed \
+  MLD_NAMESPACE(polyvec_matrix_expand_packed)
+/*************************************************
+ * Name:        mld_polyvec_matrix_expand_packed
+ *
+ * Description: Generate the matrix A directly in the packed representation
+ *              of mld_polyvec_matrix_pack(), one row at a time, so that
+ *              the full unpacked matrix is never held in memory.
+ *
+ * Arguments:   - uint8_t r[MLDSA_POLYMAT_PACKEDBYTES]: output byte array
+ *              - const uint8_t rho[]: byte array containing seed rho
+ **************************************************/
+void mld_polyvec_matrix_expand_packed(uint8_t r[MLDSA_POLYMAT_PACKEDBYTES],
+                                      const uint8_t rho[MLDSA_SEEDBYTES])
+__contract__(
+  requires(memory_no_alias(r, MLDSA_POLYMAT_PACKEDBYTES))
+  requires(memory_no_alias(rho, MLDSA_SEEDBYTES))
+  assigns(object_whole(r))
+);
+
+#define mld_polyvec_matrix_pointwise_montgomery_stream \
+  MLD_NAMESPACE(polyvec_matrix_pointwise_montgomery_stream)
+/*************************************************
+ * Name:        mld_polyvec_matrix_pointwise_montgomery_stream
+ *
+ * Description: Same as mld_polyvec_matrix_pointwise_montgomery(), but
+ *              regenerating each row of the matrix from rho on demand.
+ *              Only a single row is held in memory at any time.
+ *
+ * Arguments:   - mld_polyveck *t: pointer to output vector t
+ *              - const uint8_t rho[]: byte array containing seed rho
+ *              - const mld_polyvecl *v: pointer to input vector v
+ **************************************************/
+void mld_polyvec_matrix_pointwise_montgomery_stream(
+    mld_polyveck *t, const uint8_t rho[MLDSA_SEEDBYTES],
+    const mld_polyvecl *v)
+__contract__(
+  requires(memory_no_alias(t, sizeof(mld_polyveck)))
+  requires(memory_no_alias(rho, MLDSA_SEEDBYTES))
+  requires(memory_no_alias(v, sizeof(mld_polyvecl)))
+  requires(forall(l1, 0, MLDSA_L,
+                  array_abs_bound(v->vec[l1].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
+  assigns(object_whole(t))
+  ensures(forall(k0, 0, MLDSA_K,
+                 array_abs_bound(t->vec[k0].coeffs, 0, MLDSA_N, MLDSA_Q)))
+);
+#endif /* MLD_CONFIG_REDUCE_RAM */
+
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+/* Vectors of polynomials with small coefficients, see mld_poly_small */
+typedef struct
+{
+  mld_poly_small vec[MLDSA_L];
+} mld_polyvecl_small;
+
+typedef struct
+{
+  mld_poly_small vec[MLDSA_K];
+} mld_polyveck_small;
+
+#define mld_polyvecl_unpack_eta_small MLD_NAMESPACE(polyvecl_unpack_eta_small)
+/*************************************************
+ * Name:        mld_polyvecl_unpack_eta_small
+ *
+ * Description: Unpack vector of polynomials with coefficients in
+ *              [-MLDSA_ETA,MLDSA_ETA] into half-width storage.
+ *
+ * Arguments:   - mld_polyvecl_small *p: pointer to output vector
+ *              - const uint8_t *r: input byte array
+ **************************************************/
+void mld_polyvecl_unpack_eta_small(
+    mld_polyvecl_small *p, const uint8_t r[MLDSA_L * MLDSA_POLYETA_PACKEDBYTES])
+__contract__(
+  requires(memory_no_alias(r, MLDSA_L * MLDSA_POLYETA_PACKEDBYTES))
+  requires(memory_no_alias(p, sizeof(mld_polyvecl_small)))
+  assigns(object_whole(p))
+  ensures(forall(k1, 0, MLDSA_L,
+    array_bound(p->vec[k1].coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
+);
+
+#define mld_polyveck_unpack_eta_small MLD_NAMESPACE(polyveck_unpack_eta_small)
+/*************************************************
+ * Name:        mld_polyveck_unpack_eta_small
+ *
+ * Description: Unpack vector of polynomials with coefficients in
+ *              [-MLDSA_ETA,MLDSA_ETA] into half-width storage.
+ *
+ * Arguments:   - mld_polyveck_small *p: pointer to output vector
+ *              - const uint8_t *r: input byte array
+ **************************************************/
+void mld_polyveck_unpack_eta_small(
+    mld_polyveck_small *p, const uint8_t r[MLDSA_K * MLDSA_POLYETA_PACKEDBYTES])
+__contract__(
+  requires(memory_no_alias(r, MLDSA_K * MLDSA_POLYETA_PACKEDBYTES))
+  requires(memory_no_alias(p, sizeof(mld_polyveck_small)))
+  assigns(object_whole(p))
+  ensures(forall(k1, 0, MLDSA_K,
+    array_bound(p->vec[k1].coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
+);
+
+#define mld_polyvecl_challenge_mul_small \
+  MLD_NAMESPACE(polyvecl_challenge_mul_small)
+/*************************************************
+ * Name:        mld_polyvecl_challenge_mul_small
+ *
+ * Description: Multiply each polynomial of a small vector by a challenge
+ *              polynomial, see mld_poly_challenge_mul_small().
+ *
+ * Arguments:   - mld_polyvecl *r: pointer to output vector
+ *              - const mld_poly *c: pointer to challenge polynomial
+ *              - const mld_polyvecl_small *s: pointer to input vector
+ **************************************************/
+void mld_polyvecl_challenge_mul_small(mld_polyvecl *r, const mld_poly *c,
+                                      const mld_polyvecl_small *s)
+__contract__(
+  requires(memory_no_alias(r, sizeof(mld_polyvecl)))
+  requires(memory_no_alias(c, sizeof(mld_poly)))
+  requires(memory_no_alias(s, sizeof(mld_polyvecl_small)))
+  requires(array_bound(c->coeffs, 0, MLDSA_N, -1, 2))
+  requires(forall(k0, 0, MLDSA_L,
+    array_bound(s->vec[k0].coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
+  assigns(memory_slice(r, sizeof(mld_polyvecl)))
+  ensures(forall(k1, 0, MLDSA_L,
+    array_abs_bound(r->vec[k1].coeffs, 0, MLDSA_N, MLD_POLY_SMALL_MUL_BOUND)))
+);
+
+#define mld_polyveck_challenge_mul_small \
+  MLD_NAMESPACE(polyveck_challenge_mul_small)
+/*************************************************
+ * Name:        mld_polyveck_challenge_mul_small
+ *
+ * Description: Multiply each polynomial of a small vector by a challenge
+ *              polynomial, see mld_poly_challenge_mul_small().
+ *
+ * Arguments:   - mld_polyveck *r: pointer to output vector
+ *              - const mld_poly *c: pointer to challenge polynomial
+ *              - const mld_polyveck_small *s: pointer to input vector
+ **************************************************/
+void mld_polyveck_challenge_mul_small(mld_polyveck *r, const mld_poly *c,
+                                      const mld_polyveck_small *s)
+__contract__(
+  requires(memory_no_alias(r, sizeof(mld_polyveck)))
+  requires(memory_no_alias(c, sizeof(mld_poly)))
+  requires(memory_no_alias(s, sizeof(mld_polyveck_small)))
+  requires(array_bound(c->coeffs, 0, MLDSA_N, -1, 2))
+  requires(forall(k0, 0, MLDSA_K,
+    array_bound(s->vec[k0].coeffs, 0, MLDSA_N, MLD_POLYETA_UNPACK_LOWER_BOUND, MLDSA_ETA + 1)))
+  assigns(memory_slice(r, sizeof(mld_polyveck)))
+  ensures(forall(k1, 0, MLDSA_K,
+    array_abs_bound(r->vec[k1].coeffs, 0, MLDSA_N, MLD_POLY_SMALL_MUL_BOUND)))
+);
+#endif /* MLD_CONFIG_SMALL_SECRETS */
+
 #endif /* !MLD_POLYVEC_H */
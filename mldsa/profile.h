@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#ifndef MLD_PROFILE_H
+#define MLD_PROFILE_H
+
+#include "common.h"
+
+/* Phases reported to the profiling hooks, see MLD_CONFIG_PROFILE_HOOK.
+ * Phases nest: the top-level phases are MLD_PROFILE_KEYPAIR, _SIGN and
+ * _VERIFY, each signing attempt is an MLD_PROFILE_ATTEMPT within
+ * MLD_PROFILE_SIGN, and all other phases occur within those. */
+#define MLD_PROFILE_KEYPAIR 0
+#define MLD_PROFILE_SIGN 1
+#define MLD_PROFILE_VERIFY 2
+#define MLD_PROFILE_ATTEMPT 3
+/* SHAKE256 hashing: seed expansion, tr, mu, rhoprime and H(mu, w1) */
+#define MLD_PROFILE_HASH 4
+/* Expansion of the matrix A from rho */
+#define MLD_PROFILE_EXPAND_MATRIX 5
+/* Sampling of the secret vectors s1 and s2 */
+#define MLD_PROFILE_SAMPLE_S 6
+/* Sampling of the masking vector y */
+#define MLD_PROFILE_SAMPLE_Y 7
+/* Sampling of the challenge polynomial c */
+#define MLD_PROFILE_SAMPLE_CHALLENGE 8
+/* NTTs, inverse NTTs, and (matrix-vector) multiplication in NTT domain */
+#define MLD_PROFILE_NTT 9
+/* Decomposition, rounding, hints and norm checks */
+#define MLD_PROFILE_ROUNDING 10
+/* Bit-packing of keys, signatures and w1 */
+#define MLD_PROFILE_PACK 11
+/* Bit-unpacking of keys and signatures */
+#define MLD_PROFILE_UNPACK 12
+#define MLD_PROFILE_NUM_PHASES 13
+
+#if defined(MLD_CONFIG_PROFILE_HOOK)
+
+/*************************************************
+ * Name:        mld_profile_begin / mld_profile_end
+ *
+ * Description: Profiling hooks, to be provided by the user. They are called
+ *              at the start and at the end of each phase, with properly
+ *              nested pairs of calls. A phase may occur many times within
+ *              one call to the API.
+ *
+ *              The hooks are not namespaced: in a multilevel build, all
+ *              parameter sets report to the same hooks.
+ *
+ * Arguments:   - unsigned phase: one of MLD_PROFILE_xxx
+ **************************************************/
+void mld_profile_begin(unsigned phase);
+void mld_profile_end(unsigned phase);
+
+#define MLD_PROFILE_BEGIN(phase) mld_profile_begin(phase)
+#define MLD_PROFILE_END(phase) mld_profile_end(phase)
+
+#else /* MLD_CONFIG_PROFILE_HOOK */
+
+#define MLD_PROFILE_BEGIN(phase) \
+  do                             \
+  {                              \
+  } while (0)
+#define MLD_PROFILE_END(phase) \
+  do                           \
+  {                            \
+  } while (0)
+
+#endif /* !MLD_CONFIG_PROFILE_HOOK */
+
+/* Runs the single statement stmt as one occurrence of phase. Phases
+ * spanning several statements use one MLD_PROFILE_BEGIN/END pair around
+ * them instead. In either case, a phase is never left early, e.g. via
+ * return, so that every phase has exactly one begin and one end hook. */
+#define MLD_PROFILE(phase, stmt) \
+  do                             \
+  {                              \
+    MLD_PROFILE_BEGIN(phase);    \
+    stmt;                        \
+    MLD_PROFILE_END(phase);      \
+  } while (0)
+
+#endif /* !MLD_PROFILE_H */
@@ -7,6 +7,8 @@
 #include "ct.h"
 #include "reduce.h"
 
+#if !defined(MLD_CONFIG_MULTILEVEL_NO_SHARED)
+
 /*************************************************
  * Name:        mld_cast_uint32_to_int32
  *
@@ -74,3 +76,9 @@ int32_t mld_caddq(int32_t a)
 {
   return mld_ct_sel_int32(a + MLDSA_Q, a, mld_ct_cmask_neg_i32(a));
 }
+
+#else /* !MLD_CONFIG_MULTILEVEL_NO_SHARED */
+
+MLD_EMPTY_CU(reduce)
+
+#endif /* MLD_CONFIG_MULTILEVEL_NO_SHARED */
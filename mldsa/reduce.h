@@ -24,7 +24,7 @@
 #define MONTGOMERY_REDUCE_STRONG_DOMAIN_MAX ((int64_t)INT32_MIN * -MLDSA_Q)
 
 
-#define mld_montgomery_reduce MLD_NAMESPACE(montgomery_reduce)
+#define mld_montgomery_reduce MLD_NAMESPACE_SHARED(montgomery_reduce)
 /*************************************************
  * Name:        mld_montgomery_reduce
  *
@@ -56,7 +56,7 @@ __contract__(
           (return_value > -MLDSA_Q && return_value < MLDSA_Q))
 );
 
-#define mld_reduce32 MLD_NAMESPACE(reduce32)
+#define mld_reduce32 MLD_NAMESPACE_SHARED(reduce32)
 /*************************************************
  * Name:        mld_reduce32
  *
@@ -75,7 +75,7 @@ __contract__(
   ensures(return_value <   REDUCE32_RANGE_MAX)
 );
 
-#define mld_caddq MLD_NAMESPACE(caddq)
+#define mld_caddq MLD_NAMESPACE_SHARED(caddq)
 /*************************************************
  * Name:        mld_caddq
  *
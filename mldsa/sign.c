@@ -7,19 +7,25 @@
 
 #include "cbmc.h"
 #include "fips202/fips202.h"
+#include "fips202/fips202x4.h"
 #include "packing.h"
 #include "poly.h"
 #include "polyvec.h"
+#include "profile.h"
 #include "randombytes.h"
 #include "sign.h"
+#include "stats.h"
 #include "symmetric.h"
+#include "verify_cache.h"
 
 
 static int mld_check_pct(uint8_t const pk[CRYPTO_PUBLICKEYBYTES],
-                         uint8_t const sk[CRYPTO_SECRETKEYBYTES])
+                         const mld_sign_ctx *sctx)
 __contract__(
   requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
-  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  requires(memory_no_alias(sctx, sizeof(mld_sign_ctx)))
+  requires(MLD_SIGN_CTX_BOUND(sctx))
+  requires(sctx->mu_state.pos <= SHAKE256_RATE)
   ensures(return_value == 0 || return_value == -1)
 );
 
@@ -32,16 +38,19 @@ __contract__(
  *
  * Purpose: Validates that a generated public/private key pair can correctly
  * sign and verify data. Test performs signature generation using the private
- * key (sk), followed by signature verification using the public key (pk).
+ * key, given as signing context (sctx), followed by signature verification
+ * using the public key (pk).
  * Returns 0 if the signature was successfully verified, non-zero if it cannot.
  *
  * Note: FIPS 204 requires that public/private key pairs are to be used only for
  * the calculation and/of verification of digital signatures.
  **************************************************/
 static int mld_check_pct(uint8_t const pk[CRYPTO_PUBLICKEYBYTES],
-                         uint8_t const sk[CRYPTO_SECRETKEYBYTES])
+                         const mld_sign_ctx *sctx)
 {
   uint8_t message[1] = {0};
+  /* pre = (0, ctxlen, ctx) for the empty context string */
+  const uint8_t pre[2] = {0, 0};
   uint8_t signature[CRYPTO_BYTES];
   uint8_t pk_test[CRYPTO_PUBLICKEYBYTES];
   size_t siglen;
@@ -51,8 +60,8 @@ static int mld_check_pct(uint8_t const pk[CRYPTO_PUBLICKEYBYTES],
   memcpy(pk_test, pk, CRYPTO_PUBLICKEYBYTES);
 
   /* Sign a test message using the original secret key */
-  ret = crypto_sign_signature(signature, &siglen, message, sizeof(message),
-                              NULL, 0, sk);
+  ret = crypto_sign_signature_ctx(signature, &siglen, message, sizeof(message),
+                                  NULL, 0, sctx);
   if (ret == 0)
   {
 #if defined(MLD_CONFIG_KEYGEN_PCT_BREAKAGE_TEST)
@@ -63,9 +72,12 @@ static int mld_check_pct(uint8_t const pk[CRYPTO_PUBLICKEYBYTES],
     }
 #endif /* MLD_CONFIG_KEYGEN_PCT_BREAKAGE_TEST */
 
-    /* Verify the signature using the (potentially corrupted) public key */
-    ret = crypto_sign_verify(signature, siglen, message, sizeof(message), NULL,
-                             0, pk_test);
+    /* Verify the signature using the (potentially corrupted) public key.
+     * This bypasses the verification cache of crypto_sign_verify(), which
+     * must neither serve nor remember the PCT. */
+    ret = crypto_sign_verify_internal(signature, siglen, message,
+                                      sizeof(message), pre, sizeof(pre),
+                                      pk_test, 0);
   }
 
   /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
@@ -76,11 +88,11 @@ static int mld_check_pct(uint8_t const pk[CRYPTO_PUBLICKEYBYTES],
 }
 #else  /* MLD_CONFIG_KEYGEN_PCT */
 static int mld_check_pct(uint8_t const pk[CRYPTO_PUBLICKEYBYTES],
-                         uint8_t const sk[CRYPTO_SECRETKEYBYTES])
+                         const mld_sign_ctx *sctx)
 {
   /* Skip PCT */
   ((void)pk);
-  ((void)sk);
+  ((void)sctx);
   return 0;
 }
 #endif /* !MLD_CONFIG_KEYGEN_PCT */
@@ -123,77 +135,653 @@ __contract__(
 #endif /* MLDSA_MODE == 5 */
 }
 
-MLD_MUST_CHECK_RETURN_VALUE
-int crypto_sign_keypair_internal(uint8_t *pk, uint8_t *sk,
-                                 const uint8_t seed[MLDSA_SEEDBYTES])
+/*************************************************
+ * Name:        mld_mu_midstate_init
+ *
+ * Description: Initializes a SHAKE256 state and absorbs tr into it, as
+ *              the common prefix of all computations of mu for one key.
+ *
+ * Arguments:   - keccak_state *state: pointer to output state
+ *              - const uint8_t tr[]: byte array containing tr
+ **************************************************/
+static void mld_mu_midstate_init(keccak_state *state,
+                                 const uint8_t tr[MLDSA_TRBYTES])
+__contract__(
+  requires(memory_no_alias(state, sizeof(keccak_state)))
+  requires(memory_no_alias(tr, MLDSA_TRBYTES))
+  assigns(memory_slice(state, sizeof(keccak_state)))
+  ensures(state->pos <= SHAKE256_RATE)
+)
+{
+  shake256_init(state);
+  shake256_absorb(state, tr, MLDSA_TRBYTES);
+}
+
+/*************************************************
+ * Name:        mld_mu_from_midstate
+ *
+ * Description: Computes mu = CRH(tr, pre, msg), starting from the state
+ *              computed by mld_mu_midstate_init() for tr.
+ *
+ * Arguments:   - uint8_t mu[]: output mu
+ *              - const keccak_state *state: pointer to state after tr
+ *              - const uint8_t *pre: pointer to prefix
+ *              - size_t prelen: length of prefix
+ *              - const uint8_t *m: pointer to message
+ *              - size_t mlen: length of message
+ **************************************************/
+static void mld_mu_from_midstate(uint8_t mu[MLDSA_CRHBYTES],
+                                 const keccak_state *state,
+                                 const uint8_t *pre, size_t prelen,
+                                 const uint8_t *m, size_t mlen)
+__contract__(
+  requires(memory_no_alias(mu, MLDSA_CRHBYTES))
+  requires(memory_no_alias(state, sizeof(keccak_state)))
+  requires(state->pos <= SHAKE256_RATE)
+  requires(memory_no_alias(pre, prelen))
+  requires(memory_no_alias(m, mlen))
+  assigns(memory_slice(mu, MLDSA_CRHBYTES))
+)
+{
+  keccak_state st = *state;
+  shake256_absorb(&st, pre, prelen);
+  shake256_absorb(&st, m, mlen);
+  shake256_finalize(&st);
+  shake256_squeeze(mu, MLDSA_CRHBYTES, &st);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&st, sizeof(st));
+}
+
+/*************************************************
+ * Name:        mld_mu_from_midstate_iov
+ *
+ * Description: Same as mld_mu_from_midstate(), but with the message given
+ *              as a list of segments.
+ *
+ * Arguments:   - uint8_t mu[]: output mu
+ *              - const keccak_state *state: pointer to state after tr
+ *              - const uint8_t *pre: pointer to prefix
+ *              - size_t prelen: length of prefix
+ *              - const mld_iovec *iov: array of message segments
+ *              - size_t iovcnt: number of message segments
+ **************************************************/
+static void mld_mu_from_midstate_iov(uint8_t mu[MLDSA_CRHBYTES],
+                                     const keccak_state *state,
+                                     const uint8_t *pre, size_t prelen,
+                                     const mld_iovec *iov, size_t iovcnt)
+__contract__(
+  requires(memory_no_alias(mu, MLDSA_CRHBYTES))
+  requires(memory_no_alias(state, sizeof(keccak_state)))
+  requires(state->pos <= SHAKE256_RATE)
+  requires(memory_no_alias(pre, prelen))
+  requires(memory_no_alias(iov, iovcnt * sizeof(mld_iovec)))
+  requires(forall(k, 0, iovcnt, readable(iov[k].ptr, iov[k].len)))
+  assigns(memory_slice(mu, MLDSA_CRHBYTES))
+)
 {
+  size_t i;
+  keccak_state st = *state;
+  shake256_absorb(&st, pre, prelen);
+  for (i = 0; i < iovcnt; i++)
+  __loop__(
+    assigns(i, memory_slice(&st, sizeof(keccak_state)))
+    invariant(i <= iovcnt)
+    invariant(st.pos <= SHAKE256_RATE)
+  )
+  {
+    shake256_absorb(&st, iov[i].ptr, iov[i].len);
+  }
+  shake256_finalize(&st);
+  shake256_squeeze(mu, MLDSA_CRHBYTES, &st);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&st, sizeof(st));
+}
+
+/*************************************************
+ * Name:        mld_compute_t0_t1
+ *
+ * Description: Computes t = A*s1 + s2 for key generation and splits it
+ *              into high bits t1 (public key) and low bits t0 (secret key).
+ *              The product is profiled as MLD_PROFILE_NTT and the split as
+ *              MLD_PROFILE_ROUNDING, so callers need not wrap it.
+ *
+ * Arguments:   - mld_polyveck *t1: pointer to output high bits
+ *              - mld_polyveck *t0: pointer to output low bits
+ *              - const mld_sign_matrix *mat: matrix A
+ *              - const mld_polyvecl *s1hat: secret vector s1 in NTT domain
+ *              - const mld_polyveck *s2: pointer to secret vector s2
+ **************************************************/
+static void mld_compute_t0_t1(mld_polyveck *t1, mld_polyveck *t0,
+                              const mld_sign_matrix *mat,
+                              const mld_polyvecl *s1hat,
+                              const mld_polyveck *s2)
+__contract__(
+  requires(memory_no_alias(t1, sizeof(mld_polyveck)))
+  requires(memory_no_alias(t0, sizeof(mld_polyveck)))
+  requires(memory_no_alias(mat, sizeof(mld_sign_matrix)))
+  requires(memory_no_alias(s1hat, sizeof(mld_polyvecl)))
+  requires(memory_no_alias(s2, sizeof(mld_polyveck)))
+  requires(MLD_SIGN_MATRIX_BOUND(mat))
+  requires(forall(l0, 0, MLDSA_L, array_abs_bound(s1hat->vec[l0].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
+  requires(forall(k0, 0, MLDSA_K, array_abs_bound(s2->vec[k0].coeffs, 0, MLDSA_N, MLDSA_ETA + 1)))
+  assigns(object_whole(t1), object_whole(t0))
+  ensures(forall(k1, 0, MLDSA_K, array_bound(t0->vec[k1].coeffs, 0, MLDSA_N, -(MLD_2_POW_D/2)+1, (MLD_2_POW_D/2)+1)))
+  ensures(forall(k2, 0, MLDSA_K, array_bound(t1->vec[k2].coeffs, 0, MLDSA_N, 0, ((MLDSA_Q - 1) / MLD_2_POW_D) + 1)))
+)
+{
+  mld_polyveck t;
+
+  /* Matrix-vector multiplication */
+  MLD_PROFILE_BEGIN(MLD_PROFILE_NTT);
+  mld_sign_matrix_mul(&t, mat, s1hat);
+  mld_polyveck_reduce(&t);
+  mld_polyveck_invntt_tomont(&t);
+
+  /* Add error vector s2 */
+  mld_polyveck_add(&t, s2);
+  MLD_PROFILE_END(MLD_PROFILE_NTT);
+
+  /* Extract t1 and t0 */
+  MLD_PROFILE_BEGIN(MLD_PROFILE_ROUNDING);
+  mld_polyveck_caddq(&t);
+  mld_polyveck_power2round(t1, t0, &t);
+  MLD_PROFILE_END(MLD_PROFILE_ROUNDING);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&t, sizeof(t));
+}
+
+/* Secret intermediate values of key generation.
+ *
+ * They are kept together so that a signing context can be filled from them
+ * without unpacking the secret key and expanding A a second time, and so
+ * that a single mld_zeroize() destroys them. */
+typedef struct mld_keypair_ws
+{
+  /* rho, rhoprime and key */
   uint8_t seedbuf[2 * MLDSA_SEEDBYTES + MLDSA_CRHBYTES];
-  uint8_t inbuf[MLDSA_SEEDBYTES + 2];
   uint8_t tr[MLDSA_TRBYTES];
-  const uint8_t *rho, *rhoprime, *key;
-  mld_polyvecl mat[MLDSA_K];
   mld_polyvecl s1, s1hat;
-  mld_polyveck s2, t2, t1, t0;
+  mld_polyveck s2, t0;
+} MLD_ALIGN mld_keypair_ws;
+
+#define MLD_KEYPAIR_WS_BOUND(ws)                                             \
+  (forall(l1, 0, MLDSA_L,                                                    \
+          array_abs_bound((ws)->s1.vec[l1].coeffs, 0, MLDSA_N,               \
+                          MLDSA_ETA + 1)) &&                                 \
+   forall(l2, 0, MLDSA_L,                                                    \
+          array_abs_bound((ws)->s1hat.vec[l2].coeffs, 0, MLDSA_N,            \
+                          MLD_NTT_BOUND)) &&                                 \
+   forall(k1, 0, MLDSA_K,                                                    \
+          array_abs_bound((ws)->s2.vec[k1].coeffs, 0, MLDSA_N,               \
+                          MLDSA_ETA + 1)) &&                                 \
+   forall(k2, 0, MLDSA_K,                                                    \
+          array_bound((ws)->t0.vec[k2].coeffs, 0, MLDSA_N,                   \
+                      -(MLD_2_POW_D / 2) + 1, (MLD_2_POW_D / 2) + 1)))
+
+/*************************************************
+ * Name:        mld_keypair_compute
+ *
+ * Description: Generates a key pair from a seed. A is expanded into mat,
+ *              and the secret intermediate values are left in ws for the
+ *              caller to either wipe or turn into a signing context.
+ *
+ * Arguments:   - uint8_t *pk: pointer to output public key
+ *              - uint8_t *sk: pointer to output private key
+ *              - const uint8_t *seed: pointer to input random seed
+ *              - mld_sign_matrix *mat: pointer to output matrix A
+ *              - mld_keypair_ws *ws: pointer to output intermediate values
+ **************************************************/
+static void mld_keypair_compute(uint8_t *pk, uint8_t *sk,
+                                const uint8_t seed[MLDSA_SEEDBYTES],
+                                mld_sign_matrix *mat, mld_keypair_ws *ws)
+__contract__(
+  requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
+  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  requires(memory_no_alias(seed, MLDSA_SEEDBYTES))
+  requires(memory_no_alias(mat, sizeof(mld_sign_matrix)))
+  requires(memory_no_alias(ws, sizeof(mld_keypair_ws)))
+  assigns(object_whole(pk))
+  assigns(object_whole(sk))
+  assigns(memory_slice(mat, sizeof(mld_sign_matrix)))
+  assigns(memory_slice(ws, sizeof(mld_keypair_ws)))
+  ensures(MLD_SIGN_MATRIX_BOUND(mat))
+  ensures(MLD_KEYPAIR_WS_BOUND(ws))
+)
+{
+  uint8_t inbuf[MLDSA_SEEDBYTES + 2];
+  const uint8_t *rho, *rhoprime, *key;
+  mld_polyveck t1;
 
   /* Get randomness for rho, rhoprime and key */
   memcpy(inbuf, seed, MLDSA_SEEDBYTES);
   inbuf[MLDSA_SEEDBYTES + 0] = MLDSA_K;
   inbuf[MLDSA_SEEDBYTES + 1] = MLDSA_L;
-  shake256(seedbuf, 2 * MLDSA_SEEDBYTES + MLDSA_CRHBYTES, inbuf,
-           MLDSA_SEEDBYTES + 2);
-  rho = seedbuf;
+  MLD_PROFILE(MLD_PROFILE_HASH,
+              shake256(ws->seedbuf, 2 * MLDSA_SEEDBYTES + MLDSA_CRHBYTES,
+                       inbuf, MLDSA_SEEDBYTES + 2));
+  rho = ws->seedbuf;
   rhoprime = rho + MLDSA_SEEDBYTES;
   key = rhoprime + MLDSA_CRHBYTES;
 
   /* Constant time: rho is part of the public key and, hence, public. */
   MLD_CT_TESTING_DECLASSIFY(rho, MLDSA_SEEDBYTES);
-  /* Expand matrix */
-  mld_polyvec_matrix_expand(mat, rho);
-  mld_sample_s1_s2(&s1, &s2, rhoprime);
+  MLD_PROFILE(MLD_PROFILE_SAMPLE_S,
+              mld_sample_s1_s2(&ws->s1, &ws->s2, rhoprime));
 
-  /* Matrix-vector multiplication */
-  s1hat = s1;
-  mld_polyvecl_ntt(&s1hat);
-  mld_polyvec_matrix_pointwise_montgomery(&t1, mat, &s1hat);
-  mld_polyveck_reduce(&t1);
-  mld_polyveck_invntt_tomont(&t1);
-
-  /* Add error vector s2 */
-  mld_polyveck_add(&t1, &s2);
-
-  /* Extract t1 and write public key */
-  mld_polyveck_caddq(&t1);
-  mld_polyveck_power2round(&t2, &t0, &t1);
-  mld_pack_pk(pk, rho, &t2);
+  /* Compute t = A*s1 + s2 and write public key */
+  MLD_PROFILE(MLD_PROFILE_EXPAND_MATRIX, mld_sign_matrix_init(mat, rho));
+  ws->s1hat = ws->s1;
+  MLD_PROFILE(MLD_PROFILE_NTT, mld_polyvecl_ntt(&ws->s1hat));
+  mld_compute_t0_t1(&t1, &ws->t0, mat, &ws->s1hat, &ws->s2);
+  MLD_PROFILE(MLD_PROFILE_PACK, mld_pack_pk(pk, rho, &t1));
 
   /* Compute H(rho, t1) and write secret key */
-  shake256(tr, MLDSA_TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
-  mld_pack_sk(sk, rho, tr, key, &t0, &s1, &s2);
+  MLD_PROFILE(MLD_PROFILE_HASH,
+              shake256(ws->tr, MLDSA_TRBYTES, pk, CRYPTO_PUBLICKEYBYTES));
+  MLD_PROFILE(MLD_PROFILE_PACK, mld_pack_sk(sk, rho, ws->tr, key, &ws->t0,
+                                            &ws->s1, &ws->s2));
 
   /* FIPS 204. Section 3.6.3 Destruction of intermediate values.  */
-  mld_zeroize(seedbuf, sizeof(seedbuf));
   mld_zeroize(inbuf, sizeof(inbuf));
-  mld_zeroize(tr, sizeof(tr));
-  mld_zeroize(mat, sizeof(mat));
-  mld_zeroize(&s1, sizeof(s1));
-  mld_zeroize(&s1hat, sizeof(s1hat));
-  mld_zeroize(&s2, sizeof(s2));
   mld_zeroize(&t1, sizeof(t1));
-  mld_zeroize(&t2, sizeof(t2));
-  mld_zeroize(&t0, sizeof(t0));
 
   /* Constant time: pk is the public key, inherently public data */
   MLD_CT_TESTING_DECLASSIFY(pk, CRYPTO_PUBLICKEYBYTES);
+}
+
+/*************************************************
+ * Name:        mld_sign_ctx_from_keygen
+ *
+ * Description: Fills a signing context from the intermediate values of key
+ *              generation. This is the cheap counterpart of
+ *              mld_sign_ctx_init(): s1 is already in NTT domain, and A is
+ *              expected to have been expanded into sctx->mat by key
+ *              generation already.
+ *
+ * Arguments:   - mld_sign_ctx *sctx: pointer to output signing context
+ *              - const mld_keypair_ws *ws: intermediate values of
+ *                                          mld_keypair_compute()
+ **************************************************/
+static void mld_sign_ctx_from_keygen(mld_sign_ctx *sctx,
+                                     const mld_keypair_ws *ws)
+__contract__(
+  requires(memory_no_alias(sctx, sizeof(mld_sign_ctx)))
+  requires(memory_no_alias(ws, sizeof(mld_keypair_ws)))
+  requires(MLD_SIGN_MATRIX_BOUND(&sctx->mat))
+  requires(MLD_KEYPAIR_WS_BOUND(ws))
+  assigns(object_whole(sctx))
+  ensures(MLD_SIGN_CTX_BOUND(sctx))
+  ensures(sctx->mu_state.pos <= SHAKE256_RATE)
+)
+{
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+  unsigned i;
+#endif
+
+  memcpy(sctx->rho, ws->seedbuf, MLDSA_SEEDBYTES);
+  memcpy(sctx->key, ws->seedbuf + MLDSA_SEEDBYTES + MLDSA_CRHBYTES,
+         MLDSA_SEEDBYTES);
+  memcpy(sctx->tr, ws->tr, MLDSA_TRBYTES);
+  MLD_PROFILE(MLD_PROFILE_HASH,
+              mld_mu_midstate_init(&sctx->mu_state, sctx->tr));
+
+  /* Bring s1, s2 and t0 into the representation used for signing */
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+  MLD_PROFILE_BEGIN(MLD_PROFILE_PACK);
+  for (i = 0; i < MLDSA_L; i++)
+  __loop__(invariant(i <= MLDSA_L))
+  {
+    mld_poly_small_from_poly(&sctx->s1.vec[i], &ws->s1.vec[i]);
+  }
+  for (i = 0; i < MLDSA_K; i++)
+  __loop__(invariant(i <= MLDSA_K))
+  {
+    mld_poly_small_from_poly(&sctx->s2.vec[i], &ws->s2.vec[i]);
+  }
+  MLD_PROFILE_END(MLD_PROFILE_PACK);
+  sctx->t0 = ws->t0;
+  MLD_PROFILE(MLD_PROFILE_NTT, mld_polyveck_ntt(&sctx->t0));
+#else  /* MLD_CONFIG_SMALL_SECRETS */
+  sctx->s1 = ws->s1hat;
+  sctx->s2 = ws->s2;
+  sctx->t0 = ws->t0;
+  MLD_PROFILE_BEGIN(MLD_PROFILE_NTT);
+  mld_polyveck_ntt(&sctx->s2);
+  mld_polyveck_ntt(&sctx->t0);
+  MLD_PROFILE_END(MLD_PROFILE_NTT);
+#endif /* !MLD_CONFIG_SMALL_SECRETS */
+}
+
+/*************************************************
+ * Name:        mld_keypair_core
+ *
+ * Description: Generates a key pair from a seed and fills the signing
+ *              context from the values computed on the way, then runs the
+ *              PCT against this context.
+ *
+ * Arguments:   - uint8_t *pk: pointer to output public key
+ *              - uint8_t *sk: pointer to output private key
+ *              - const uint8_t *seed: pointer to input random seed
+ *              - mld_sign_ctx *sctx: pointer to output signing context
+ *
+ * Returns 0 (success) or -1 (PCT failure)
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+static int mld_keypair_core(uint8_t *pk, uint8_t *sk,
+                            const uint8_t seed[MLDSA_SEEDBYTES],
+                            mld_sign_ctx *sctx)
+__contract__(
+  requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
+  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  requires(memory_no_alias(seed, MLDSA_SEEDBYTES))
+  requires(memory_no_alias(sctx, sizeof(mld_sign_ctx)))
+  assigns(object_whole(pk))
+  assigns(object_whole(sk))
+  assigns(object_whole(sctx))
+  ensures(return_value == 0 || return_value == -1)
+  ensures(MLD_SIGN_CTX_BOUND(sctx))
+  ensures(sctx->mu_state.pos <= SHAKE256_RATE)
+)
+{
+  mld_keypair_ws ws;
+
+  mld_keypair_compute(pk, sk, seed, &sctx->mat, &ws);
+  mld_sign_ctx_from_keygen(sctx, &ws);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values.  */
+  mld_zeroize(&ws, sizeof(ws));
 
   /* Pairwise Consistency Test (PCT) @[FIPS140_3_IG, p.87] */
-  if (mld_check_pct(pk, sk))
+  if (mld_check_pct(pk, sctx))
   {
+    /* Do not hand out a key pair that failed the PCT */
+    mld_zeroize(pk, CRYPTO_PUBLICKEYBYTES);
+    mld_zeroize(sk, CRYPTO_SECRETKEYBYTES);
+    mld_zeroize(sctx, sizeof(mld_sign_ctx));
     return -1;
   }
 
   return 0;
 }
 
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_keypair_internal(uint8_t *pk, uint8_t *sk,
+                                 const uint8_t seed[MLDSA_SEEDBYTES])
+{
+#if defined(MLD_CONFIG_KEYGEN_PCT)
+  /* The PCT signs with the new key, so keep the values computed for it */
+  mld_sign_ctx sctx;
+  int result;
+
+  MLD_PROFILE(MLD_PROFILE_KEYPAIR,
+              result = mld_keypair_core(pk, sk, seed, &sctx));
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&sctx, sizeof(sctx));
+  return result;
+#else  /* MLD_CONFIG_KEYGEN_PCT */
+  mld_sign_matrix mat;
+  mld_keypair_ws ws;
+
+  MLD_PROFILE(MLD_PROFILE_KEYPAIR,
+              mld_keypair_compute(pk, sk, seed, &mat, &ws));
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&mat, sizeof(mat));
+  mld_zeroize(&ws, sizeof(ws));
+  return 0;
+#endif /* !MLD_CONFIG_KEYGEN_PCT */
+}
+
+/*************************************************
+ * Name:        mld_sign_ctx_init
+ *
+ * Description: Fills a signing context from a bit-packed secret key.
+ *
+ * Arguments:   - mld_sign_ctx *sctx: pointer to output signing context
+ *              - const uint8_t *sk: pointer to bit-packed secret key
+ **************************************************/
+static void mld_sign_ctx_init(mld_sign_ctx *sctx,
+                              const uint8_t sk[CRYPTO_SECRETKEYBYTES])
+__contract__(
+  requires(memory_no_alias(sctx, sizeof(mld_sign_ctx)))
+  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  assigns(object_whole(sctx))
+  ensures(MLD_SIGN_CTX_BOUND(sctx))
+  ensures(sctx->mu_state.pos <= SHAKE256_RATE)
+)
+{
+  MLD_PROFILE(MLD_PROFILE_UNPACK,
+              mld_unpack_sk_secret(sctx->rho, sctx->tr, sctx->key, &sctx->t0,
+                                   &sctx->s1, &sctx->s2, sk));
+  MLD_PROFILE(MLD_PROFILE_HASH,
+              mld_mu_midstate_init(&sctx->mu_state, sctx->tr));
+
+  /* Constant time: rho is part of the public key and, hence, public. */
+  MLD_CT_TESTING_DECLASSIFY(sctx->rho, MLDSA_SEEDBYTES);
+  /* Expand matrix and transform vectors */
+  MLD_PROFILE(MLD_PROFILE_EXPAND_MATRIX,
+              mld_sign_matrix_init(&sctx->mat, sctx->rho));
+  MLD_PROFILE_BEGIN(MLD_PROFILE_NTT);
+#if !defined(MLD_CONFIG_SMALL_SECRETS)
+  mld_polyvecl_ntt(&sctx->s1);
+  mld_polyveck_ntt(&sctx->s2);
+#endif
+  mld_polyveck_ntt(&sctx->t0);
+  MLD_PROFILE_END(MLD_PROFILE_NTT);
+}
+
+/* Size of one packed (s1, s2) pair, as held by batched key generation */
+#define MLD_KEYPAIR_X4_ETA_PACKEDBYTES \
+  ((MLDSA_L + MLDSA_K) * MLDSA_POLYETA_PACKEDBYTES)
+
+/*************************************************
+ * Name:        mld_keypair_x4
+ *
+ * Description: Generates four key pairs at once, running the SHAKE256
+ *              invocations of key generation across the four lanes of
+ *              the x4 Keccak permutation. Each key pair is identical to
+ *              the one computed by crypto_sign_keypair_internal from the
+ *              same seed.
+ *
+ * Arguments:   - uint8_t *pks: output public keys (4 * CRYPTO_PUBLICKEYBYTES)
+ *              - uint8_t *sks: output secret keys (4 * CRYPTO_SECRETKEYBYTES)
+ *              - const uint8_t *seeds: input seeds (4 * MLDSA_SEEDBYTES)
+ *
+ * Returns 0 (success) or -1 (PCT failure)
+ **************************************************/
+static int mld_keypair_x4(uint8_t *pks, uint8_t *sks, const uint8_t *seeds)
+__contract__(
+  requires(memory_no_alias(pks, 4 * CRYPTO_PUBLICKEYBYTES))
+  requires(memory_no_alias(sks, 4 * CRYPTO_SECRETKEYBYTES))
+  requires(memory_no_alias(seeds, 4 * MLDSA_SEEDBYTES))
+  assigns(memory_slice(pks, 4 * CRYPTO_PUBLICKEYBYTES))
+  assigns(memory_slice(sks, 4 * CRYPTO_SECRETKEYBYTES))
+  ensures(return_value == 0 || return_value == -1)
+)
+{
+  MLD_ALIGN uint8_t inbuf[4][MLD_ALIGN_UP(MLDSA_SEEDBYTES + 2)];
+  /* SHAKE256 output for (rho, rhoprime, key), later reused for tr */
+  MLD_ALIGN uint8_t seedbuf[4][MLD_ALIGN_UP(STREAM256_BLOCKBYTES)];
+  MLD_ALIGN uint8_t extseed[4][MLD_ALIGN_UP(MLDSA_CRHBYTES + 2)];
+  uint8_t s_packed[4][MLD_KEYPAIR_X4_ETA_PACKEDBYTES];
+  mld_poly s[4];
+  mld_polyveck t1;
+  mld_keypair_ws ws;
+#if defined(MLD_CONFIG_KEYGEN_PCT)
+  /* A is expanded straight into the signing context used by the PCT */
+  mld_sign_ctx sctx;
+  mld_sign_matrix *mat = &sctx.mat;
+#else
+  /* tr depends on the packed public key and is filled in afterwards */
+  const uint8_t tr_placeholder[MLDSA_TRBYTES] = {0};
+  const uint8_t *pk_lanes[4];
+  mld_sign_matrix mat_storage;
+  mld_sign_matrix *mat = &mat_storage;
+#endif /* !MLD_CONFIG_KEYGEN_PCT */
+  mld_xof256_x4_ctx state;
+  unsigned i, j;
+  int result = 0;
+
+  /* Get randomness for rho, rhoprime and key of all four keys */
+  for (j = 0; j < 4; j++)
+  __loop__(invariant(j <= 4))
+  {
+    memcpy(inbuf[j], seeds + j * MLDSA_SEEDBYTES, MLDSA_SEEDBYTES);
+    inbuf[j][MLDSA_SEEDBYTES + 0] = MLDSA_K;
+    inbuf[j][MLDSA_SEEDBYTES + 1] = MLDSA_L;
+  }
+  mld_xof256_x4_init(&state);
+  mld_xof256_x4_absorb(&state, inbuf, MLDSA_SEEDBYTES + 2);
+  mld_xof256_x4_squeezeblocks(seedbuf, 1, &state);
+  mld_xof256_x4_release(&state);
+
+  /* Sample s1 and s2. Polynomial i of all four keys shares the nonce i,
+   * so every x4 call is fully used, whatever the parameter set. */
+  for (j = 0; j < 4; j++)
+  __loop__(invariant(j <= 4))
+  {
+    memcpy(extseed[j], seedbuf[j] + MLDSA_SEEDBYTES, MLDSA_CRHBYTES);
+    extseed[j][MLDSA_CRHBYTES + 1] = 0;
+  }
+  for (i = 0; i < MLDSA_L + MLDSA_K; i++)
+  __loop__(invariant(i <= MLDSA_L + MLDSA_K))
+  {
+    for (j = 0; j < 4; j++)
+    __loop__(invariant(j <= 4))
+    {
+      extseed[j][MLDSA_CRHBYTES] = (uint8_t)i;
+    }
+    mld_poly_uniform_eta_4x_seeds(&s[0], &s[1], &s[2], &s[3], extseed);
+    for (j = 0; j < 4; j++)
+    __loop__(invariant(j <= 4))
+    {
+      mld_polyeta_pack(s_packed[j] + i * MLDSA_POLYETA_PACKEDBYTES, &s[j]);
+    }
+  }
+
+  /* Compute t = A*s1 + s2 and write public and secret keys */
+  for (j = 0; j < 4; j++)
+  __loop__(invariant(j <= 4))
+  {
+    uint8_t *pk = pks + j * CRYPTO_PUBLICKEYBYTES;
+    uint8_t *sk = sks + j * CRYPTO_SECRETKEYBYTES;
+    const uint8_t *rho = seedbuf[j];
+    const uint8_t *key = seedbuf[j] + MLDSA_SEEDBYTES + MLDSA_CRHBYTES;
+
+    /* Constant time: rho is part of the public key and, hence, public. */
+    MLD_CT_TESTING_DECLASSIFY(rho, MLDSA_SEEDBYTES);
+
+    mld_polyvecl_unpack_eta(&ws.s1, s_packed[j]);
+    mld_polyveck_unpack_eta(&ws.s2,
+                            s_packed[j] + MLDSA_L * MLDSA_POLYETA_PACKEDBYTES);
+    mld_sign_matrix_init(mat, rho);
+    ws.s1hat = ws.s1;
+    mld_polyvecl_ntt(&ws.s1hat);
+    mld_compute_t0_t1(&t1, &ws.t0, mat, &ws.s1hat, &ws.s2);
+    mld_pack_pk(pk, rho, &t1);
+
+    /* Constant time: pk is the public key, inherently public data */
+    MLD_CT_TESTING_DECLASSIFY(pk, CRYPTO_PUBLICKEYBYTES);
+
+#if defined(MLD_CONFIG_KEYGEN_PCT)
+    /* The PCT needs tr straight away, so it is computed for this key alone
+     * instead of across the four lanes, and the signing context is filled
+     * from the values still in memory. */
+    memcpy(ws.seedbuf, seedbuf[j], sizeof(ws.seedbuf));
+    shake256(ws.tr, MLDSA_TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+    mld_pack_sk(sk, rho, ws.tr, key, &ws.t0, &ws.s1, &ws.s2);
+    mld_sign_ctx_from_keygen(&sctx, &ws);
+
+    /* Pairwise Consistency Test (PCT) @[FIPS140_3_IG, p.87] */
+    if (mld_check_pct(pk, &sctx))
+    {
+      result = -1;
+    }
+#else  /* MLD_CONFIG_KEYGEN_PCT */
+    mld_pack_sk(sk, rho, tr_placeholder, key, &ws.t0, &ws.s1, &ws.s2);
+    pk_lanes[j] = pk;
+#endif /* !MLD_CONFIG_KEYGEN_PCT */
+  }
+
+#if !defined(MLD_CONFIG_KEYGEN_PCT)
+  /* Compute tr = H(rho, t1) of all four keys */
+  mld_xof256_x4_init(&state);
+  mld_xof256_x4_absorb(&state, pk_lanes, CRYPTO_PUBLICKEYBYTES);
+  mld_xof256_x4_squeezeblocks(seedbuf, 1, &state);
+  mld_xof256_x4_release(&state);
+  for (j = 0; j < 4; j++)
+  __loop__(invariant(j <= 4))
+  {
+    mld_pack_sk_tr(sks + j * CRYPTO_SECRETKEYBYTES, seedbuf[j]);
+  }
+#endif /* !MLD_CONFIG_KEYGEN_PCT */
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(inbuf, sizeof(inbuf));
+  mld_zeroize(seedbuf, sizeof(seedbuf));
+  mld_zeroize(extseed, sizeof(extseed));
+  mld_zeroize(s_packed, sizeof(s_packed));
+  mld_zeroize(s, sizeof(s));
+  mld_zeroize(&t1, sizeof(t1));
+  mld_zeroize(&ws, sizeof(ws));
+#if defined(MLD_CONFIG_KEYGEN_PCT)
+  mld_zeroize(&sctx, sizeof(sctx));
+#else
+  mld_zeroize(&mat_storage, sizeof(mat_storage));
+#endif
+
+  /* Do not hand out key pairs if any of them failed the PCT */
+  if (result != 0)
+  {
+    mld_zeroize(pks, 4 * CRYPTO_PUBLICKEYBYTES);
+    mld_zeroize(sks, 4 * CRYPTO_SECRETKEYBYTES);
+  }
+
+  return result;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_keypair_batch(uint8_t *pks, uint8_t *sks, const uint8_t *seeds,
+                              size_t n)
+{
+  size_t i;
+
+  for (i = 0; i + 4 <= n; i += 4)
+  __loop__(invariant(i <= n))
+  {
+    if (mld_keypair_x4(pks + i * CRYPTO_PUBLICKEYBYTES,
+                       sks + i * CRYPTO_SECRETKEYBYTES,
+                       seeds + i * MLDSA_SEEDBYTES))
+    {
+      goto pct_failure;
+    }
+  }
+
+  /* Remaining key pairs, if n is not a multiple of 4 */
+  for (; i < n; i++)
+  __loop__(invariant(i <= n))
+  {
+    if (crypto_sign_keypair_internal(pks + i * CRYPTO_PUBLICKEYBYTES,
+                                     sks + i * CRYPTO_SECRETKEYBYTES,
+                                     seeds + i * MLDSA_SEEDBYTES))
+    {
+      goto pct_failure;
+    }
+  }
+
+  return 0;
+
+pct_failure:
+  /* Do not hand out any key pair of a batch that failed the PCT */
+  mld_zeroize(pks, n * CRYPTO_PUBLICKEYBYTES);
+  mld_zeroize(sks, n * CRYPTO_SECRETKEYBYTES);
+  return -1;
+}
+
 MLD_MUST_CHECK_RETURN_VALUE
 int crypto_sign_keypair(uint8_t *pk, uint8_t *sk)
 {
@@ -208,6 +796,21 @@ int crypto_sign_keypair(uint8_t *pk, uint8_t *sk)
   return result;
 }
 
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_keypair_ctx(uint8_t *pk, uint8_t *sk, mld_sign_ctx *sctx)
+{
+  uint8_t seed[MLDSA_SEEDBYTES];
+  int result;
+  mld_randombytes(seed, MLDSA_SEEDBYTES);
+  MLD_CT_TESTING_SECRET(seed, sizeof(seed));
+  MLD_PROFILE(MLD_PROFILE_KEYPAIR,
+              result = mld_keypair_core(pk, sk, seed, sctx));
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(seed, sizeof(seed));
+  return result;
+}
+
 /*************************************************
  * Name:        mld_H
  *
@@ -260,16 +863,144 @@ __contract__(
   mld_zeroize(&state, sizeof(state));
 }
 
-/* Reference: The reference implementation does not explicitly   */
-/* check the maximum nonce value, but instead loops indefinitely */
-/* (even when the nonce would overflow). Internally,             */
-/* sampling of y uses (nonceL), (nonceL+1), ... (nonce*L+L-1).   */
-/* Hence, there are no overflows if nonce < (UINT16_MAX - L)/L.  */
-/* Explicitly checking for this explicitly allows us to prove    */
-/* type-safety. Note that FIPS204 explicitly allows an upper-    */
-/* bound this loop of 814 (< (UINT16_MAX - L)/L) - see           */
-/* Appendix C of FIPS204.                                        */
-#define NONCE_UB ((UINT16_MAX - MLDSA_L) / MLDSA_L)
+/* Secret intermediate values of a single signing attempt.
+ *
+ * They are grouped into one object that is owned by the caller of
+ * mld_attempt_signature_generation(), so that rejected attempts merely
+ * overwrite it and a single mld_zeroize() at the end of the signing
+ * operation destroys all of them. */
+typedef struct mld_sign_attempt_ws
+{
+#if defined(MLD_CONFIG_REDUCE_RAM)
+  /* y is kept bit-packed, and z is bit-packed straight into the signature.
+   * The NTT of y shares storage with w0, and w1 with h. MLDSA_K >= MLDSA_L
+   * for all parameter sets. */
+  union
+  {
+    mld_polyvecl yhat;
+    mld_polyveck w0;
+  } yhat_w0;
+  mld_polyveck w2, h;
+#else
+  mld_polyvecl y, z;
+  mld_polyveck w2, w1, w0, h;
+#endif
+  mld_poly cp;
+#if defined(MLD_CONFIG_REDUCE_RAM)
+  uint8_t y_packed[MLDSA_L * MLDSA_POLYZ_PACKEDBYTES];
+#endif
+  uint8_t challenge_bytes[MLDSA_CTILDEBYTES];
+} MLD_ALIGN mld_sign_attempt_ws;
+
+#if defined(MLD_CONFIG_REDUCE_RAM)
+/* Size and offset of the packed z in a signature */
+#define MLD_SIG_Z_BYTES (MLDSA_L * MLDSA_POLYZ_PACKEDBYTES)
+#define MLD_SIG_Z_OFFSET MLDSA_CTILDEBYTES
+
+/* z of a rejected attempt must not be released: wipe the rows that were
+ * already packed into the signature. */
+#define MLD_SIGN_REJECT_WIPE_Z(sig) \
+  mld_zeroize((sig) + MLD_SIG_Z_OFFSET, MLD_SIG_Z_BYTES)
+
+/* Bound on the challenge passed to mld_compute_z_packed() */
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+#define MLD_SIGN_CHALLENGE_BOUND(c) array_bound((c)->coeffs, 0, MLDSA_N, -1, 2)
+#else
+#define MLD_SIGN_CHALLENGE_BOUND(c) \
+  array_abs_bound((c)->coeffs, 0, MLDSA_N, MLD_NTT_BOUND)
+#endif
+
+/*************************************************
+ * Name:        mld_compute_z_packed
+ *
+ * Description: Compute z = y + c*s1 one polynomial at a time, check its
+ *              norm, and bit-pack it directly into the signature, so that
+ *              z is never held unpacked as a whole.
+ *
+ * Arguments:   - uint8_t *sig: pointer to output signature; only the bytes
+ *                              holding z are written
+ *              - const mld_poly *cp: challenge polynomial, in NTT domain
+ *                                    unless MLD_CONFIG_SMALL_SECRETS is set
+ *              - const mld_polyvecl_secret *s1: secret vector s1
+ *              - const uint8_t *y_packed: y, bit-packed by
+ *                                         mld_polyvecl_pack_z()
+ *              - mld_poly *zi, *yi: scratch polynomials
+ *
+ * Returns 0 if z passes the norm check, -1 if rejected. On rejection, some
+ * rows of z may have been written to sig; see MLD_SIGN_REJECT_WIPE_Z().
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+static int mld_compute_z_packed(uint8_t *sig, const mld_poly *cp,
+                                const mld_polyvecl_secret *s1,
+                                const uint8_t y_packed[MLD_SIG_Z_BYTES],
+                                mld_poly *zi, mld_poly *yi)
+__contract__(
+  requires(memory_no_alias(sig, CRYPTO_BYTES))
+  requires(memory_no_alias(cp, sizeof(mld_poly)))
+  requires(memory_no_alias(s1, sizeof(mld_polyvecl_secret)))
+  requires(memory_no_alias(y_packed, MLD_SIG_Z_BYTES))
+  requires(memory_no_alias(zi, sizeof(mld_poly)))
+  requires(memory_no_alias(yi, sizeof(mld_poly)))
+  requires(MLD_SIGN_CHALLENGE_BOUND(cp))
+  requires(forall(k3, 0, MLDSA_L, array_bound(s1->vec[k3].coeffs, 0, MLDSA_N, MLD_SECRET_LOWER_BOUND, MLD_SECRET_UPPER_BOUND)))
+  assigns(memory_slice(sig, CRYPTO_BYTES))
+  assigns(memory_slice(zi, sizeof(mld_poly)))
+  assigns(memory_slice(yi, sizeof(mld_poly)))
+  ensures(return_value == 0 || return_value == -1)
+)
+{
+  unsigned int i;
+  uint32_t z_invalid;
+
+  for (i = 0; i < MLDSA_L; i++)
+  __loop__(
+    assigns(i, z_invalid, memory_slice(sig, CRYPTO_BYTES),
+            memory_slice(zi, sizeof(mld_poly)),
+            memory_slice(yi, sizeof(mld_poly)))
+    invariant(i <= MLDSA_L)
+  )
+  {
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+    mld_poly_challenge_mul_small(zi, cp, &s1->vec[i]);
+#else
+    mld_poly_pointwise_montgomery(zi, cp, &s1->vec[i]);
+    mld_poly_invntt_tomont(zi);
+#endif
+    mld_polyz_unpack(yi, y_packed + i * MLDSA_POLYZ_PACKEDBYTES);
+    mld_poly_add(zi, yi);
+#if !defined(MLD_CONFIG_SMALL_SECRETS)
+    mld_poly_reduce(zi);
+#endif
+
+    z_invalid = mld_poly_chknorm(zi, MLDSA_GAMMA1 - MLDSA_BETA);
+    /* Constant time: z_invalid may be leaked, and so may the polynomial of z
+     * that led to rejection. See Section 5.5 of @[Round3_Spec]. */
+    MLD_CT_TESTING_DECLASSIFY(&z_invalid, sizeof(uint32_t));
+    if (z_invalid)
+    {
+      return -1; /* reject */
+    }
+
+    mld_polyz_pack(sig + MLD_SIG_Z_OFFSET + i * MLDSA_POLYZ_PACKEDBYTES, zi);
+  }
+
+  return 0;
+}
+#else /* MLD_CONFIG_REDUCE_RAM */
+#define MLD_SIGN_REJECT_WIPE_Z(sig) \
+  do                                \
+  {                                 \
+  } while (0)
+#endif /* !MLD_CONFIG_REDUCE_RAM */
+
+/* Secret workspace of a full signing operation, on top of the signing
+ * context. It is covered by a single wipe. */
+typedef struct
+{
+  mld_sign_attempt_ws attempt;
+  uint8_t mu[MLDSA_CRHBYTES];
+  uint8_t rhoprime[MLDSA_CRHBYTES];
+} MLD_ALIGN mld_sign_ws;
 
 /*************************************************
  * Name:        attempt_signature_generation
@@ -281,10 +1012,13 @@ __contract__(
  *                                   of exactly MLDSA_CRHBYTES bytes
  *              - const uint8_t *rhoprime: pointer to randomness seed
  *              - uint16_t nonce: current nonce value
- *              - const polyvecl mat[MLDSA_K]: expanded matrix
- *              - const polyvecl *s1: secret vector s1
- *              - const polyveck *s2: secret vector s2
+ *              - const mld_sign_matrix *mat: matrix A
+ *              - const mld_polyvecl_secret *s1: secret vector s1
+ *              - const mld_polyveck_secret *s2: secret vector s2
  *              - const polyveck *t0: vector t0
+ *              - mld_sign_attempt_ws *ws: workspace for intermediate
+ *                                         values. It is left populated
+ *                                         and must be wiped by the caller.
  *
  * Returns 0 if signature generation succeeds, -1 if rejected
  *
@@ -296,139 +1030,182 @@ __contract__(
 MLD_MUST_CHECK_RETURN_VALUE
 static int mld_attempt_signature_generation(
     uint8_t *sig, const uint8_t *mu, const uint8_t rhoprime[MLDSA_CRHBYTES],
-    uint16_t nonce, const mld_polyvecl mat[MLDSA_K], const mld_polyvecl *s1,
-    const mld_polyveck *s2, const mld_polyveck *t0)
+    uint16_t nonce, const mld_sign_matrix *mat,
+    const mld_polyvecl_secret *s1, const mld_polyveck_secret *s2,
+    const mld_polyveck *t0, mld_sign_attempt_ws *ws)
 __contract__(
   requires(memory_no_alias(sig, CRYPTO_BYTES))
   requires(memory_no_alias(mu, MLDSA_CRHBYTES))
   requires(memory_no_alias(rhoprime, MLDSA_CRHBYTES))
-  requires(memory_no_alias(mat, MLDSA_K * sizeof(mld_polyvecl)))
-  requires(memory_no_alias(s1, sizeof(mld_polyvecl)))
-  requires(memory_no_alias(s2, sizeof(mld_polyveck)))
+  requires(memory_no_alias(mat, sizeof(mld_sign_matrix)))
+  requires(memory_no_alias(s1, sizeof(mld_polyvecl_secret)))
+  requires(memory_no_alias(s2, sizeof(mld_polyveck_secret)))
   requires(memory_no_alias(t0, sizeof(mld_polyveck)))
+  requires(memory_no_alias(ws, sizeof(mld_sign_attempt_ws)))
   requires(nonce <= NONCE_UB)
-  requires(forall(k1, 0, MLDSA_K, forall(l1, 0, MLDSA_L,
-                                         array_bound(mat[k1].vec[l1].coeffs, 0, MLDSA_N, 0, MLDSA_Q))))
+  requires(MLD_SIGN_MATRIX_BOUND(mat))
   requires(forall(k2, 0, MLDSA_K, array_abs_bound(t0->vec[k2].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
-  requires(forall(k3, 0, MLDSA_L, array_abs_bound(s1->vec[k3].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
-  requires(forall(k4, 0, MLDSA_K, array_abs_bound(s2->vec[k4].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
+  requires(forall(k3, 0, MLDSA_L, array_bound(s1->vec[k3].coeffs, 0, MLDSA_N, MLD_SECRET_LOWER_BOUND, MLD_SECRET_UPPER_BOUND)))
+  requires(forall(k4, 0, MLDSA_K, array_bound(s2->vec[k4].coeffs, 0, MLDSA_N, MLD_SECRET_LOWER_BOUND, MLD_SECRET_UPPER_BOUND)))
   assigns(memory_slice(sig, CRYPTO_BYTES))
+  assigns(memory_slice(ws, sizeof(mld_sign_attempt_ws)))
   ensures(return_value == 0 || return_value == -1)
 )
 {
-  uint8_t challenge_bytes[MLDSA_CTILDEBYTES];
   unsigned int n;
-  mld_polyvecl y, z;
-  mld_polyveck w2, w1, w0, h;
-  mld_poly cp;
   uint32_t z_invalid, w0_invalid, h_invalid;
+  mld_polyveck *w2 = &ws->w2, *h = &ws->h;
+  mld_poly *cp = &ws->cp;
+#if defined(MLD_CONFIG_REDUCE_RAM)
+  /* The NTT of y is dead once w1 is computed, before w0 is first written,
+   * and w1 is dead once decomposed, before h is first written */
+  mld_polyvecl *yhat = &ws->yhat_w0.yhat;
+  mld_polyveck *w0 = &ws->yhat_w0.w0;
+  mld_polyveck *w1 = &ws->h;
+
+  /* Sample intermediate vector y, and keep it only in packed form */
+  MLD_PROFILE_BEGIN(MLD_PROFILE_SAMPLE_Y);
+  mld_polyvecl_uniform_gamma1(yhat, rhoprime, nonce);
+  mld_polyvecl_pack_z(ws->y_packed, yhat);
+  MLD_PROFILE_END(MLD_PROFILE_SAMPLE_Y);
+#else
+  mld_polyvecl *z = &ws->z, *yhat = &ws->z;
+  mld_polyvecl *y = &ws->y;
+  mld_polyveck *w1 = &ws->w1, *w0 = &ws->w0;
 
   /* Sample intermediate vector y */
-  mld_polyvecl_uniform_gamma1(&y, rhoprime, nonce);
+  MLD_PROFILE(MLD_PROFILE_SAMPLE_Y,
+              mld_polyvecl_uniform_gamma1(y, rhoprime, nonce));
+  *z = *y;
+#endif /* !MLD_CONFIG_REDUCE_RAM */
 
   /* Matrix-vector multiplication */
-  z = y;
-  mld_polyvecl_ntt(&z);
-  mld_polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
-  mld_polyveck_reduce(&w1);
-  mld_polyveck_invntt_tomont(&w1);
+  MLD_PROFILE_BEGIN(MLD_PROFILE_NTT);
+  mld_polyvecl_ntt(yhat);
+  mld_sign_matrix_mul(w1, mat, yhat);
+  mld_polyveck_reduce(w1);
+  mld_polyveck_invntt_tomont(w1);
+  MLD_PROFILE_END(MLD_PROFILE_NTT);
 
   /* Decompose w and call the random oracle */
-  mld_polyveck_caddq(&w1);
-  mld_polyveck_decompose(&w2, &w0, &w1);
-  mld_polyveck_pack_w1(sig, &w2);
-
-  mld_H(challenge_bytes, MLDSA_CTILDEBYTES, mu, MLDSA_CRHBYTES, sig,
-        MLDSA_K * MLDSA_POLYW1_PACKEDBYTES, NULL, 0);
+  MLD_PROFILE_BEGIN(MLD_PROFILE_ROUNDING);
+  mld_polyveck_caddq(w1);
+  mld_polyveck_decompose(w2, w0, w1);
+  MLD_PROFILE_END(MLD_PROFILE_ROUNDING);
+  MLD_PROFILE(MLD_PROFILE_PACK, mld_polyveck_pack_w1(sig, w2));
+
+  MLD_PROFILE(MLD_PROFILE_HASH,
+              mld_H(ws->challenge_bytes, MLDSA_CTILDEBYTES, mu, MLDSA_CRHBYTES,
+                    sig, MLDSA_K * MLDSA_POLYW1_PACKEDBYTES, NULL, 0));
   /* Constant time: Leaking challenge_bytes does not reveal any information
    * about the secret key as H() is modelled as random oracle.
    * This also applies to challenges for rejected signatures.
    * See Section 5.5 of @[Round3_Spec]. */
-  MLD_CT_TESTING_DECLASSIFY(challenge_bytes, sizeof(challenge_bytes));
-  mld_poly_challenge(&cp, challenge_bytes);
-  mld_poly_ntt(&cp);
+  MLD_CT_TESTING_DECLASSIFY(ws->challenge_bytes, MLDSA_CTILDEBYTES);
+  MLD_PROFILE(MLD_PROFILE_SAMPLE_CHALLENGE,
+              mld_poly_challenge(cp, ws->challenge_bytes));
 
   /* Compute z, reject if it reveals secret */
-  mld_polyvecl_pointwise_poly_montgomery(&z, &cp, s1);
-  mld_polyvecl_invntt_tomont(&z);
-  mld_polyvecl_add(&z, &y);
-  mld_polyvecl_reduce(&z);
+  MLD_PROFILE_BEGIN(MLD_PROFILE_NTT);
+#if !defined(MLD_CONFIG_SMALL_SECRETS)
+  mld_poly_ntt(cp);
+#endif
+#if defined(MLD_CONFIG_REDUCE_RAM)
+  /* z overwrites the packed w1 in sig, which is no longer needed. h is
+   * free until c*s2 is computed below and provides the scratch space.
+   * The norm check of z is done row by row, and its result declassified,
+   * in mld_compute_z_packed(). */
+  z_invalid = (uint32_t)mld_compute_z_packed(sig, cp, s1, ws->y_packed,
+                                             &h->vec[0], &h->vec[1]);
+#else /* MLD_CONFIG_REDUCE_RAM */
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+  mld_polyvecl_challenge_mul_small(z, cp, s1);
+#else
+  mld_polyvecl_pointwise_poly_montgomery(z, cp, s1);
+  mld_polyvecl_invntt_tomont(z);
+#endif
+  mld_polyvecl_add(z, y);
+#if !defined(MLD_CONFIG_SMALL_SECRETS)
+  /* With MLD_CONFIG_SMALL_SECRETS, cs1 is computed exactly from the sparse
+   * challenge, so z = y + cs1 needs no reduction. */
+  mld_polyvecl_reduce(z);
+#endif
+#endif /* !MLD_CONFIG_REDUCE_RAM */
+  MLD_PROFILE_END(MLD_PROFILE_NTT);
 
-  z_invalid = mld_polyvecl_chknorm(&z, MLDSA_GAMMA1 - MLDSA_BETA);
+#if !defined(MLD_CONFIG_REDUCE_RAM)
+  MLD_PROFILE(MLD_PROFILE_ROUNDING,
+              z_invalid = mld_polyvecl_chknorm(z, MLDSA_GAMMA1 - MLDSA_BETA));
   /* Constant time: It is fine (and prohibitively expensive to avoid)
    * leaking the result of the norm check. In case of rejection it
    * would even be okay to leak which coefficient led to rejection
    * as the candidate signature will be discarded anyway.
    * See Section 5.5 of @[Round3_Spec]. */
   MLD_CT_TESTING_DECLASSIFY(&z_invalid, sizeof(uint32_t));
+#endif
   if (z_invalid)
   {
-    /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
-    mld_zeroize(challenge_bytes, MLDSA_CTILDEBYTES);
-    mld_zeroize(&y, sizeof(y));
-    mld_zeroize(&z, sizeof(z));
-    mld_zeroize(&w2, sizeof(w2));
-    mld_zeroize(&w1, sizeof(w1));
-    mld_zeroize(&w0, sizeof(w0));
-    mld_zeroize(&h, sizeof(h));
-    mld_zeroize(&cp, sizeof(cp));
+    MLD_SIGN_REJECT_WIPE_Z(sig);
+    MLD_STATS_REJECT(MLD_STATS_REJECT_Z);
     return -1; /* reject */
   }
 
+#if !defined(MLD_CONFIG_REDUCE_RAM)
   /* If z is valid, then its coefficients are bounded by  */
   /* MLDSA_GAMMA1 - MLDSA_BETA. This will be needed below */
   /* to prove the pre-condition of pack_sig()             */
   cassert(forall(k1, 0, MLDSA_L,
-                 array_abs_bound(z.vec[k1].coeffs, 0, MLDSA_N,
+                 array_abs_bound(z->vec[k1].coeffs, 0, MLDSA_N,
                                  (MLDSA_GAMMA1 - MLDSA_BETA))));
+#endif /* !MLD_CONFIG_REDUCE_RAM */
 
   /* Check that subtracting cs2 does not change high bits of w and low bits
    * do not reveal secret information */
-  mld_polyveck_pointwise_poly_montgomery(&h, &cp, s2);
-  mld_polyveck_invntt_tomont(&h);
-  mld_polyveck_sub(&w0, &h);
-  mld_polyveck_reduce(&w0);
+  MLD_PROFILE_BEGIN(MLD_PROFILE_NTT);
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+  mld_polyveck_challenge_mul_small(h, cp, s2);
+#else
+  mld_polyveck_pointwise_poly_montgomery(h, cp, s2);
+  mld_polyveck_invntt_tomont(h);
+#endif
+  mld_polyveck_sub(w0, h);
+  mld_polyveck_reduce(w0);
+  MLD_PROFILE_END(MLD_PROFILE_NTT);
 
-  w0_invalid = mld_polyveck_chknorm(&w0, MLDSA_GAMMA2 - MLDSA_BETA);
+  MLD_PROFILE(MLD_PROFILE_ROUNDING,
+              w0_invalid = mld_polyveck_chknorm(w0, MLDSA_GAMMA2 - MLDSA_BETA));
   /* Constant time: w0_invalid may be leaked - see comment for z_invalid. */
   MLD_CT_TESTING_DECLASSIFY(&w0_invalid, sizeof(uint32_t));
   if (w0_invalid)
   {
-    /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
-    mld_zeroize(challenge_bytes, sizeof(challenge_bytes));
-    mld_zeroize(&y, sizeof(y));
-    mld_zeroize(&z, sizeof(z));
-    mld_zeroize(&w2, sizeof(w2));
-    mld_zeroize(&w1, sizeof(w1));
-    mld_zeroize(&w0, sizeof(w0));
-    mld_zeroize(&h, sizeof(h));
-    mld_zeroize(&cp, sizeof(cp));
+    MLD_SIGN_REJECT_WIPE_Z(sig);
+    MLD_STATS_REJECT(MLD_STATS_REJECT_W0);
     return -1; /* reject */
   }
 
   /* Compute hints for w1 */
-  mld_polyveck_pointwise_poly_montgomery(&h, &cp, t0);
-  mld_polyveck_invntt_tomont(&h);
-  mld_polyveck_reduce(&h);
+  MLD_PROFILE_BEGIN(MLD_PROFILE_NTT);
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+  /* t0 is kept in NTT domain */
+  mld_poly_ntt(cp);
+#endif
+  mld_polyveck_pointwise_poly_montgomery(h, cp, t0);
+  mld_polyveck_invntt_tomont(h);
+  mld_polyveck_reduce(h);
+  MLD_PROFILE_END(MLD_PROFILE_NTT);
 
-  h_invalid = mld_polyveck_chknorm(&h, MLDSA_GAMMA2);
+  MLD_PROFILE(MLD_PROFILE_ROUNDING,
+              h_invalid = mld_polyveck_chknorm(h, MLDSA_GAMMA2));
   /* Constant time: h_invalid may be leaked - see comment for z_invalid. */
   MLD_CT_TESTING_DECLASSIFY(&h_invalid, sizeof(uint32_t));
   if (h_invalid)
   {
-    /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
-    mld_zeroize(challenge_bytes, MLDSA_CTILDEBYTES);
-    mld_zeroize(&y, sizeof(y));
-    mld_zeroize(&z, sizeof(z));
-    mld_zeroize(&w2, sizeof(w2));
-    mld_zeroize(&w1, sizeof(w1));
-    mld_zeroize(&w0, sizeof(w0));
-    mld_zeroize(&h, sizeof(h));
-    mld_zeroize(&cp, sizeof(cp));
+    MLD_SIGN_REJECT_WIPE_Z(sig);
+    MLD_STATS_REJECT(MLD_STATS_REJECT_H);
     return -1; /* reject */
   }
 
-  mld_polyveck_add(&w0, &h);
+  mld_polyveck_add(w0, h);
 
   /* Constant time: At this point all norm checks have passed and we, hence,
    * know that the signature does not leak any secret information.
@@ -438,106 +1215,97 @@ __contract__(
    * h=c*t0 is public as both c and t0 are public.
    * For a more detailed discussion, refer to https://eprint.iacr.org/2022/1406.
    */
-  MLD_CT_TESTING_DECLASSIFY(&w0, sizeof(w0));
-  MLD_CT_TESTING_DECLASSIFY(&w2, sizeof(w2));
-  n = mld_polyveck_make_hint(&h, &w0, &w2);
+  MLD_CT_TESTING_DECLASSIFY(w0, sizeof(mld_polyveck));
+  MLD_CT_TESTING_DECLASSIFY(w2, sizeof(mld_polyveck));
+  MLD_PROFILE(MLD_PROFILE_ROUNDING, n = mld_polyveck_make_hint(h, w0, w2));
   if (n > MLDSA_OMEGA)
   {
-    /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
-    mld_zeroize(challenge_bytes, MLDSA_CTILDEBYTES);
-    mld_zeroize(&y, sizeof(y));
-    mld_zeroize(&z, sizeof(z));
-    mld_zeroize(&w2, sizeof(w2));
-    mld_zeroize(&w1, sizeof(w1));
-    mld_zeroize(&w0, sizeof(w0));
-    mld_zeroize(&h, sizeof(h));
-    mld_zeroize(&cp, sizeof(cp));
+    MLD_SIGN_REJECT_WIPE_Z(sig);
+    MLD_STATS_REJECT(MLD_STATS_REJECT_HINT);
     return -1; /* reject */
   }
 
   /* All is well - write signature */
   /* Constant time: At this point it is clear that the signature is valid - it
    * can, hence, be considered public. */
-  MLD_CT_TESTING_DECLASSIFY(&h, sizeof(h));
-  MLD_CT_TESTING_DECLASSIFY(&z, sizeof(z));
-  mld_pack_sig(sig, challenge_bytes, &z, &h, n);
-
-  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
-  mld_zeroize(challenge_bytes, MLDSA_CTILDEBYTES);
-  mld_zeroize(&y, sizeof(y));
-  mld_zeroize(&z, sizeof(z));
-  mld_zeroize(&w2, sizeof(w2));
-  mld_zeroize(&w1, sizeof(w1));
-  mld_zeroize(&w0, sizeof(w0));
-  mld_zeroize(&h, sizeof(h));
-  mld_zeroize(&cp, sizeof(cp));
+  MLD_CT_TESTING_DECLASSIFY(h, sizeof(mld_polyveck));
+  MLD_PROFILE_BEGIN(MLD_PROFILE_PACK);
+#if defined(MLD_CONFIG_REDUCE_RAM)
+  MLD_CT_TESTING_DECLASSIFY(sig + MLD_SIG_Z_OFFSET, MLD_SIG_Z_BYTES);
+  mld_pack_sig_c_h(sig, ws->challenge_bytes, h, n);
+#else
+  MLD_CT_TESTING_DECLASSIFY(z, sizeof(mld_polyvecl));
+  mld_pack_sig(sig, ws->challenge_bytes, z, h, n);
+#endif
+  MLD_PROFILE_END(MLD_PROFILE_PACK);
 
   return 0; /* success */
 }
+/*************************************************
+ * Name:        mld_sign_core
+ *
+ * Description: Shared implementation of crypto_sign_signature_internal() and
+ *              crypto_sign_signature_ctx(), signing with a signing context.
+ *
+ * Arguments:   - const mld_sign_ctx *sctx: pointer to signing context
+ *              - all other arguments as for crypto_sign_signature_internal()
+ *
+ * Returns 0 (success) or -1 (indicating nonce exhaustion)
+ **************************************************/
 MLD_MUST_CHECK_RETURN_VALUE
-int crypto_sign_signature_internal(uint8_t *sig, size_t *siglen,
-                                   const uint8_t *m, size_t mlen,
-                                   const uint8_t *pre, size_t prelen,
-                                   const uint8_t rnd[MLDSA_RNDBYTES],
-                                   const uint8_t *sk, int externalmu)
+static int mld_sign_core(uint8_t *sig, size_t *siglen, const uint8_t *m,
+                         size_t mlen, const uint8_t *pre, size_t prelen,
+                         const uint8_t rnd[MLDSA_RNDBYTES],
+                         const mld_sign_ctx *sctx, int externalmu)
+__contract__(
+  requires(memory_no_alias(sig, CRYPTO_BYTES))
+  requires(memory_no_alias(siglen, sizeof(size_t)))
+  requires(memory_no_alias(m, mlen))
+  requires(memory_no_alias(rnd, MLDSA_RNDBYTES))
+  requires(memory_no_alias(sctx, sizeof(mld_sign_ctx)))
+  requires(MLD_SIGN_CTX_BOUND(sctx))
+  requires(sctx->mu_state.pos <= SHAKE256_RATE)
+  requires((externalmu == 0 && pre != NULL && prelen >= 2 && memory_no_alias(pre, prelen)) ||
+           (externalmu == 1 && mlen == MLDSA_CRHBYTES))
+  assigns(memory_slice(sig, CRYPTO_BYTES))
+  assigns(object_whole(siglen))
+  ensures((return_value == 0 && *siglen == CRYPTO_BYTES) ||
+          (return_value == -1 && *siglen == 0))
+)
 {
-  uint8_t seedbuf[2 * MLDSA_SEEDBYTES + MLDSA_TRBYTES + 2 * MLDSA_CRHBYTES];
-  uint8_t *rho, *tr, *key, *mu, *rhoprime;
-  mld_polyvecl mat[MLDSA_K], s1;
-  mld_polyveck t0, s2;
+  mld_sign_ws ws;
+  int result;
 
   uint16_t nonce = 0;
 
-  rho = seedbuf;
-  tr = rho + MLDSA_SEEDBYTES;
-  key = tr + MLDSA_TRBYTES;
-  mu = key + MLDSA_SEEDBYTES;
-  rhoprime = mu + MLDSA_CRHBYTES;
-  mld_unpack_sk(rho, tr, key, &t0, &s1, &s2, sk);
-
+  MLD_PROFILE_BEGIN(MLD_PROFILE_HASH);
   if (!externalmu)
   {
     /* Compute mu = CRH(tr, pre, msg) */
-    mld_H(mu, MLDSA_CRHBYTES, tr, MLDSA_TRBYTES, pre, prelen, m, mlen);
+    mld_mu_from_midstate(ws.mu, &sctx->mu_state, pre, prelen, m, mlen);
   }
   else
   {
     /* mu has been provided directly */
-    memcpy(mu, m, MLDSA_CRHBYTES);
+    memcpy(ws.mu, m, MLDSA_CRHBYTES);
   }
 
   /* Compute rhoprime = CRH(key, rnd, mu) */
-  mld_H(rhoprime, MLDSA_CRHBYTES, key, MLDSA_SEEDBYTES, rnd, MLDSA_RNDBYTES, mu,
-        MLDSA_CRHBYTES);
-
-  /* Constant time: rho is part of the public key and, hence, public. */
-  MLD_CT_TESTING_DECLASSIFY(rho, MLDSA_SEEDBYTES);
-  /* Expand matrix and transform vectors */
-  mld_polyvec_matrix_expand(mat, rho);
-  mld_polyvecl_ntt(&s1);
-  mld_polyveck_ntt(&s2);
-  mld_polyveck_ntt(&t0);
+  mld_H(ws.rhoprime, MLDSA_CRHBYTES, sctx->key, MLDSA_SEEDBYTES, rnd,
+        MLDSA_RNDBYTES, ws.mu, MLDSA_CRHBYTES);
+  MLD_PROFILE_END(MLD_PROFILE_HASH);
 
   /* Reference: This code is re-structured using a while(1),  */
-  /* with explicit "continue" statements (rather than "goto") */
-  /* to implement rejection of invalid signatures.            */
+  /* with explicit "break" statements (rather than "goto")    */
+  /* to leave the rejection loop, so that all exits share the */
+  /* single wipe of the workspace below.                      */
   while (1)
   __loop__(
-    assigns(nonce, object_whole(siglen), memory_slice(sig, CRYPTO_BYTES))
+    assigns(nonce, result, object_whole(siglen), memory_slice(sig, CRYPTO_BYTES),
+            memory_slice(&ws.attempt, sizeof(mld_sign_attempt_ws)))
     invariant(nonce <= NONCE_UB)
-
-    /* t0, s1, s2, and mat are initialized above and are NOT changed by this */
-    /* loop. We can therefore re-assert their bounds here as part of the     */
-    /* loop invariant. This makes proof noticeably faster with CBMC          */
-    invariant(forall(k1, 0, MLDSA_K, forall(l1, 0, MLDSA_L,
-              array_bound(mat[k1].vec[l1].coeffs, 0, MLDSA_N, 0, MLDSA_Q))))
-    invariant(forall(k2, 0, MLDSA_K, array_abs_bound(t0.vec[k2].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
-    invariant(forall(k3, 0, MLDSA_L, array_abs_bound(s1.vec[k3].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
-    invariant(forall(k4, 0, MLDSA_K, array_abs_bound(s2.vec[k4].coeffs, 0, MLDSA_N, MLD_NTT_BOUND)))
   )
   {
-    int result;
-
     /* Reference: this code explicitly checks for exhaustion of nonce     */
     /* values to provide predictable termination and results in that case */
     /* Checking here also means that incrementing nonce below can also    */
@@ -548,56 +1316,194 @@ int crypto_sign_signature_internal(uint8_t *sig, size_t *siglen,
       /* *siglen in case of error.                                        */
       *siglen = 0;
       memset(sig, 0, CRYPTO_BYTES);
-      return -1;
+      result = -1;
+      break;
     }
 
-    result = mld_attempt_signature_generation(sig, mu, rhoprime, nonce, mat,
-                                              &s1, &s2, &t0);
+    MLD_PROFILE(MLD_PROFILE_ATTEMPT,
+                result = mld_attempt_signature_generation(
+                    sig, ws.mu, ws.rhoprime, nonce, &sctx->mat, &sctx->s1,
+                    &sctx->s2, &sctx->t0, &ws.attempt));
     nonce++;
     if (result == 0)
     {
+      MLD_STATS_SIGNATURE(nonce);
       *siglen = CRYPTO_BYTES;
-      /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
-      mld_zeroize(seedbuf, sizeof(seedbuf));
-      mld_zeroize(mat, sizeof(mat));
-      mld_zeroize(&s1, sizeof(s1));
-      mld_zeroize(&s2, sizeof(s2));
-      mld_zeroize(&t0, sizeof(t0));
-      return 0;
+      break;
     }
   }
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&ws, sizeof(ws));
+  return result;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_signature_internal(uint8_t *sig, size_t *siglen,
+                                   const uint8_t *m, size_t mlen,
+                                   const uint8_t *pre, size_t prelen,
+                                   const uint8_t rnd[MLDSA_RNDBYTES],
+                                   const uint8_t *sk, int externalmu)
+{
+  mld_sign_ctx sctx;
+  int result;
+
+  MLD_PROFILE_BEGIN(MLD_PROFILE_SIGN);
+  mld_sign_ctx_init(&sctx, sk);
+  result =
+      mld_sign_core(sig, siglen, m, mlen, pre, prelen, rnd, &sctx, externalmu);
+  MLD_PROFILE_END(MLD_PROFILE_SIGN);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(&sctx, sizeof(sctx));
+  return result;
+}
+
+/*************************************************
+ * Name:        mld_prepare_pre
+ *
+ * Description: Prepares the domain separation prefix pre = (0, ctxlen, ctx)
+ *              of the pure ML-DSA API, see FIPS 204, Algorithm 2, line 10
+ *              and Algorithm 3, line 5.
+ *
+ * Arguments:   - uint8_t *pre: output prefix of 2 + ctxlen bytes
+ *              - const uint8_t *ctx: context string
+ *              - size_t ctxlen: length of ctx, at most 255
+ **************************************************/
+static void mld_prepare_pre(uint8_t pre[257], const uint8_t *ctx,
+                            size_t ctxlen)
+__contract__(
+  requires(ctxlen <= 255)
+  requires(memory_no_alias(pre, 257))
+  requires((ctx == NULL && ctxlen == 0) || memory_no_alias(ctx, ctxlen))
+  assigns(memory_slice(pre, 257))
+)
+{
+  size_t i;
+  pre[0] = 0;
+  pre[1] = (uint8_t)ctxlen;
+  for (i = 0; i < ctxlen; i++)
+  __loop__(
+    assigns(i, memory_slice(pre, 257))
+    invariant(i <= ctxlen)
+  )
+  {
+    pre[2 + i] = ctx[i];
+  }
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_signature(uint8_t *sig, size_t *siglen, const uint8_t *m,
+                          size_t mlen, const uint8_t *ctx, size_t ctxlen,
+                          const uint8_t *sk)
+{
+  uint8_t pre[257];
+  uint8_t rnd[MLDSA_RNDBYTES];
+  int result;
+
+  if (ctxlen > 255)
+  {
+    /* To be on the safe-side, make sure *siglen has a well-defined */
+    /* value, even in the case of error.                            */
+    *siglen = 0;
+    return -1;
+  }
+
+  mld_prepare_pre(pre, ctx, ctxlen);
+
+#ifdef MLD_RANDOMIZED_SIGNING
+  mld_randombytes(rnd, MLDSA_RNDBYTES);
+  MLD_CT_TESTING_SECRET(rnd, sizeof(rnd));
+#else
+  memset(rnd, 0, MLDSA_RNDBYTES);
+#endif
+
+
+  result = crypto_sign_signature_internal(sig, siglen, m, mlen, pre, 2 + ctxlen,
+                                          rnd, sk, 0);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(pre, sizeof(pre));
+  mld_zeroize(rnd, sizeof(rnd));
+
+  return result;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_signature_extmu(uint8_t *sig, size_t *siglen,
+                                const uint8_t mu[MLDSA_CRHBYTES],
+                                const uint8_t *sk)
+{
+  uint8_t rnd[MLDSA_RNDBYTES];
+  int result;
+
+#ifdef MLD_RANDOMIZED_SIGNING
+  mld_randombytes(rnd, MLDSA_RNDBYTES);
+  MLD_CT_TESTING_SECRET(rnd, sizeof(rnd));
+#else
+  memset(rnd, 0, MLDSA_RNDBYTES);
+#endif
+
+  result = crypto_sign_signature_internal(sig, siglen, mu, MLDSA_CRHBYTES, NULL,
+                                          0, rnd, sk, 1);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(rnd, sizeof(rnd));
+
+  return result;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_signature_ctx(uint8_t *sig, size_t *siglen, const uint8_t *m,
+                              size_t mlen, const uint8_t *ctx, size_t ctxlen,
+                              const mld_sign_ctx *sctx)
+{
+  uint8_t pre[257];
+  uint8_t rnd[MLDSA_RNDBYTES];
+  int result;
+
+  if (ctxlen > 255)
+  {
+    *siglen = 0;
+    return -1;
+  }
+
+  mld_prepare_pre(pre, ctx, ctxlen);
+
+#ifdef MLD_RANDOMIZED_SIGNING
+  mld_randombytes(rnd, MLDSA_RNDBYTES);
+  MLD_CT_TESTING_SECRET(rnd, sizeof(rnd));
+#else
+  memset(rnd, 0, MLDSA_RNDBYTES);
+#endif
+
+  MLD_PROFILE(MLD_PROFILE_SIGN, result = mld_sign_core(sig, siglen, m, mlen,
+                                                       pre, 2 + ctxlen, rnd,
+                                                       sctx, 0));
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(pre, sizeof(pre));
+  mld_zeroize(rnd, sizeof(rnd));
+
+  return result;
 }
 
 MLD_MUST_CHECK_RETURN_VALUE
-int crypto_sign_signature(uint8_t *sig, size_t *siglen, const uint8_t *m,
-                          size_t mlen, const uint8_t *ctx, size_t ctxlen,
-                          const uint8_t *sk)
+int crypto_sign_start(mld_sign_state *state, const uint8_t *m, size_t mlen,
+                      const uint8_t *ctx, size_t ctxlen, const uint8_t *sk)
 {
-  size_t i;
   uint8_t pre[257];
   uint8_t rnd[MLDSA_RNDBYTES];
-  int result;
 
+  /* Mark the state as failed until it is fully set up, so that
+   * crypto_sign_step() and crypto_sign_finish() fail on error. */
+  state->status = -1;
   if (ctxlen > 255)
   {
-    /* To be on the safe-side, make sure *siglen has a well-defined */
-    /* value, even in the case of error.                            */
-    *siglen = 0;
     return -1;
   }
 
-  /* Prepare pre = (0, ctxlen, ctx) */
-  pre[0] = 0;
-  pre[1] = ctxlen;
-  for (i = 0; i < ctxlen; i++)
-  __loop__(
-    assigns(i, object_whole(pre))
-    invariant(i <= ctxlen)
-    invariant(ctxlen <= 255)
-  )
-  {
-    pre[2 + i] = ctx[i];
-  }
+  mld_prepare_pre(pre, ctx, ctxlen);
 
 #ifdef MLD_RANDOMIZED_SIGNING
   mld_randombytes(rnd, MLDSA_RNDBYTES);
@@ -606,38 +1512,84 @@ int crypto_sign_signature(uint8_t *sig, size_t *siglen, const uint8_t *m,
   memset(rnd, 0, MLDSA_RNDBYTES);
 #endif
 
+  mld_sign_ctx_init(&state->sctx, sk);
 
-  result = crypto_sign_signature_internal(sig, siglen, m, mlen, pre, 2 + ctxlen,
-                                          rnd, sk, 0);
+  /* Compute mu = CRH(tr, pre, msg) */
+  mld_mu_from_midstate(state->mu, &state->sctx.mu_state, pre, 2 + ctxlen, m,
+                       mlen);
+
+  /* Compute rhoprime = CRH(key, rnd, mu) */
+  mld_H(state->rhoprime, MLDSA_CRHBYTES, state->sctx.key, MLDSA_SEEDBYTES,
+        rnd, MLDSA_RNDBYTES, state->mu, MLDSA_CRHBYTES);
+
+  state->nonce = 0;
+  state->status = 1;
 
   /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
   mld_zeroize(pre, sizeof(pre));
   mld_zeroize(rnd, sizeof(rnd));
 
-  return result;
+  return 0;
 }
 
 MLD_MUST_CHECK_RETURN_VALUE
-int crypto_sign_signature_extmu(uint8_t *sig, size_t *siglen,
-                                const uint8_t mu[MLDSA_CRHBYTES],
-                                const uint8_t *sk)
+int crypto_sign_step(uint8_t *sig, mld_sign_state *state,
+                     unsigned int max_attempts)
 {
-  uint8_t rnd[MLDSA_RNDBYTES];
-  int result;
+  mld_sign_attempt_ws ws;
+  unsigned int i;
 
-#ifdef MLD_RANDOMIZED_SIGNING
-  mld_randombytes(rnd, MLDSA_RNDBYTES);
-  MLD_CT_TESTING_SECRET(rnd, sizeof(rnd));
-#else
-  memset(rnd, 0, MLDSA_RNDBYTES);
-#endif
+  for (i = 0; i < max_attempts && state->status == 1; i++)
+  __loop__(
+    assigns(i, state->nonce, state->status, memory_slice(sig, CRYPTO_BYTES),
+            memory_slice(&ws, sizeof(mld_sign_attempt_ws)))
+    invariant(i <= max_attempts)
+    invariant(state->nonce <= NONCE_UB)
+    invariant(state->status == 1 || state->status == 0 ||
+              state->status == -1)
+  )
+  {
+    /* Same termination check as in mld_sign_core() */
+    if (state->nonce == NONCE_UB)
+    {
+      state->status = -1;
+      break;
+    }
 
-  result = crypto_sign_signature_internal(sig, siglen, mu, MLDSA_CRHBYTES, NULL,
-                                          0, rnd, sk, 1);
+    if (mld_attempt_signature_generation(
+            sig, state->mu, state->rhoprime, state->nonce, &state->sctx.mat,
+            &state->sctx.s1, &state->sctx.s2, &state->sctx.t0, &ws) == 0)
+    {
+      state->status = 0;
+      MLD_STATS_SIGNATURE(state->nonce + 1u);
+    }
+    state->nonce++;
+  }
 
   /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
-  mld_zeroize(rnd, sizeof(rnd));
+  mld_zeroize(&ws, sizeof(ws));
+  return state->status;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_finish(uint8_t *sig, size_t *siglen, mld_sign_state *state)
+{
+  int result = state->status == 0 ? 0 : -1;
+
+  if (result == 0)
+  {
+    *siglen = CRYPTO_BYTES;
+  }
+  else
+  {
+    /* To be on the safe-side, give well-defined values to *sig and     */
+    /* *siglen in case of error.                                        */
+    *siglen = 0;
+    memset(sig, 0, CRYPTO_BYTES);
+  }
 
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(state, sizeof(mld_sign_state));
   return result;
 }
 
@@ -663,10 +1615,46 @@ int crypto_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen,
 }
 
 MLD_MUST_CHECK_RETURN_VALUE
-int crypto_sign_verify_internal(const uint8_t *sig, size_t siglen,
-                                const uint8_t *m, size_t mlen,
-                                const uint8_t *pre, size_t prelen,
-                                const uint8_t *pk, int externalmu)
+int crypto_sign_inplace(uint8_t *sm, size_t *smlen, size_t mlen,
+                        const uint8_t *ctx, size_t ctxlen, const uint8_t *sk)
+{
+  int ret;
+
+  ret = crypto_sign_signature(sm, smlen, sm + CRYPTO_BYTES, mlen, ctx, ctxlen,
+                              sk);
+  *smlen += mlen;
+  return ret;
+}
+
+/*************************************************
+ * Name:        mld_verify_core
+ *
+ * Description: Shared implementation of crypto_sign_verify_internal() and
+ *              crypto_sign_verify_expanded().
+ *
+ * Arguments:   - const uint8_t *tr: pointer to H(pk), or NULL to compute it
+ *                from pk. Ignored if externalmu is set.
+ *              - const uint8_t *packed_mat: pointer to the matrix A packed
+ *                by mld_polyvec_matrix_pack(), or NULL to expand A from pk.
+ *              - all other arguments as for crypto_sign_verify_internal()
+ *
+ * Returns 0 if signature could be verified correctly and -1 otherwise
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+static int mld_verify_core(const uint8_t *sig, size_t siglen, const uint8_t *m,
+                           size_t mlen, const uint8_t *pre, size_t prelen,
+                           const uint8_t *tr, const uint8_t *pk,
+                           const uint8_t *packed_mat, int externalmu)
+__contract__(
+  requires(memory_no_alias(sig, siglen))
+  requires(memory_no_alias(m, mlen))
+  requires(externalmu == 0 || (externalmu == 1 && mlen == MLDSA_CRHBYTES))
+  requires(externalmu == 1 || memory_no_alias(pre, prelen))
+  requires(tr == NULL || memory_no_alias(tr, MLDSA_TRBYTES))
+  requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
+  requires(packed_mat == NULL || memory_no_alias(packed_mat, MLDSA_POLYMAT_PACKEDBYTES))
+  ensures(return_value == 0 || return_value == -1)
+)
 {
   unsigned int i;
   uint8_t buf[MLDSA_K * MLDSA_POLYW1_PACKEDBYTES];
@@ -675,25 +1663,37 @@ int crypto_sign_verify_internal(const uint8_t *sig, size_t siglen,
   uint8_t c[MLDSA_CTILDEBYTES];
   uint8_t c2[MLDSA_CTILDEBYTES];
   mld_poly cp;
-  mld_polyvecl mat[MLDSA_K], z;
+  mld_polyvecl z;
   mld_polyveck t1, w1, tmp, h;
+  int sig_invalid;
+  uint32_t z_invalid;
 
   if (siglen != CRYPTO_BYTES)
   {
     return -1;
   }
 
-  mld_unpack_pk(rho, &t1, pk);
-  if (mld_unpack_sig(c, &z, &h, sig))
+  /* Reject malformed signatures before touching the public key */
+  MLD_PROFILE(MLD_PROFILE_UNPACK, sig_invalid = mld_unpack_sig(c, &z, &h, sig));
+  if (sig_invalid)
   {
     return -1;
   }
-  if (mld_polyvecl_chknorm(&z, MLDSA_GAMMA1 - MLDSA_BETA))
+  MLD_PROFILE(MLD_PROFILE_ROUNDING,
+              z_invalid = mld_polyvecl_chknorm(&z, MLDSA_GAMMA1 - MLDSA_BETA));
+  if (z_invalid)
   {
     return -1;
   }
+  MLD_PROFILE(MLD_PROFILE_UNPACK, mld_unpack_pk(rho, &t1, pk));
 
-  if (!externalmu)
+  MLD_PROFILE_BEGIN(MLD_PROFILE_HASH);
+  if (!externalmu && tr != NULL)
+  {
+    /* Compute CRH(tr, pre, msg) with precomputed tr = H(rho, t1) */
+    mld_H(mu, MLDSA_CRHBYTES, tr, MLDSA_TRBYTES, pre, prelen, m, mlen);
+  }
+  else if (!externalmu)
   {
     /* Compute CRH(H(rho, t1), pre, msg) */
     uint8_t hpk[MLDSA_CRHBYTES];
@@ -708,13 +1708,32 @@ int crypto_sign_verify_internal(const uint8_t *sig, size_t siglen,
     /* mu has been provided directly */
     memcpy(mu, m, MLDSA_CRHBYTES);
   }
+  MLD_PROFILE_END(MLD_PROFILE_HASH);
 
   /* Matrix-vector multiplication; compute Az - c2^dt1 */
-  mld_poly_challenge(&cp, c);
-  mld_polyvec_matrix_expand(mat, rho);
+  MLD_PROFILE(MLD_PROFILE_SAMPLE_CHALLENGE, mld_poly_challenge(&cp, c));
 
+  MLD_PROFILE_BEGIN(MLD_PROFILE_NTT);
   mld_polyvecl_ntt(&z);
-  mld_polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+  if (packed_mat != NULL)
+  {
+    /* Use the cached matrix, unpacking on the fly */
+    mld_polyvec_matrix_pointwise_montgomery_packed(&w1, packed_mat, &z);
+  }
+  else
+  {
+#if defined(MLD_CONFIG_REDUCE_RAM)
+    /* Matrix expansion is interleaved with the multiplication here */
+    mld_polyvec_matrix_pointwise_montgomery_stream(&w1, rho, &z);
+#else
+    mld_polyvecl mat[MLDSA_K];
+    MLD_PROFILE(MLD_PROFILE_EXPAND_MATRIX, mld_polyvec_matrix_expand(mat, rho));
+    mld_polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+
+    /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+    mld_zeroize(mat, sizeof(mat));
+#endif /* !MLD_CONFIG_REDUCE_RAM */
+  }
 
   mld_poly_ntt(&cp);
   mld_polyveck_shiftl(&t1);
@@ -725,14 +1744,18 @@ int crypto_sign_verify_internal(const uint8_t *sig, size_t siglen,
   mld_polyveck_sub(&w1, &tmp);
   mld_polyveck_reduce(&w1);
   mld_polyveck_invntt_tomont(&w1);
+  MLD_PROFILE_END(MLD_PROFILE_NTT);
 
   /* Reconstruct w1 */
+  MLD_PROFILE_BEGIN(MLD_PROFILE_ROUNDING);
   mld_polyveck_caddq(&w1);
   mld_polyveck_use_hint(&tmp, &w1, &h);
-  mld_polyveck_pack_w1(buf, &tmp);
+  MLD_PROFILE_END(MLD_PROFILE_ROUNDING);
+  MLD_PROFILE(MLD_PROFILE_PACK, mld_polyveck_pack_w1(buf, &tmp));
   /* Call random oracle and verify challenge */
-  mld_H(c2, MLDSA_CTILDEBYTES, mu, MLDSA_CRHBYTES, buf,
-        MLDSA_K * MLDSA_POLYW1_PACKEDBYTES, NULL, 0);
+  MLD_PROFILE(MLD_PROFILE_HASH,
+              mld_H(c2, MLDSA_CTILDEBYTES, mu, MLDSA_CRHBYTES, buf,
+                    MLDSA_K * MLDSA_POLYW1_PACKEDBYTES, NULL, 0));
 
   /* Constant time: All data in verification is usually considered public.
    * However, in our constant-time tests we do not declassify the message and
@@ -765,17 +1788,29 @@ int crypto_sign_verify_internal(const uint8_t *sig, size_t siglen,
   mld_zeroize(&w1, sizeof(w1));
   mld_zeroize(&tmp, sizeof(tmp));
   mld_zeroize(&h, sizeof(h));
-  mld_zeroize(mat, sizeof(mat));
 
   return 0;
 }
 
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_verify_internal(const uint8_t *sig, size_t siglen,
+                                const uint8_t *m, size_t mlen,
+                                const uint8_t *pre, size_t prelen,
+                                const uint8_t *pk, int externalmu)
+{
+  int result;
+
+  MLD_PROFILE(MLD_PROFILE_VERIFY,
+              result = mld_verify_core(sig, siglen, m, mlen, pre, prelen, NULL,
+                                       pk, NULL, externalmu));
+  return result;
+}
+
 MLD_MUST_CHECK_RETURN_VALUE
 int crypto_sign_verify(const uint8_t *sig, size_t siglen, const uint8_t *m,
                        size_t mlen, const uint8_t *ctx, size_t ctxlen,
                        const uint8_t *pk)
 {
-  size_t i;
   uint8_t pre[257];
   int result;
 
@@ -784,18 +1819,35 @@ int crypto_sign_verify(const uint8_t *sig, size_t siglen, const uint8_t *m,
     return -1;
   }
 
-  pre[0] = 0;
-  pre[1] = ctxlen;
-  for (i = 0; i < ctxlen; i++)
-  __loop__(
-    invariant(i <= ctxlen)
-  )
+  mld_prepare_pre(pre, ctx, ctxlen);
+
+#if defined(MLD_CONFIG_VERIFY_CACHE)
+  if (siglen == CRYPTO_BYTES)
   {
-    pre[2 + i] = ctx[i];
+    uint8_t digest[MLD_VERIFY_CACHE_DIGESTBYTES];
+    mld_verify_cache_digest(digest, sig, m, mlen, pre, 2 + ctxlen, pk);
+    if (mld_verify_cache_lookup(digest))
+    {
+      result = 0;
+    }
+    else
+    {
+      result = crypto_sign_verify_internal(sig, siglen, m, mlen, pre,
+                                           2 + ctxlen, pk, 0);
+      if (result == 0)
+      {
+        mld_verify_cache_insert(digest);
+      }
+    }
   }
-
+  else
+  {
+    result = -1;
+  }
+#else  /* MLD_CONFIG_VERIFY_CACHE */
   result =
       crypto_sign_verify_internal(sig, siglen, m, mlen, pre, 2 + ctxlen, pk, 0);
+#endif /* !MLD_CONFIG_VERIFY_CACHE */
 
   /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
   mld_zeroize(pre, sizeof(pre));
@@ -857,3 +1909,201 @@ badsig:
 
   return -1;
 }
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_open_inplace(const uint8_t **m, size_t *mlen,
+                             const uint8_t *sm, size_t smlen,
+                             const uint8_t *ctx, size_t ctxlen,
+                             const uint8_t *pk)
+{
+  if (smlen < CRYPTO_BYTES ||
+      crypto_sign_verify(sm, CRYPTO_BYTES, sm + CRYPTO_BYTES,
+                         smlen - CRYPTO_BYTES, ctx, ctxlen, pk))
+  {
+    *m = NULL;
+    *mlen = 0;
+    return -1;
+  }
+
+  *m = sm + CRYPTO_BYTES;
+  *mlen = smlen - CRYPTO_BYTES;
+  return 0;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_sig_precheck(const uint8_t *sig, size_t siglen)
+{
+  uint8_t c[MLDSA_CTILDEBYTES];
+  mld_polyvecl z;
+  mld_polyveck h;
+  int result = 0;
+
+  if (siglen != CRYPTO_BYTES)
+  {
+    return -1;
+  }
+
+  /* Same checks as in mld_verify_core() */
+  if (mld_unpack_sig(c, &z, &h, sig) ||
+      mld_polyvecl_chknorm(&z, MLDSA_GAMMA1 - MLDSA_BETA))
+  {
+    result = -1;
+  }
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(c, sizeof(c));
+  mld_zeroize(&z, sizeof(z));
+  mld_zeroize(&h, sizeof(h));
+
+  return result;
+}
+
+int crypto_sign_expand_pk(uint8_t *epk, const uint8_t *pk)
+{
+  uint8_t *tr = epk + CRYPTO_PUBLICKEYBYTES;
+  uint8_t *packed_mat = tr + MLDSA_TRBYTES;
+
+  memcpy(epk, pk, CRYPTO_PUBLICKEYBYTES);
+  mld_H(tr, MLDSA_TRBYTES, pk, CRYPTO_PUBLICKEYBYTES, NULL, 0, NULL, 0);
+
+#if defined(MLD_CONFIG_REDUCE_RAM)
+  mld_polyvec_matrix_expand_packed(packed_mat, pk);
+#else
+  {
+    mld_polyvecl mat[MLDSA_K];
+    mld_polyvec_matrix_expand(mat, pk);
+    mld_polyvec_matrix_pack(packed_mat, mat);
+
+    /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+    mld_zeroize(mat, sizeof(mat));
+  }
+#endif /* !MLD_CONFIG_REDUCE_RAM */
+
+  return 0;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_verify_expanded(const uint8_t *sig, size_t siglen,
+                                const uint8_t *m, size_t mlen,
+                                const uint8_t *ctx, size_t ctxlen,
+                                const uint8_t *epk)
+{
+  uint8_t pre[257];
+  int result;
+
+  if (ctxlen > 255)
+  {
+    return -1;
+  }
+
+  mld_prepare_pre(pre, ctx, ctxlen);
+
+  MLD_PROFILE(MLD_PROFILE_VERIFY,
+              result = mld_verify_core(
+                  sig, siglen, m, mlen, pre, 2 + ctxlen,
+                  epk + CRYPTO_PUBLICKEYBYTES, epk,
+                  epk + CRYPTO_PUBLICKEYBYTES + MLDSA_TRBYTES, 0));
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(pre, sizeof(pre));
+
+  return result;
+}
+
+int crypto_sign_mu_midstate(keccak_state *state, const uint8_t *pk)
+{
+  uint8_t tr[MLDSA_TRBYTES];
+
+  shake256(tr, MLDSA_TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+  mld_mu_midstate_init(state, tr);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(tr, sizeof(tr));
+  return 0;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_mu_from_midstate(uint8_t mu[MLDSA_CRHBYTES],
+                                 const keccak_state *state, const uint8_t *m,
+                                 size_t mlen, const uint8_t *ctx,
+                                 size_t ctxlen)
+{
+  uint8_t pre[257];
+
+  if (ctxlen > 255)
+  {
+    return -1;
+  }
+
+  mld_prepare_pre(pre, ctx, ctxlen);
+
+  mld_mu_from_midstate(mu, state, pre, 2 + ctxlen, m, mlen);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(pre, sizeof(pre));
+  return 0;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_signature_iov(uint8_t *sig, size_t *siglen,
+                              const mld_iovec *iov, size_t iovcnt,
+                              const uint8_t *ctx, size_t ctxlen,
+                              const uint8_t *sk)
+{
+  uint8_t pre[257];
+  uint8_t mu[MLDSA_CRHBYTES];
+  keccak_state state;
+  int result;
+
+  if (ctxlen > 255)
+  {
+    *siglen = 0;
+    return -1;
+  }
+
+  mld_prepare_pre(pre, ctx, ctxlen);
+
+  /* tr is stored in sk after rho and key */
+  mld_mu_midstate_init(&state, sk + 2 * MLDSA_SEEDBYTES);
+  mld_mu_from_midstate_iov(mu, &state, pre, 2 + ctxlen, iov, iovcnt);
+
+  result = crypto_sign_signature_extmu(sig, siglen, mu, sk);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(pre, sizeof(pre));
+  mld_zeroize(mu, sizeof(mu));
+  mld_zeroize(&state, sizeof(state));
+
+  return result;
+}
+
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_verify_iov(const uint8_t *sig, size_t siglen,
+                           const mld_iovec *iov, size_t iovcnt,
+                           const uint8_t *ctx, size_t ctxlen,
+                           const uint8_t *pk)
+{
+  uint8_t pre[257];
+  uint8_t mu[MLDSA_CRHBYTES];
+  keccak_state state;
+  int result;
+
+  if (ctxlen > 255)
+  {
+    return -1;
+  }
+
+  mld_prepare_pre(pre, ctx, ctxlen);
+
+  crypto_sign_mu_midstate(&state, pk);
+  mld_mu_from_midstate_iov(mu, &state, pre, 2 + ctxlen, iov, iovcnt);
+
+  result = crypto_sign_verify_extmu(sig, siglen, mu, pk);
+
+  /* FIPS 204. Section 3.6.3 Destruction of intermediate values. */
+  mld_zeroize(pre, sizeof(pre));
+  mld_zeroize(mu, sizeof(mu));
+  mld_zeroize(&state, sizeof(state));
+
+  return result;
+}
@@ -7,12 +7,132 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "api_types.h"
 #include "cbmc.h"
 #include "common.h"
+#include "fips202/fips202.h"
 #include "poly.h"
 #include "polyvec.h"
 #include "sys.h"
 
+/* Representation of the secret vectors s1 and s2 during signing.
+ * By default, they are kept in NTT domain. If MLD_CONFIG_SMALL_SECRETS is
+ * set, they are kept in normal domain at half width, and multiplied by the
+ * challenge directly, see mld_poly_challenge_mul_small(). */
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+typedef mld_polyvecl_small mld_polyvecl_secret;
+typedef mld_polyveck_small mld_polyveck_secret;
+#define MLD_SECRET_LOWER_BOUND MLD_POLYETA_UNPACK_LOWER_BOUND
+#define MLD_SECRET_UPPER_BOUND (MLDSA_ETA + 1)
+#define mld_unpack_sk_secret mld_unpack_sk_small
+#else /* MLD_CONFIG_SMALL_SECRETS */
+typedef mld_polyvecl mld_polyvecl_secret;
+typedef mld_polyveck mld_polyveck_secret;
+#define MLD_SECRET_LOWER_BOUND (-MLD_NTT_BOUND + 1)
+#define MLD_SECRET_UPPER_BOUND MLD_NTT_BOUND
+#define mld_unpack_sk_secret mld_unpack_sk
+#endif /* !MLD_CONFIG_SMALL_SECRETS */
+
+/* Representation of the matrix A during signing.
+ * By default, A is expanded once per signature and kept in full. With
+ * MLD_CONFIG_REDUCE_RAM, only rho is kept and the rows of A are regenerated
+ * in every attempt, or, with MLD_CONFIG_REDUCE_RAM_CACHE_ROWS, kept in the
+ * packed 23-bit format. */
+#if !defined(MLD_CONFIG_REDUCE_RAM)
+typedef struct mld_sign_matrix
+{
+  mld_polyvecl rows[MLDSA_K];
+} mld_sign_matrix;
+#define mld_sign_matrix_init(a, rho) mld_polyvec_matrix_expand((a)->rows, rho)
+#define mld_sign_matrix_mul(t, a, v) \
+  mld_polyvec_matrix_pointwise_montgomery(t, (a)->rows, v)
+#define MLD_SIGN_MATRIX_BOUND(a)                       \
+  forall(k1, 0, MLDSA_K, forall(l1, 0, MLDSA_L,        \
+         array_bound((a)->rows[k1].vec[l1].coeffs, 0, \
+                     MLDSA_N, 0, MLDSA_Q)))
+#elif defined(MLD_CONFIG_REDUCE_RAM_CACHE_ROWS)
+typedef struct mld_sign_matrix
+{
+  uint8_t packed[MLDSA_POLYMAT_PACKEDBYTES];
+} mld_sign_matrix;
+#define mld_sign_matrix_init(a, rho) \
+  mld_polyvec_matrix_expand_packed((a)->packed, rho)
+#define mld_sign_matrix_mul(t, a, v) \
+  mld_polyvec_matrix_pointwise_montgomery_packed(t, (a)->packed, v)
+#define MLD_SIGN_MATRIX_BOUND(a) 1
+#else /* !MLD_CONFIG_REDUCE_RAM */
+typedef struct mld_sign_matrix
+{
+  uint8_t rho[MLDSA_SEEDBYTES];
+} mld_sign_matrix;
+#define mld_sign_matrix_init(a, seed) \
+  memcpy((a)->rho, seed, MLDSA_SEEDBYTES)
+#define mld_sign_matrix_mul(t, a, v) \
+  mld_polyvec_matrix_pointwise_montgomery_stream(t, (a)->rho, v)
+#define MLD_SIGN_MATRIX_BOUND(a) 1
+#endif /* MLD_CONFIG_REDUCE_RAM */
+
+/* Precomputed signing context.
+ *
+ * Holds a secret key in the form used during signing: the matrix A (see
+ * mld_sign_matrix), s1, s2 (see mld_polyvecl_secret) and t0 in NTT domain,
+ * the seeds rho, tr and key, and the SHAKE256 state after absorbing tr, see
+ * crypto_sign_mu_midstate(). It is filled by crypto_sign_keypair_ctx()
+ * and consumed by crypto_sign_signature_ctx().
+ *
+ * The layout depends on the parameter set and build configuration, so the
+ * context must not be stored or exchanged. It contains secret data and must
+ * be wiped by the caller once no longer needed. */
+typedef struct
+{
+  mld_sign_matrix mat;
+  mld_polyvecl_secret s1;
+  mld_polyveck_secret s2;
+  mld_polyveck t0;
+  uint8_t rho[MLDSA_SEEDBYTES];
+  uint8_t tr[MLDSA_TRBYTES];
+  uint8_t key[MLDSA_SEEDBYTES];
+  keccak_state mu_state;
+} MLD_ALIGN mld_sign_ctx;
+
+#define MLD_SIGN_CTX_BOUND(c)                                             \
+  (MLD_SIGN_MATRIX_BOUND(&(c)->mat) &&                                    \
+   forall(k2, 0, MLDSA_K,                                                 \
+          array_abs_bound((c)->t0.vec[k2].coeffs, 0, MLDSA_N,             \
+                          MLD_NTT_BOUND)) &&                              \
+   forall(k3, 0, MLDSA_L,                                                 \
+          array_bound((c)->s1.vec[k3].coeffs, 0, MLDSA_N,                 \
+                      MLD_SECRET_LOWER_BOUND, MLD_SECRET_UPPER_BOUND)) && \
+   forall(k4, 0, MLDSA_K,                                                 \
+          array_bound((c)->s2.vec[k4].coeffs, 0, MLDSA_N,                 \
+                      MLD_SECRET_LOWER_BOUND, MLD_SECRET_UPPER_BOUND)))
+
+/* Reference: The reference implementation does not explicitly   */
+/* check the maximum nonce value, but instead loops indefinitely */
+/* (even when the nonce would overflow). Internally,             */
+/* sampling of y uses (nonceL), (nonceL+1), ... (nonce*L+L-1).   */
+/* Hence, there are no overflows if nonce < (UINT16_MAX - L)/L.  */
+/* Explicitly checking for this explicitly allows us to prove    */
+/* type-safety. Note that FIPS204 explicitly allows an upper-    */
+/* bound this loop of 814 (< (UINT16_MAX - L)/L) - see           */
+/* Appendix C of FIPS204.                                        */
+#define NONCE_UB ((UINT16_MAX - MLDSA_L) / MLDSA_L)
+
+/* State of a resumable signing operation.
+ *
+ * Holds the signing context of the secret key, mu, rhoprime and the nonce
+ * of the next signing attempt. It is set up by crypto_sign_start(),
+ * advanced by crypto_sign_step() and wiped by crypto_sign_finish(). Like
+ * mld_sign_ctx, it must not be stored or exchanged. */
+typedef struct
+{
+  mld_sign_ctx sctx;
+  uint8_t mu[MLDSA_CRHBYTES];
+  uint8_t rhoprime[MLDSA_CRHBYTES];
+  uint16_t nonce;
+  int status;
+} MLD_ALIGN mld_sign_state;
+
 #define crypto_sign_keypair_internal MLD_NAMESPACE(keypair_internal)
 /*************************************************
  * Name:        crypto_sign_keypair_internal
@@ -29,7 +149,8 @@
  *              - uint8_t *seed: pointer to input random seed (MLDSA_SEEDBYTES
  *                               bytes)
  *
- * Returns 0 (success) or -1 (PCT failure)
+ * Returns 0 (success) or -1 (PCT failure). On failure, pk and sk are
+ * zeroized.
  **************************************************/
 MLD_MUST_CHECK_RETURN_VALUE
 int crypto_sign_keypair_internal(uint8_t *pk, uint8_t *sk,
@@ -57,7 +178,8 @@ __contract__(
  *              - uint8_t *sk:   pointer to output private key (allocated
  *                               array of CRYPTO_SECRETKEYBYTES bytes)
  *
- * Returns 0 (success) or -1 (PCT failure)
+ * Returns 0 (success) or -1 (PCT failure). On failure, pk and sk are
+ * zeroized.
  **************************************************/
 MLD_MUST_CHECK_RETURN_VALUE
 int crypto_sign_keypair(uint8_t *pk, uint8_t *sk)
@@ -69,6 +191,77 @@ __contract__(
   ensures(return_value == 0 || return_value == -1)
 );
 
+#define crypto_sign_keypair_batch MLD_NAMESPACE(keypair_batch)
+/*************************************************
+ * Name:        crypto_sign_keypair_batch
+ *
+ * Description: Generates n key pairs from n seeds. Key pair i is identical
+ *              to the output of crypto_sign_keypair_internal on seed i.
+ *              Groups of four key pairs share the x4 SHAKE256 instances
+ *              used for seed expansion, secret sampling and hashing of the
+ *              public key, which is faster than n separate calls.
+ *              When MLD_CONFIG_KEYGEN_PCT is set, performs a Pairwise
+ *              Consistency Test (PCT) on every key pair.
+ *
+ * Arguments:   - uint8_t *pks:   pointer to output public keys (allocated
+ *                                array of n * CRYPTO_PUBLICKEYBYTES bytes)
+ *              - uint8_t *sks:   pointer to output private keys (allocated
+ *                                array of n * CRYPTO_SECRETKEYBYTES bytes)
+ *              - uint8_t *seeds: pointer to input random seeds
+ *                                (n * MLDSA_SEEDBYTES bytes)
+ *              - size_t n:       number of key pairs
+ *
+ * Returns 0 (success) or -1 (PCT failure). On failure, all n key pairs
+ * are zeroized.
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_keypair_batch(uint8_t *pks, uint8_t *sks, const uint8_t *seeds,
+                              size_t n)
+__contract__(
+  requires(n <= SIZE_MAX / CRYPTO_SECRETKEYBYTES)
+  requires(memory_no_alias(pks, n * CRYPTO_PUBLICKEYBYTES))
+  requires(memory_no_alias(sks, n * CRYPTO_SECRETKEYBYTES))
+  requires(memory_no_alias(seeds, n * MLDSA_SEEDBYTES))
+  assigns(memory_slice(pks, n * CRYPTO_PUBLICKEYBYTES))
+  assigns(memory_slice(sks, n * CRYPTO_SECRETKEYBYTES))
+  ensures(return_value == 0 || return_value == -1)
+);
+
+#define crypto_sign_keypair_ctx MLD_NAMESPACE(keypair_ctx)
+/*************************************************
+ * Name:        crypto_sign_keypair_ctx
+ *
+ * Description: Same as crypto_sign_keypair(), but additionally fills a
+ *              signing context for the new key, taken directly from the
+ *              values held during key generation. Signing with it via
+ *              crypto_sign_signature_ctx() skips unpacking the secret key
+ *              and expanding the matrix A.
+ *              When MLD_CONFIG_KEYGEN_PCT is set, the Pairwise Consistency
+ *              Test (PCT) signs using this context.
+ *
+ * Arguments:   - uint8_t *pk:   pointer to output public key (allocated
+ *                               array of CRYPTO_PUBLICKEYBYTES bytes)
+ *              - uint8_t *sk:   pointer to output private key (allocated
+ *                               array of CRYPTO_SECRETKEYBYTES bytes)
+ *              - mld_sign_ctx *sctx: pointer to output signing context
+ *
+ * Returns 0 (success) or -1 (PCT failure). On failure, pk, sk and sctx
+ * are zeroized.
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_keypair_ctx(uint8_t *pk, uint8_t *sk, mld_sign_ctx *sctx)
+__contract__(
+  requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
+  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  requires(memory_no_alias(sctx, sizeof(mld_sign_ctx)))
+  assigns(object_whole(pk))
+  assigns(object_whole(sk))
+  assigns(object_whole(sctx))
+  ensures(return_value == 0 || return_value == -1)
+  ensures(MLD_SIGN_CTX_BOUND(sctx))
+  ensures(sctx->mu_state.pos <= SHAKE256_RATE)
+);
+
 #define crypto_sign_signature_internal MLD_NAMESPACE(signature_internal)
 /*************************************************
  * Name:        crypto_sign_signature_internal
@@ -180,6 +373,147 @@ __contract__(
           (return_value == -1 && *siglen == 0))
 );
 
+#define crypto_sign_signature_ctx MLD_NAMESPACE(signature_ctx)
+/*************************************************
+ * Name:        crypto_sign_signature_ctx
+ *
+ * Description: Same as crypto_sign_signature(), but using a signing context
+ *              filled by crypto_sign_keypair_ctx() instead of a secret key.
+ *
+ * Arguments:   - uint8_t *sig:   pointer to output signature (of length
+ *                                CRYPTO_BYTES)
+ *              - size_t *siglen: pointer to output length of signature
+ *              - uint8_t *m:     pointer to message to be signed
+ *              - size_t mlen:    length of message
+ *              - uint8_t *ctx:   pointer to context string. May be NULL if
+ *                                ctxlen == 0.
+ *              - size_t ctxlen:  length of context string. Should be <= 255.
+ *              - const mld_sign_ctx *sctx: pointer to signing context
+ *
+ * Returns 0 (success) or -1 (context string too long OR nonce exhaustion)
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_signature_ctx(uint8_t *sig, size_t *siglen, const uint8_t *m,
+                              size_t mlen, const uint8_t *ctx, size_t ctxlen,
+                              const mld_sign_ctx *sctx)
+__contract__(
+  requires(memory_no_alias(sig, CRYPTO_BYTES))
+  requires(memory_no_alias(siglen, sizeof(size_t)))
+  requires(memory_no_alias(m, mlen))
+  requires((ctx == NULL && ctxlen == 0) || memory_no_alias(ctx, ctxlen))
+  requires(memory_no_alias(sctx, sizeof(mld_sign_ctx)))
+  requires(MLD_SIGN_CTX_BOUND(sctx))
+  requires(sctx->mu_state.pos <= SHAKE256_RATE)
+  assigns(memory_slice(sig, CRYPTO_BYTES))
+  assigns(object_whole(siglen))
+  ensures((return_value == 0 && *siglen == CRYPTO_BYTES) ||
+          (return_value == -1 && *siglen == 0))
+);
+
+#define crypto_sign_start MLD_NAMESPACE(start)
+/*************************************************
+ * Name:        crypto_sign_start
+ *
+ * Description: Starts a resumable computation of the signature
+ *              crypto_sign_signature() would compute. Unpacks the secret
+ *              key and computes mu and rhoprime, but does not yet make
+ *              any signing attempt; see crypto_sign_step().
+ *
+ *              The work of each signing attempt is bounded, but the
+ *              number of attempts is not. Splitting the rejection loop
+ *              allows callers to interleave signing with other work.
+ *
+ * Arguments:   - mld_sign_state *state: pointer to output state
+ *              - uint8_t *m:     pointer to message to be signed
+ *              - size_t mlen:    length of message
+ *              - uint8_t *ctx:   pointer to context string. May be NULL
+ *                                iff ctxlen == 0
+ *              - size_t ctxlen:  length of context string. Should be <= 255.
+ *              - uint8_t *sk:    pointer to bit-packed secret key
+ *
+ * Returns 0 (success) or -1 (context string too long). On failure,
+ * the state is marked as failed, so that crypto_sign_step() and
+ * crypto_sign_finish() return -1.
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_start(mld_sign_state *state, const uint8_t *m, size_t mlen,
+                      const uint8_t *ctx, size_t ctxlen, const uint8_t *sk)
+__contract__(
+  requires(memory_no_alias(state, sizeof(mld_sign_state)))
+  requires(memory_no_alias(m, mlen))
+  requires((ctx == NULL && ctxlen == 0) || memory_no_alias(ctx, ctxlen))
+  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  assigns(object_whole(state))
+  ensures(return_value == 0 || return_value == -1)
+  ensures(return_value == 0 ==> (MLD_SIGN_CTX_BOUND(&state->sctx) &&
+                                 state->nonce == 0 && state->status == 1))
+  ensures(return_value == -1 ==> state->status == -1)
+);
+
+#define crypto_sign_step MLD_NAMESPACE(step)
+/*************************************************
+ * Name:        crypto_sign_step
+ *
+ * Description: Makes at most max_attempts signing attempts for a state
+ *              set up by crypto_sign_start(). sig must point to the same
+ *              buffer in all calls for one state; its contents are only
+ *              meaningful once crypto_sign_finish() succeeds.
+ *
+ * Arguments:   - uint8_t *sig: pointer to output signature (of length
+ *                              CRYPTO_BYTES)
+ *              - mld_sign_state *state: pointer to state
+ *              - unsigned int max_attempts: maximum number of attempts
+ *
+ * Returns 1 if further steps are needed, 0 once a signature has been
+ * found and -1 on nonce exhaustion. In the latter two cases, further
+ * steps do no work and return the same value.
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_step(uint8_t *sig, mld_sign_state *state,
+                     unsigned int max_attempts)
+__contract__(
+  requires(memory_no_alias(sig, CRYPTO_BYTES))
+  requires(memory_no_alias(state, sizeof(mld_sign_state)))
+  requires(MLD_SIGN_CTX_BOUND(&state->sctx))
+  requires(state->nonce <= NONCE_UB)
+  requires(state->status == 1 || state->status == 0 || state->status == -1)
+  assigns(memory_slice(sig, CRYPTO_BYTES))
+  assigns(state->nonce, state->status)
+  ensures(state->nonce <= NONCE_UB)
+  ensures(return_value == state->status)
+  ensures(return_value == 1 || return_value == 0 || return_value == -1)
+);
+
+#define crypto_sign_finish MLD_NAMESPACE(finish)
+/*************************************************
+ * Name:        crypto_sign_finish
+ *
+ * Description: Completes a resumable signing operation and wipes the
+ *              state. May be called at any point after
+ *              crypto_sign_start() to abort the operation.
+ *
+ * Arguments:   - uint8_t *sig:   pointer to signature (of length
+ *                                CRYPTO_BYTES), as passed to
+ *                                crypto_sign_step()
+ *              - size_t *siglen: pointer to output length of signature
+ *              - mld_sign_state *state: pointer to state
+ *
+ * Returns 0 if a signature has been found, and -1 otherwise. In the
+ * latter case, sig is zeroed and *siglen is set to 0.
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_finish(uint8_t *sig, size_t *siglen, mld_sign_state *state)
+__contract__(
+  requires(memory_no_alias(sig, CRYPTO_BYTES))
+  requires(memory_no_alias(siglen, sizeof(size_t)))
+  requires(memory_no_alias(state, sizeof(mld_sign_state)))
+  assigns(memory_slice(sig, CRYPTO_BYTES))
+  assigns(object_whole(siglen))
+  assigns(object_whole(state))
+  ensures((return_value == 0 && *siglen == CRYPTO_BYTES) ||
+          (return_value == -1 && *siglen == 0))
+);
+
 #define crypto_sign MLD_NAMESPACETOP
 /*************************************************
  * Name:        crypto_sign
@@ -215,6 +549,41 @@ __contract__(
           (return_value == -1))
 );
 
+#define crypto_sign_inplace MLD_NAMESPACE(inplace)
+/*************************************************
+ * Name:        crypto_sign_inplace
+ *
+ * Description: Same as crypto_sign(), but for a message that is already
+ *              in place at sm + CRYPTO_BYTES. Only the signature is written
+ *              to sm; the message is not moved.
+ *
+ * Arguments:   - uint8_t *sm: pointer to signed message (allocated array
+ *                             with CRYPTO_BYTES + mlen bytes, the message
+ *                             starting at offset CRYPTO_BYTES)
+ *              - size_t *smlen: pointer to output length of signed
+ *                               message
+ *              - size_t mlen: length of message
+ *              - const uint8_t *ctx: pointer to context string
+ *              - size_t ctxlen: length of context string
+ *              - const uint8_t *sk: pointer to bit-packed secret key
+ *
+ * Returns 0 (success) or -1 (context string too long OR nonce exhausted)
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_inplace(uint8_t *sm, size_t *smlen, size_t mlen,
+                        const uint8_t *ctx, size_t ctxlen, const uint8_t *sk)
+__contract__(
+  requires(mlen <= SIZE_MAX - CRYPTO_BYTES)
+  requires(memory_no_alias(sm, CRYPTO_BYTES + mlen))
+  requires(memory_no_alias(smlen, sizeof(size_t)))
+  requires(memory_no_alias(ctx, ctxlen))
+  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  assigns(memory_slice(sm, CRYPTO_BYTES))
+  assigns(object_whole(smlen))
+  ensures((return_value == 0 && *smlen == CRYPTO_BYTES + mlen) ||
+          (return_value == -1))
+);
+
 #define crypto_sign_verify_internal MLD_NAMESPACE(verify_internal)
 /*************************************************
  * Name:        crypto_sign_verify_internal
@@ -332,4 +701,268 @@ __contract__(
   ensures(return_value == 0 || return_value == -1)
 );
 
+#define crypto_sign_open_inplace MLD_NAMESPACE(open_inplace)
+/*************************************************
+ * Name:        crypto_sign_open_inplace
+ *
+ * Description: Same as crypto_sign_open(), but instead of copying the
+ *              message out of sm, returns its location within sm.
+ *
+ * Arguments:   - const uint8_t **m: pointer to output pointer to message,
+ *                                   set to sm + CRYPTO_BYTES on success
+ *                                   and to NULL otherwise
+ *              - size_t *mlen: pointer to output length of message
+ *              - const uint8_t *sm: pointer to signed message
+ *              - size_t smlen: length of signed message
+ *              - const uint8_t *ctx: pointer to context string
+ *              - size_t ctxlen: length of context string
+ *              - const uint8_t *pk: pointer to bit-packed public key
+ *
+ * Returns 0 if signed message could be verified correctly and -1 otherwise
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_open_inplace(const uint8_t **m, size_t *mlen,
+                             const uint8_t *sm, size_t smlen,
+                             const uint8_t *ctx, size_t ctxlen,
+                             const uint8_t *pk)
+__contract__(
+  requires(memory_no_alias(m, sizeof(uint8_t *)))
+  requires(memory_no_alias(mlen, sizeof(size_t)))
+  requires(memory_no_alias(sm, smlen))
+  requires(memory_no_alias(ctx, ctxlen))
+  requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
+  assigns(object_whole(m))
+  assigns(object_whole(mlen))
+  ensures((return_value == 0 && *m == sm + CRYPTO_BYTES &&
+           *mlen == smlen - CRYPTO_BYTES) ||
+          (return_value == -1 && *m == NULL && *mlen == 0))
+);
+
+#define crypto_sign_sig_precheck MLD_NAMESPACE(sig_precheck)
+/*************************************************
+ * Name:        crypto_sign_sig_precheck
+ *
+ * Description: Checks the encoding of a signature without a public key:
+ *              the length, the hint encoding (ordering of the indices,
+ *              their counts, and zero padding) and the infinity norm of
+ *              z. Neither the public key nor SHAKE is involved, so this
+ *              is much cheaper than crypto_sign_verify() and can be used
+ *              to drop malformed signatures early.
+ *
+ *              A signature passing this check may still be invalid; a
+ *              signature failing it is rejected by crypto_sign_verify()
+ *              for every public key and message.
+ *
+ * Arguments:   - const uint8_t *sig: pointer to input signature
+ *              - size_t siglen: length of signature
+ *
+ * Returns 0 if the signature is well-formed and -1 otherwise
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_sig_precheck(const uint8_t *sig, size_t siglen)
+__contract__(
+  requires(memory_no_alias(sig, siglen))
+  ensures(return_value == 0 || return_value == -1)
+);
+
+#define crypto_sign_expand_pk MLD_NAMESPACE(expand_pk)
+/*************************************************
+ * Name:        crypto_sign_expand_pk
+ *
+ * Description: Expands a public key into a form suitable for caching by
+ *              verifiers handling many signatures under the same key.
+ *
+ *              The expanded public key consists of the public key, its
+ *              hash tr = H(pk), and the matrix A in the compact 23-bit
+ *              packed format of mld_polyvec_matrix_pack(). The latter
+ *              takes MLDSA_POLYMAT_PACKEDBYTES bytes rather than
+ *              MLDSA_K * sizeof(mld_polyvecl) bytes for an unpacked matrix.
+ *
+ *              The format is implementation-specific and only intended for
+ *              use with crypto_sign_verify_expanded().
+ *
+ * Arguments:   - uint8_t *epk: pointer to output expanded public key
+ *                              (an already allocated array of
+ *                              CRYPTO_EXPANDEDPUBLICKEYBYTES bytes)
+ *              - const uint8_t *pk: pointer to bit-packed public key
+ *
+ * Returns 0. This function cannot fail: every byte string of
+ * CRYPTO_PUBLICKEYBYTES bytes is a valid public key encoding, so there is
+ * nothing to validate. The return value only keeps the API uniform.
+ **************************************************/
+int crypto_sign_expand_pk(uint8_t *epk, const uint8_t *pk)
+__contract__(
+  requires(memory_no_alias(epk, CRYPTO_EXPANDEDPUBLICKEYBYTES))
+  requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
+  assigns(object_whole(epk))
+  ensures(return_value == 0)
+);
+
+#define crypto_sign_verify_expanded MLD_NAMESPACE(verify_expanded)
+/*************************************************
+ * Name:        crypto_sign_verify_expanded
+ *
+ * Description: Same as crypto_sign_verify(), but using an expanded public
+ *              key computed by crypto_sign_expand_pk(). This skips the
+ *              hashing of the public key and the expansion of the matrix A.
+ *
+ * Arguments:   - const uint8_t *sig: pointer to input signature
+ *              - size_t siglen: length of signature
+ *              - const uint8_t *m: pointer to message
+ *              - size_t mlen: length of message
+ *              - const uint8_t *ctx: pointer to context string
+ *                                    May be NULL iff ctxlen == 0
+ *              - size_t ctxlen: length of context string
+ *              - const uint8_t *epk: pointer to expanded public key
+ *
+ * Returns 0 if signature could be verified correctly and -1 otherwise
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_verify_expanded(const uint8_t *sig, size_t siglen,
+                                const uint8_t *m, size_t mlen,
+                                const uint8_t *ctx, size_t ctxlen,
+                                const uint8_t *epk)
+__contract__(
+  requires(memory_no_alias(sig, siglen))
+  requires(memory_no_alias(m, mlen))
+  requires((ctx == NULL && ctxlen == 0) || memory_no_alias(ctx, ctxlen))
+  requires(memory_no_alias(epk, CRYPTO_EXPANDEDPUBLICKEYBYTES))
+  ensures(return_value == 0 || return_value == -1)
+);
+
+#define crypto_sign_signature_iov MLD_NAMESPACE(signature_iov)
+/*************************************************
+ * Name:        crypto_sign_signature_iov
+ *
+ * Description: Same as crypto_sign_signature(), but with the message given
+ *              as the concatenation of iovcnt segments. The segments are
+ *              absorbed into mu one after the other, so the message never
+ *              needs to be assembled in one buffer.
+ *
+ * Arguments:   - uint8_t *sig:   pointer to output signature (of length
+ *                                CRYPTO_BYTES)
+ *              - size_t *siglen: pointer to output length of signature
+ *              - const mld_iovec *iov: array of message segments. ptr may
+ *                                be NULL iff len == 0
+ *              - size_t iovcnt:  number of message segments
+ *              - uint8_t *ctx:   pointer to context string. May be NULL
+ *                                iff ctxlen == 0
+ *              - size_t ctxlen:  length of context string. Should be <= 255.
+ *              - uint8_t *sk:    pointer to bit-packed secret key
+ *
+ * Returns 0 (success) or -1 (context string too long OR nonce exhaustion)
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_signature_iov(uint8_t *sig, size_t *siglen,
+                              const mld_iovec *iov, size_t iovcnt,
+                              const uint8_t *ctx, size_t ctxlen,
+                              const uint8_t *sk)
+__contract__(
+  requires(memory_no_alias(sig, CRYPTO_BYTES))
+  requires(memory_no_alias(siglen, sizeof(size_t)))
+  requires(memory_no_alias(iov, iovcnt * sizeof(mld_iovec)))
+  requires(forall(k, 0, iovcnt, readable(iov[k].ptr, iov[k].len)))
+  requires((ctx == NULL && ctxlen == 0) || memory_no_alias(ctx, ctxlen))
+  requires(memory_no_alias(sk, CRYPTO_SECRETKEYBYTES))
+  assigns(memory_slice(sig, CRYPTO_BYTES))
+  assigns(object_whole(siglen))
+  ensures((return_value == 0 && *siglen == CRYPTO_BYTES) ||
+          (return_value == -1 && *siglen == 0))
+);
+
+#define crypto_sign_verify_iov MLD_NAMESPACE(verify_iov)
+/*************************************************
+ * Name:        crypto_sign_verify_iov
+ *
+ * Description: Same as crypto_sign_verify(), but with the message given
+ *              as the concatenation of iovcnt segments.
+ *
+ * Arguments:   - uint8_t *sig: pointer to input signature
+ *              - size_t siglen: length of signature
+ *              - const mld_iovec *iov: array of message segments. ptr may
+ *                                      be NULL iff len == 0
+ *              - size_t iovcnt: number of message segments
+ *              - const uint8_t *ctx: pointer to context string
+ *                                    May be NULL iff ctxlen == 0
+ *              - size_t ctxlen: length of context string
+ *              - const uint8_t *pk: pointer to bit-packed public key
+ *
+ * Returns 0 if signature could be verified correctly and -1 otherwise
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_verify_iov(const uint8_t *sig, size_t siglen,
+                           const mld_iovec *iov, size_t iovcnt,
+                           const uint8_t *ctx, size_t ctxlen,
+                           const uint8_t *pk)
+__contract__(
+  requires(memory_no_alias(sig, siglen))
+  requires(memory_no_alias(iov, iovcnt * sizeof(mld_iovec)))
+  requires(forall(k, 0, iovcnt, readable(iov[k].ptr, iov[k].len)))
+  requires((ctx == NULL && ctxlen == 0) || memory_no_alias(ctx, ctxlen))
+  requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
+  ensures(return_value == 0 || return_value == -1)
+);
+
+#define crypto_sign_mu_midstate MLD_NAMESPACE(mu_midstate)
+/*************************************************
+ * Name:        crypto_sign_mu_midstate
+ *
+ * Description: Computes tr = H(pk) and the SHAKE256 state after absorbing
+ *              it. This is the part of mu = H(tr || 0 || ctxlen || ctx || m)
+ *              that only depends on the key, and can be cached to compute
+ *              mu for many messages via crypto_sign_mu_from_midstate().
+ *
+ *              As tr is shorter than the SHAKE256 rate, absorbing it does
+ *              not permute the state yet. The saving is the hashing of the
+ *              public key, which otherwise precedes every computation of mu.
+ *
+ * Arguments:   - keccak_state *state: pointer to output state
+ *              - const uint8_t *pk: pointer to bit-packed public key
+ *
+ * Returns 0
+ **************************************************/
+int crypto_sign_mu_midstate(keccak_state *state, const uint8_t *pk)
+__contract__(
+  requires(memory_no_alias(state, sizeof(keccak_state)))
+  requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
+  assigns(memory_slice(state, sizeof(keccak_state)))
+  ensures(state->pos <= SHAKE256_RATE)
+  ensures(return_value == 0)
+);
+
+#define crypto_sign_mu_from_midstate MLD_NAMESPACE(mu_from_midstate)
+/*************************************************
+ * Name:        crypto_sign_mu_from_midstate
+ *
+ * Description: Computes mu = H(tr || 0 || ctxlen || ctx || m) for pure
+ *              ML-DSA, continuing from a state computed by
+ *              crypto_sign_mu_midstate(). The result can be passed to
+ *              crypto_sign_signature_extmu() and crypto_sign_verify_extmu().
+ *              The state is not modified.
+ *
+ * Arguments:   - uint8_t *mu: pointer to output mu (MLDSA_CRHBYTES bytes)
+ *              - const keccak_state *state: pointer to cached state
+ *              - const uint8_t *m: pointer to message
+ *              - size_t mlen: length of message
+ *              - const uint8_t *ctx: pointer to context string.
+ *                                    May be NULL iff ctxlen == 0
+ *              - size_t ctxlen: length of context string
+ *
+ * Returns 0 (success) or -1 (context string too long)
+ **************************************************/
+MLD_MUST_CHECK_RETURN_VALUE
+int crypto_sign_mu_from_midstate(uint8_t mu[MLDSA_CRHBYTES],
+                                 const keccak_state *state, const uint8_t *m,
+                                 size_t mlen, const uint8_t *ctx,
+                                 size_t ctxlen)
+__contract__(
+  requires(memory_no_alias(mu, MLDSA_CRHBYTES))
+  requires(memory_no_alias(state, sizeof(keccak_state)))
+  requires(state->pos <= SHAKE256_RATE)
+  requires(memory_no_alias(m, mlen))
+  requires((ctx == NULL && ctxlen == 0) || memory_no_alias(ctx, ctxlen))
+  assigns(memory_slice(mu, MLDSA_CRHBYTES))
+  ensures(return_value == 0 || return_value == -1)
+);
+
 #endif /* !MLD_SIGN_H */
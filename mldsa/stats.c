@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#include "common.h"
+
+#if defined(MLD_CONFIG_STATS)
+
+#include <string.h>
+#include "stats.h"
+
+/* The counters are thread-local, so that recording them requires neither
+ * locks nor atomics. */
+#if !defined(MLD_THREAD_LOCAL)
+#error No thread-local storage available for MLD_CONFIG_STATS.
+#endif
+
+static MLD_THREAD_LOCAL mld_sign_stats mld_stats;
+
+void mld_stats_reject(unsigned reason)
+{
+  mld_stats.attempts++;
+  if (reason < MLD_STATS_NUM_REJECTS)
+  {
+    mld_stats.rejects[reason]++;
+  }
+}
+
+void mld_stats_signature(unsigned attempts)
+{
+  unsigned bucket = attempts - 1;
+  if (attempts == 0)
+  {
+    return;
+  }
+  if (bucket >= MLD_STATS_MAX_ATTEMPTS)
+  {
+    bucket = MLD_STATS_MAX_ATTEMPTS - 1;
+  }
+
+  /* The rejected attempts have been counted by mld_stats_reject() */
+  mld_stats.attempts++;
+  mld_stats.signatures++;
+  mld_stats.last_attempts = attempts;
+  mld_stats.attempts_hist[bucket]++;
+}
+
+void mld_stats_xof_blocks(unsigned blocks)
+{
+  mld_stats.xof_extra_blocks += blocks;
+}
+
+void crypto_sign_stats_get(mld_sign_stats *stats) { *stats = mld_stats; }
+
+void crypto_sign_stats_reset(void)
+{
+  memset(&mld_stats, 0, sizeof(mld_stats));
+}
+
+#else /* MLD_CONFIG_STATS */
+
+MLD_EMPTY_CU(stats)
+
+#endif /* !MLD_CONFIG_STATS */
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#ifndef MLD_STATS_H
+#define MLD_STATS_H
+
+#include <stdint.h>
+#include "api_types.h"
+#include "common.h"
+
+#if defined(MLD_CONFIG_STATS)
+
+#define mld_stats_reject MLD_NAMESPACE(stats_reject)
+/*************************************************
+ * Name:        mld_stats_reject
+ *
+ * Description: Records a rejected signing attempt.
+ *
+ * Arguments:   - unsigned reason: one of MLD_STATS_REJECT_xxx
+ **************************************************/
+void mld_stats_reject(unsigned reason);
+
+#define mld_stats_signature MLD_NAMESPACE(stats_signature)
+/*************************************************
+ * Name:        mld_stats_signature
+ *
+ * Description: Records a successful signing operation.
+ *
+ * Arguments:   - unsigned attempts: number of attempts it took,
+ *                                   including the successful one
+ **************************************************/
+void mld_stats_signature(unsigned attempts);
+
+#define mld_stats_xof_blocks MLD_NAMESPACE(stats_xof_blocks)
+/*************************************************
+ * Name:        mld_stats_xof_blocks
+ *
+ * Description: Records XOF blocks squeezed in addition to the initial
+ *              estimate by a rejection sampler.
+ *
+ * Arguments:   - unsigned blocks: number of blocks
+ **************************************************/
+void mld_stats_xof_blocks(unsigned blocks);
+
+#define crypto_sign_stats_get MLD_NAMESPACE(stats_get)
+/*************************************************
+ * Name:        crypto_sign_stats_get
+ *
+ * Description: Returns the signing statistics of the calling thread,
+ *              accumulated since the thread started or since the last call
+ *              to crypto_sign_stats_reset().
+ *
+ * Arguments:   - mld_sign_stats *stats: pointer to output statistics
+ **************************************************/
+void crypto_sign_stats_get(mld_sign_stats *stats);
+
+#define crypto_sign_stats_reset MLD_NAMESPACE(stats_reset)
+/*************************************************
+ * Name:        crypto_sign_stats_reset
+ *
+ * Description: Resets the signing statistics of the calling thread.
+ **************************************************/
+void crypto_sign_stats_reset(void);
+
+#define MLD_STATS_REJECT(reason) mld_stats_reject(reason)
+#define MLD_STATS_SIGNATURE(attempts) mld_stats_signature(attempts)
+#define MLD_STATS_XOF_BLOCKS(blocks) mld_stats_xof_blocks(blocks)
+
+#else /* MLD_CONFIG_STATS */
+
+#define MLD_STATS_REJECT(reason) \
+  do                             \
+  {                              \
+  } while (0)
+#define MLD_STATS_SIGNATURE(attempts) \
+  do                                  \
+  {                                   \
+  } while (0)
+#define MLD_STATS_XOF_BLOCKS(blocks) \
+  do                                 \
+  {                                  \
+  } while (0)
+
+#endif /* !MLD_CONFIG_STATS */
+
+#endif /* !MLD_STATS_H */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#include "common.h"
+
+#if defined(MLD_SYS_X86_64_AVX2_DISPATCH) && \
+    !defined(MLD_CONFIG_MULTILEVEL_NO_SHARED)
+
+#include <stdint.h>
+
+static void mld_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t r[4])
+{
+  __asm__ __volatile__("cpuid"
+                       : "=a"(r[0]), "=b"(r[1]), "=c"(r[2]), "=d"(r[3])
+                       : "a"(leaf), "c"(subleaf));
+}
+
+static int mld_sys_detect_avx2(void)
+{
+  uint32_t r[4];
+  uint32_t xcr0_lo, xcr0_hi;
+  const uint32_t leaf1_ecx = (1u << 23) /* POPCNT */ |
+                             (1u << 27) /* OSXSAVE */ | (1u << 28) /* AVX */;
+  const uint32_t leaf7_ebx = (1u << 5) /* AVX2 */ | (1u << 8) /* BMI2 */;
+
+#if defined(MLD_CONFIG_RUNTIME_CPU_DISPATCH_FALLBACK_TEST)
+  if (mld_force_cpu_fallback())
+  {
+    return 0;
+  }
+#endif
+
+  mld_cpuid(0, 0, r);
+  if (r[0] < 7)
+  {
+    return 0;
+  }
+
+  mld_cpuid(1, 0, r);
+  if ((r[2] & leaf1_ecx) != leaf1_ecx)
+  {
+    return 0;
+  }
+
+  /* The OS must preserve the XMM and YMM registers (XCR0 bits 1 and 2) */
+  __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+  (void)xcr0_hi;
+  if ((xcr0_lo & 6) != 6)
+  {
+    return 0;
+  }
+
+  mld_cpuid(7, 0, r);
+  return (r[1] & leaf7_ebx) == leaf7_ebx;
+}
+
+/* 0: not yet detected, 1: AVX2 unavailable, 2: AVX2 available.
+ * Concurrent first calls may both run the detection, but they store the
+ * same value, so relaxed atomics suffice. */
+static int mld_sys_avx2_state = 0;
+
+int mld_sys_has_avx2(void)
+{
+  int state = __atomic_load_n(&mld_sys_avx2_state, __ATOMIC_RELAXED);
+  if (state == 0)
+  {
+    state = mld_sys_detect_avx2() ? 2 : 1;
+    __atomic_store_n(&mld_sys_avx2_state, state, __ATOMIC_RELAXED);
+  }
+  return state == 2;
+}
+
+#else /* MLD_SYS_X86_64_AVX2_DISPATCH && !MLD_CONFIG_MULTILEVEL_NO_SHARED */
+
+MLD_EMPTY_CU(sys)
+
+#endif /* !(MLD_SYS_X86_64_AVX2_DISPATCH && !MLD_CONFIG_MULTILEVEL_NO_SHARED) \
+        */
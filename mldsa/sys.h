@@ -42,6 +42,17 @@
 #endif
 #endif /* __x86_64__ */
 
+/* With MLD_CONFIG_RUNTIME_CPU_DISPATCH, the AVX2 backends are built even if
+ * the compiler does not target AVX2, and are selected at runtime. Functions
+ * using AVX2 intrinsics are then marked with MLD_TARGET_AVX2. */
+#if defined(MLD_SYS_X86_64) && !defined(MLD_SYS_X86_64_AVX2) && \
+    defined(MLD_CONFIG_RUNTIME_CPU_DISPATCH) && defined(MLD_HAVE_INLINE_ASM)
+#define MLD_SYS_X86_64_AVX2_DISPATCH
+#define MLD_TARGET_AVX2 __attribute__((target("avx2,bmi2,popcnt")))
+#else
+#define MLD_TARGET_AVX2
+#endif
+
 #if defined(MLD_SYS_LITTLE_ENDIAN) && defined(__powerpc64__)
 #define MLD_SYS_PPC64LE
 #endif
@@ -137,6 +148,17 @@
 #define MLD_ALIGN /* No known support for alignment constraints */
 #endif
 
+/* Thread-local storage, used by the optional statistics and operation
+ * counters. Left undefined if there is no known support. */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
+    !defined(__STDC_NO_THREADS__)
+#define MLD_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define MLD_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define MLD_THREAD_LOCAL __declspec(thread)
+#endif
+
 
 /* New X86_64 CPUs support Conflow-flow protection using the CET instructions.
  * When enabled (through -fcf-protection=), all compilation units (including
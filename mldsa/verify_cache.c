@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#include "common.h"
+
+#if defined(MLD_CONFIG_VERIFY_CACHE)
+
+#include <stdint.h>
+#include <string.h>
+#include "fips202/fips202.h"
+#include "verify_cache.h"
+
+/* Serialization of accesses to the cache. By default, a spinlock based on
+ * the GCC/clang __atomic builtins is used; see MLD_CONFIG_VERIFY_CACHE in
+ * config.h for how to provide a custom lock. */
+#if defined(MLD_CONFIG_VERIFY_CACHE_CUSTOM_LOCK)
+#define mld_verify_cache_lock() mld_verify_cache_lock_native()
+#define mld_verify_cache_unlock() mld_verify_cache_unlock_native()
+#elif defined(__GNUC__)
+static char mld_verify_cache_busy = 0;
+
+/* Spin-wait hint, telling the CPU that we are waiting for another core */
+static MLD_INLINE void mld_verify_cache_pause(void)
+{
+#if defined(MLD_SYS_X86_64)
+  __builtin_ia32_pause();
+#elif defined(MLD_SYS_AARCH64)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+static void mld_verify_cache_lock(void)
+{
+  while (__atomic_test_and_set(&mld_verify_cache_busy, __ATOMIC_ACQUIRE))
+  {
+    /* Only read the lock while it is taken, so that waiting threads do
+     * not keep pulling its cache line away from the owner. */
+    while (__atomic_load_n(&mld_verify_cache_busy, __ATOMIC_RELAXED))
+    {
+      mld_verify_cache_pause();
+    }
+  }
+}
+static void mld_verify_cache_unlock(void)
+{
+  __atomic_clear(&mld_verify_cache_busy, __ATOMIC_RELEASE);
+}
+#else /* !MLD_CONFIG_VERIFY_CACHE_CUSTOM_LOCK && __GNUC__ */
+#error No lock for the verification cache available. Please provide your own using MLD_CONFIG_VERIFY_CACHE_CUSTOM_LOCK.
+#endif /* !MLD_CONFIG_VERIFY_CACHE_CUSTOM_LOCK && !__GNUC__ */
+
+/* The cache is set-associative: it consists of MLD_VERIFY_CACHE_SETS sets
+ * of MLD_VERIFY_CACHE_WAYS entries each. Digests are uniformly random, so
+ * their leading bytes select the set, and a lookup only compares the
+ * entries of that set. Every set evicts with its own CLOCK hand. If
+ * MLD_CONFIG_VERIFY_CACHE_SIZE is not a multiple of the number of ways,
+ * the remaining entries are unused. */
+#if MLD_CONFIG_VERIFY_CACHE_SIZE < 8
+#define MLD_VERIFY_CACHE_WAYS MLD_CONFIG_VERIFY_CACHE_SIZE
+#else
+#define MLD_VERIFY_CACHE_WAYS 8
+#endif
+#define MLD_VERIFY_CACHE_SETS \
+  (MLD_CONFIG_VERIFY_CACHE_SIZE / MLD_VERIFY_CACHE_WAYS)
+
+typedef struct
+{
+  uint8_t digest[MLD_VERIFY_CACHE_DIGESTBYTES];
+  uint8_t valid;
+  uint8_t referenced;
+} mld_verify_cache_entry;
+
+typedef struct
+{
+  mld_verify_cache_entry ways[MLD_VERIFY_CACHE_WAYS];
+  unsigned hand;
+} mld_verify_cache_set;
+
+static mld_verify_cache_set mld_verify_cache[MLD_VERIFY_CACHE_SETS];
+
+/* Number of lookups served from the cache, and of those that were not */
+static uint64_t mld_verify_cache_hits = 0;
+static uint64_t mld_verify_cache_misses = 0;
+
+void mld_verify_cache_digest(uint8_t digest[MLD_VERIFY_CACHE_DIGESTBYTES],
+                             const uint8_t *sig, const uint8_t *m,
+                             size_t mlen, const uint8_t *pre, size_t prelen,
+                             const uint8_t *pk)
+{
+  keccak_state state;
+  shake256_init(&state);
+  shake256_absorb(&state, pk, CRYPTO_PUBLICKEYBYTES);
+  shake256_absorb(&state, sig, CRYPTO_BYTES);
+  shake256_absorb(&state, pre, prelen);
+  shake256_absorb(&state, m, mlen);
+  shake256_finalize(&state);
+  shake256_squeeze(digest, MLD_VERIFY_CACHE_DIGESTBYTES, &state);
+  shake256_release(&state);
+}
+
+/* Returns the set a digest belongs to */
+static mld_verify_cache_set *mld_verify_cache_set_of(
+    const uint8_t digest[MLD_VERIFY_CACHE_DIGESTBYTES])
+{
+  uint32_t idx = (uint32_t)digest[0] | ((uint32_t)digest[1] << 8) |
+                 ((uint32_t)digest[2] << 16) | ((uint32_t)digest[3] << 24);
+  return &mld_verify_cache[idx % MLD_VERIFY_CACHE_SETS];
+}
+
+int mld_verify_cache_lookup(const uint8_t digest[MLD_VERIFY_CACHE_DIGESTBYTES])
+{
+  mld_verify_cache_set *set = mld_verify_cache_set_of(digest);
+  unsigned i;
+  int found = 0;
+
+  mld_verify_cache_lock();
+  for (i = 0; i < MLD_VERIFY_CACHE_WAYS; i++)
+  __loop__(
+    invariant(i <= MLD_VERIFY_CACHE_WAYS)
+  )
+  {
+    if (set->ways[i].valid &&
+        memcmp(set->ways[i].digest, digest,
+               MLD_VERIFY_CACHE_DIGESTBYTES) == 0)
+    {
+      set->ways[i].referenced = 1;
+      found = 1;
+      break;
+    }
+  }
+  if (found)
+  {
+    mld_verify_cache_hits++;
+  }
+  else
+  {
+    mld_verify_cache_misses++;
+  }
+  mld_verify_cache_unlock();
+
+  return found;
+}
+
+void mld_verify_cache_insert(const uint8_t digest[MLD_VERIFY_CACHE_DIGESTBYTES])
+{
+  mld_verify_cache_set *set = mld_verify_cache_set_of(digest);
+  mld_verify_cache_entry *e;
+
+  mld_verify_cache_lock();
+
+  /* Advance the hand of the set past recently used entries, clearing their
+   * reference bits. This terminates after at most one full round. */
+  while (1)
+  __loop__(
+    invariant(set->hand < MLD_VERIFY_CACHE_WAYS)
+  )
+  {
+    e = &set->ways[set->hand];
+    set->hand = (set->hand + 1) % MLD_VERIFY_CACHE_WAYS;
+    if (!e->valid || !e->referenced)
+    {
+      break;
+    }
+    e->referenced = 0;
+  }
+
+  memcpy(e->digest, digest, MLD_VERIFY_CACHE_DIGESTBYTES);
+  e->valid = 1;
+  e->referenced = 0;
+
+  mld_verify_cache_unlock();
+}
+
+void crypto_sign_verify_cache_clear(void)
+{
+  mld_verify_cache_lock();
+  memset(mld_verify_cache, 0, sizeof(mld_verify_cache));
+  mld_verify_cache_hits = 0;
+  mld_verify_cache_misses = 0;
+  mld_verify_cache_unlock();
+}
+
+void crypto_sign_verify_cache_counters(uint64_t *hits, uint64_t *misses)
+{
+  mld_verify_cache_lock();
+  *hits = mld_verify_cache_hits;
+  *misses = mld_verify_cache_misses;
+  mld_verify_cache_unlock();
+}
+
+#else /* MLD_CONFIG_VERIFY_CACHE */
+
+MLD_EMPTY_CU(verify_cache)
+
+#endif /* !MLD_CONFIG_VERIFY_CACHE */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#ifndef MLD_VERIFY_CACHE_H
+#define MLD_VERIFY_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+
+#if defined(MLD_CONFIG_VERIFY_CACHE)
+
+#if !defined(MLD_CONFIG_VERIFY_CACHE_SIZE)
+#define MLD_CONFIG_VERIFY_CACHE_SIZE 256
+#endif
+
+#if MLD_CONFIG_VERIFY_CACHE_SIZE < 1 || MLD_CONFIG_VERIFY_CACHE_SIZE > 65536
+#error MLD_CONFIG_VERIFY_CACHE_SIZE must be between 1 and 65536
+#endif
+
+/* Size of the digest identifying a verified (pk, sig, ctx, m) tuple */
+#define MLD_VERIFY_CACHE_DIGESTBYTES 32
+
+#define mld_verify_cache_digest MLD_NAMESPACE(verify_cache_digest)
+/*************************************************
+ * Name:        mld_verify_cache_digest
+ *
+ * Description: Computes the cache key of a verification,
+ *              SHAKE256(pk || sig || pre || m). As pk and sig have fixed
+ *              length and pre = (0, ctxlen, ctx) encodes its own length,
+ *              the encoding is unambiguous.
+ *
+ * Arguments:   - uint8_t digest[]: output digest
+ *              - const uint8_t *sig: pointer to signature (CRYPTO_BYTES)
+ *              - const uint8_t *m: pointer to message
+ *              - size_t mlen: length of message
+ *              - const uint8_t *pre: pointer to prefix
+ *              - size_t prelen: length of prefix
+ *              - const uint8_t *pk: pointer to bit-packed public key
+ **************************************************/
+void mld_verify_cache_digest(uint8_t digest[MLD_VERIFY_CACHE_DIGESTBYTES],
+                             const uint8_t *sig, const uint8_t *m,
+                             size_t mlen, const uint8_t *pre, size_t prelen,
+                             const uint8_t *pk)
+__contract__(
+  requires(memory_no_alias(digest, MLD_VERIFY_CACHE_DIGESTBYTES))
+  requires(memory_no_alias(sig, CRYPTO_BYTES))
+  requires(memory_no_alias(m, mlen))
+  requires(memory_no_alias(pre, prelen))
+  requires(memory_no_alias(pk, CRYPTO_PUBLICKEYBYTES))
+  assigns(memory_slice(digest, MLD_VERIFY_CACHE_DIGESTBYTES))
+);
+
+#define mld_verify_cache_lookup MLD_NAMESPACE(verify_cache_lookup)
+/*************************************************
+ * Name:        mld_verify_cache_lookup
+ *
+ * Description: Looks up a digest in the cache of successful verifications
+ *              and marks the entry as recently used.
+ *
+ * Arguments:   - const uint8_t digest[]: digest to look up
+ *
+ * Returns 1 if the digest is cached, and 0 otherwise
+ **************************************************/
+int mld_verify_cache_lookup(const uint8_t digest[MLD_VERIFY_CACHE_DIGESTBYTES])
+__contract__(
+  requires(memory_no_alias(digest, MLD_VERIFY_CACHE_DIGESTBYTES))
+  ensures(return_value == 0 || return_value == 1)
+);
+
+#define mld_verify_cache_insert MLD_NAMESPACE(verify_cache_insert)
+/*************************************************
+ * Name:        mld_verify_cache_insert
+ *
+ * Description: Adds a digest to the cache of successful verifications.
+ *              If the set selected by the digest is full, one of its
+ *              entries is evicted using the CLOCK (second chance) policy.
+ *
+ * Arguments:   - const uint8_t digest[]: digest to insert
+ **************************************************/
+void mld_verify_cache_insert(const uint8_t digest[MLD_VERIFY_CACHE_DIGESTBYTES])
+__contract__(
+  requires(memory_no_alias(digest, MLD_VERIFY_CACHE_DIGESTBYTES))
+);
+
+#define crypto_sign_verify_cache_clear MLD_NAMESPACE(verify_cache_clear)
+/*************************************************
+ * Name:        crypto_sign_verify_cache_clear
+ *
+ * Description: Removes all entries from the verification cache, e.g. after
+ *              a public key has been revoked, and resets its counters.
+ **************************************************/
+void crypto_sign_verify_cache_clear(void);
+
+#define crypto_sign_verify_cache_counters MLD_NAMESPACE(verify_cache_counters)
+/*************************************************
+ * Name:        crypto_sign_verify_cache_counters
+ *
+ * Description: Returns the number of verifications of a signature of
+ *              CRYPTO_BYTES bytes that were served from the cache (hits)
+ *              and that were not (misses), since the last call to
+ *              crypto_sign_verify_cache_clear().
+ *
+ * Arguments:   - uint64_t *hits: output number of cache hits
+ *              - uint64_t *misses: output number of cache misses
+ **************************************************/
+void crypto_sign_verify_cache_counters(uint64_t *hits, uint64_t *misses)
+__contract__(
+  requires(memory_no_alias(hits, sizeof(uint64_t)))
+  requires(memory_no_alias(misses, sizeof(uint64_t)))
+  assigns(memory_slice(hits, sizeof(uint64_t)))
+  assigns(memory_slice(misses, sizeof(uint64_t)))
+);
+
+#endif /* MLD_CONFIG_VERIFY_CACHE */
+
+#endif /* !MLD_VERIFY_CACHE_H */
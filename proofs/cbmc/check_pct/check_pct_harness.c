@@ -5,10 +5,11 @@
 #include "sign.h"
 
 int mld_check_pct(uint8_t const pk[CRYPTO_PUBLICKEYBYTES],
-                  uint8_t const sk[CRYPTO_SECRETKEYBYTES]);
+                  const mld_sign_ctx *sctx);
 
 void harness(void)
 {
-  uint8_t *a, *b;
-  mld_check_pct(a, b);
+  uint8_t *a;
+  mld_sign_ctx *sctx;
+  mld_check_pct(a, sctx);
 }
@@ -0,0 +1,16 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void harness(void)
+{
+  uint8_t *sm;
+  size_t *smlen;
+  size_t mlen;
+  const uint8_t *ctx;
+  size_t ctxlen;
+  const uint8_t *sk;
+
+  crypto_sign_inplace(sm, smlen, mlen, ctx, ctxlen, sk);
+}
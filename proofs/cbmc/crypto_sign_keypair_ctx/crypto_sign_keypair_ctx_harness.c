@@ -0,0 +1,11 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void harness(void)
+{
+  uint8_t *pk, *sk;
+  mld_sign_ctx *sctx;
+  crypto_sign_keypair_ctx(pk, sk, sctx);
+}
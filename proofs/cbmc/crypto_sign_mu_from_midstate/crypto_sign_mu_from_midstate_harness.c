@@ -0,0 +1,16 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void harness(void)
+{
+  uint8_t *mu;
+  keccak_state *state;
+  uint8_t *m;
+  size_t mlen;
+  uint8_t *ctx;
+  size_t ctxlen;
+  int r;
+  r = crypto_sign_mu_from_midstate(mu, state, m, mlen, ctx, ctxlen);
+}
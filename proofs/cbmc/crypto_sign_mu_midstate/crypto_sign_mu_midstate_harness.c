@@ -0,0 +1,12 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void harness(void)
+{
+  keccak_state *state;
+  uint8_t *pk;
+  int r;
+  r = crypto_sign_mu_midstate(state, pk);
+}
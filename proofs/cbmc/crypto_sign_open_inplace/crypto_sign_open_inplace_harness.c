@@ -0,0 +1,17 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void harness(void)
+{
+  const uint8_t **m;
+  size_t *mlen;
+  const uint8_t *sm;
+  size_t smlen;
+  const uint8_t *ctx;
+  size_t ctxlen;
+  const uint8_t *pk;
+
+  crypto_sign_open_inplace(m, mlen, sm, smlen, ctx, ctxlen, pk);
+}
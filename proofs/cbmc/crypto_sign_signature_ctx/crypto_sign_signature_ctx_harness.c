@@ -0,0 +1,16 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void harness(void)
+{
+  uint8_t *sig;
+  size_t *siglen;
+  uint8_t *m;
+  size_t mlen;
+  uint8_t *ctx;
+  size_t ctxlen;
+  mld_sign_ctx *sctx;
+  crypto_sign_signature_ctx(sig, siglen, m, mlen, ctx, ctxlen, sctx);
+}
@@ -0,0 +1,16 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void harness(void)
+{
+  mld_sign_state *state;
+  uint8_t *m;
+  size_t mlen;
+  uint8_t *ctx;
+  size_t ctxlen;
+  uint8_t *sk;
+  int r;
+  r = crypto_sign_start(state, m, mlen, ctx, ctxlen, sk);
+}
@@ -0,0 +1,13 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void harness(void)
+{
+  uint8_t *sig;
+  mld_sign_state *state;
+  unsigned int max_attempts;
+  int r;
+  r = crypto_sign_step(sig, state, max_attempts);
+}
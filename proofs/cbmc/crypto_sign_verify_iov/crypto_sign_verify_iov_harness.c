@@ -0,0 +1,17 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void harness(void)
+{
+  uint8_t *sig;
+  size_t siglen;
+  mld_iovec *iov;
+  size_t iovcnt;
+  uint8_t *ctx;
+  size_t ctxlen;
+  uint8_t *pk;
+  int r;
+  r = crypto_sign_verify_iov(sig, siglen, iov, iovcnt, ctx, ctxlen, pk);
+}
@@ -3,10 +3,15 @@
 
 #include "sign.h"
 
+/* Defined locally in sign.c */
+struct mld_sign_matrix;
+struct mld_sign_attempt_ws;
+
 int mld_attempt_signature_generation(
     uint8_t *sig, const uint8_t *mu, const uint8_t rhoprime[MLDSA_CRHBYTES],
-    uint16_t nonce, const mld_polyvecl mat[MLDSA_K], const mld_polyvecl *s1,
-    const mld_polyveck *s2, const mld_polyveck *t0);
+    uint16_t nonce, const struct mld_sign_matrix *mat,
+    const mld_polyvecl *s1, const mld_polyveck *s2, const mld_polyveck *t0,
+    struct mld_sign_attempt_ws *ws);
 
 void harness(void)
 {
@@ -14,12 +19,13 @@ void harness(void)
   uint8_t *mu;
   uint8_t *rhoprime;
   uint16_t nonce;
-  mld_polyvecl *mat;
+  struct mld_sign_matrix *mat;
   mld_polyvecl *s1;
   mld_polyveck *s2;
   mld_polyveck *t0;
+  struct mld_sign_attempt_ws *ws;
 
   int r;
   r = mld_attempt_signature_generation(sig, mu, rhoprime, nonce, mat, s1, s2,
-                                       t0);
+                                       t0, ws);
 }
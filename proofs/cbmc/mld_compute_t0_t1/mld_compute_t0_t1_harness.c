@@ -0,0 +1,18 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+static void mld_compute_t0_t1(mld_polyveck *t1, mld_polyveck *t0,
+                              const mld_sign_matrix *mat,
+                              const mld_polyvecl *s1hat,
+                              const mld_polyveck *s2);
+
+void harness(void)
+{
+  mld_polyveck *t1, *t0, *s2;
+  mld_polyvecl *s1hat;
+  mld_sign_matrix *mat;
+
+  mld_compute_t0_t1(t1, t0, mat, s1hat, s2);
+}
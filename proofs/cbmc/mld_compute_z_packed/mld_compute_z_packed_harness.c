@@ -0,0 +1,20 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+int mld_compute_z_packed(uint8_t *sig, const mld_poly *cp,
+                         const mld_polyvecl *s1, const uint8_t *y_packed,
+                         mld_poly *zi, mld_poly *yi);
+
+void harness(void)
+{
+  uint8_t *sig;
+  mld_poly *cp;
+  mld_polyvecl *s1;
+  uint8_t *y_packed;
+  mld_poly *zi, *yi;
+
+  int r;
+  r = mld_compute_z_packed(sig, cp, s1, y_packed, zi, yi);
+}
@@ -0,0 +1,20 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+/* Defined locally in sign.c */
+struct mld_keypair_ws;
+
+static void mld_keypair_compute(uint8_t *pk, uint8_t *sk,
+                                const uint8_t seed[MLDSA_SEEDBYTES],
+                                mld_sign_matrix *mat,
+                                struct mld_keypair_ws *ws);
+
+void harness(void)
+{
+  uint8_t *pk, *sk, *seed;
+  mld_sign_matrix *mat;
+  struct mld_keypair_ws *ws;
+  mld_keypair_compute(pk, sk, seed, mat, ws);
+}
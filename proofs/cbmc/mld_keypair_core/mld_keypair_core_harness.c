@@ -0,0 +1,15 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+static int mld_keypair_core(uint8_t *pk, uint8_t *sk,
+                            const uint8_t seed[MLDSA_SEEDBYTES],
+                            mld_sign_ctx *sctx);
+
+void harness(void)
+{
+  uint8_t *pk, *sk, *seed;
+  mld_sign_ctx *sctx;
+  mld_keypair_core(pk, sk, seed, sctx);
+}
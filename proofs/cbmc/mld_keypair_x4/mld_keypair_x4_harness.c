@@ -0,0 +1,12 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+static int mld_keypair_x4(uint8_t *pks, uint8_t *sks, const uint8_t *seeds);
+
+void harness(void)
+{
+  uint8_t *pks, *sks, *seeds;
+  mld_keypair_x4(pks, sks, seeds);
+}
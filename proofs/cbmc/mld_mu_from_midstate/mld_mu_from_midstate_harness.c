@@ -0,0 +1,20 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+static void mld_mu_from_midstate(uint8_t mu[MLDSA_CRHBYTES],
+                                 const keccak_state *state,
+                                 const uint8_t *pre, size_t prelen,
+                                 const uint8_t *m, size_t mlen);
+
+void harness(void)
+{
+  uint8_t *mu;
+  keccak_state *state;
+  uint8_t *pre;
+  size_t prelen;
+  uint8_t *m;
+  size_t mlen;
+  mld_mu_from_midstate(mu, state, pre, prelen, m, mlen);
+}
@@ -0,0 +1,20 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+static void mld_mu_from_midstate_iov(uint8_t mu[MLDSA_CRHBYTES],
+                                     const keccak_state *state,
+                                     const uint8_t *pre, size_t prelen,
+                                     const mld_iovec *iov, size_t iovcnt);
+
+void harness(void)
+{
+  uint8_t *mu;
+  keccak_state *state;
+  uint8_t *pre;
+  size_t prelen;
+  mld_iovec *iov;
+  size_t iovcnt;
+  mld_mu_from_midstate_iov(mu, state, pre, prelen, iov, iovcnt);
+}
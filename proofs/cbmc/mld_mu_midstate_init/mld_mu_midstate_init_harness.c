@@ -0,0 +1,14 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+static void mld_mu_midstate_init(keccak_state *state,
+                                 const uint8_t tr[MLDSA_TRBYTES]);
+
+void harness(void)
+{
+  keccak_state *state;
+  uint8_t *tr;
+  mld_mu_midstate_init(state, tr);
+}
@@ -0,0 +1,15 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+void mld_prepare_pre(uint8_t pre[257], const uint8_t *ctx, size_t ctxlen);
+
+void harness(void)
+{
+  uint8_t *pre;
+  const uint8_t *ctx;
+  size_t ctxlen;
+
+  mld_prepare_pre(pre, ctx, ctxlen);
+}
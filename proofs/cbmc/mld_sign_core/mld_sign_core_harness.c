@@ -0,0 +1,23 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+static int mld_sign_core(uint8_t *sig, size_t *siglen, const uint8_t *m,
+                         size_t mlen, const uint8_t *pre, size_t prelen,
+                         const uint8_t rnd[MLDSA_RNDBYTES],
+                         const mld_sign_ctx *sctx, int externalmu);
+
+void harness(void)
+{
+  uint8_t *sig;
+  size_t *siglen;
+  uint8_t *m;
+  size_t mlen;
+  uint8_t *pre;
+  size_t prelen;
+  uint8_t *rnd;
+  mld_sign_ctx *sctx;
+  int externalmu;
+  mld_sign_core(sig, siglen, m, mlen, pre, prelen, rnd, sctx, externalmu);
+}
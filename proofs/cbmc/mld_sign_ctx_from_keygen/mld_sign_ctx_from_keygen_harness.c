@@ -0,0 +1,17 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+/* Defined locally in sign.c */
+struct mld_keypair_ws;
+
+static void mld_sign_ctx_from_keygen(mld_sign_ctx *sctx,
+                                     const struct mld_keypair_ws *ws);
+
+void harness(void)
+{
+  mld_sign_ctx *sctx;
+  const struct mld_keypair_ws *ws;
+  mld_sign_ctx_from_keygen(sctx, ws);
+}
@@ -0,0 +1,14 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+static void mld_sign_ctx_init(mld_sign_ctx *sctx,
+                              const uint8_t sk[CRYPTO_SECRETKEYBYTES]);
+
+void harness(void)
+{
+  mld_sign_ctx *sctx;
+  uint8_t *sk;
+  mld_sign_ctx_init(sctx, sk);
+}
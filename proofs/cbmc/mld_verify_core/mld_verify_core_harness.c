@@ -0,0 +1,27 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "sign.h"
+
+int mld_verify_core(const uint8_t *sig, size_t siglen, const uint8_t *m,
+                    size_t mlen, const uint8_t *pre, size_t prelen,
+                    const uint8_t *tr, const uint8_t *pk,
+                    const uint8_t *packed_mat, int externalmu);
+
+void harness(void)
+{
+  const uint8_t *sig;
+  size_t siglen;
+  const uint8_t *m;
+  size_t mlen;
+  const uint8_t *pre;
+  size_t prelen;
+  const uint8_t *tr;
+  const uint8_t *pk;
+  const uint8_t *packed_mat;
+  int externalmu;
+  int r;
+
+  r = mld_verify_core(sig, siglen, m, mlen, pre, prelen, tr, pk, packed_mat,
+                      externalmu);
+}
@@ -0,0 +1,13 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "packing.h"
+
+
+void harness(void)
+{
+  uint8_t *a, *b;
+  mld_polyveck *h;
+  unsigned int nh;
+  mld_pack_sig_c_h(a, b, h, nh);
+}
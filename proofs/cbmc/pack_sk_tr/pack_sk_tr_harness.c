@@ -0,0 +1,10 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "packing.h"
+
+void harness(void)
+{
+  uint8_t *sk, *tr;
+  mld_pack_sk_tr(sk, tr);
+}
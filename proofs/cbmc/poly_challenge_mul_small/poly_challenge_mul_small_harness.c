@@ -0,0 +1,11 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "poly.h"
+
+void harness(void)
+{
+  mld_poly *r, *c;
+  mld_poly_small *s;
+  mld_poly_challenge_mul_small(r, c, s);
+}
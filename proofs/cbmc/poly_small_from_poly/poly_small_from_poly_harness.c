@@ -0,0 +1,11 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "poly.h"
+
+void harness(void)
+{
+  mld_poly_small *r;
+  mld_poly *a;
+  mld_poly_small_from_poly(r, a);
+}
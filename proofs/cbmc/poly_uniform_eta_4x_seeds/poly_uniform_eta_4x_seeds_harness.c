@@ -0,0 +1,12 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "poly.h"
+
+void harness(void)
+{
+  mld_poly *r0, *r1, *r2, *r3;
+  uint8_t(*extseed)[MLD_ALIGN_UP(MLDSA_CRHBYTES + 2)];
+
+  mld_poly_uniform_eta_4x_seeds(r0, r1, r2, r3, extseed);
+}
@@ -0,0 +1,11 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "poly.h"
+
+void harness(void)
+{
+  mld_poly *w, *v;
+  uint8_t *a;
+  mld_polya_pointwise_acc_montgomery(w, a, v);
+}
@@ -0,0 +1,13 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "poly.h"
+
+void mld_polya_unpack_8x(int32_t r[8], const uint8_t a[23]);
+
+void harness(void)
+{
+  int32_t *r;
+  uint8_t *a;
+  mld_polya_unpack_8x(r, a);
+}
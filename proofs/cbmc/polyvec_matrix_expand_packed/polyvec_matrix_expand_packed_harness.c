@@ -0,0 +1,11 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "polyvec.h"
+
+void harness(void)
+{
+  uint8_t *r;
+  uint8_t *rho;
+  mld_polyvec_matrix_expand_packed(r, rho);
+}
@@ -0,0 +1,12 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "polyvec.h"
+
+void harness(void)
+{
+  mld_polyvecl *row;
+  uint8_t *rho;
+  unsigned int i;
+  mld_polyvec_matrix_expand_row(row, rho, i);
+}
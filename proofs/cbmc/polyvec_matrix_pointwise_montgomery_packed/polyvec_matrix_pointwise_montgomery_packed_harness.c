@@ -0,0 +1,12 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "polyvec.h"
+
+void harness(void)
+{
+  mld_polyveck *t;
+  uint8_t *mat;
+  mld_polyvecl *v;
+  mld_polyvec_matrix_pointwise_montgomery_packed(t, mat, v);
+}
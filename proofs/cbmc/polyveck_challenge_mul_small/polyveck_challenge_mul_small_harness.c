@@ -0,0 +1,12 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "polyvec.h"
+
+void harness(void)
+{
+  mld_polyveck *r;
+  mld_poly *c;
+  mld_polyveck_small *s;
+  mld_polyveck_challenge_mul_small(r, c, s);
+}
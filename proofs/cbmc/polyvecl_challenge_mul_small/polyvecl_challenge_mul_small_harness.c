@@ -0,0 +1,12 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "polyvec.h"
+
+void harness(void)
+{
+  mld_polyvecl *r;
+  mld_poly *c;
+  mld_polyvecl_small *s;
+  mld_polyvecl_challenge_mul_small(r, c, s);
+}
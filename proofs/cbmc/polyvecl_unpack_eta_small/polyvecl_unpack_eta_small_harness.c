@@ -0,0 +1,11 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "polyvec.h"
+
+void harness(void)
+{
+  mld_polyvecl_small *a;
+  uint8_t *b;
+  mld_polyvecl_unpack_eta_small(a, b);
+}
@@ -0,0 +1,13 @@
+// Copyright (c) The mldsa-native project authors
+// SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+
+#include "packing.h"
+
+void harness(void)
+{
+  uint8_t *rho, *tr, *key, *sk;
+  mld_polyveck *t0;
+  mld_polyvecl_small *s1;
+  mld_polyveck_small *s2;
+  mld_unpack_sk_small(rho, tr, key, t0, s1, s2, sk);
+}
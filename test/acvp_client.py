@@ -6,8 +6,15 @@
 # Processes 'internalProjection.json' files from
 # https://github.com/usnistgov/ACVP-Server/blob/master/gen-val/json-files
 #
-# Invokes `acvp_mldsa{lvl}` under the hood.
+# Invokes `acvp_mldsa{lvl} batch` under the hood, once per parameter set,
+# which runs all test cases of that parameter set in-process.
+#
+# Usage: acvp_client.py [--jobs N]
+#
+# --jobs N: number of worker threads of `acvp_mldsa{lvl} batch`
+#           (default: number of CPUs)
 
+import argparse
 import os
 import json
 import sys
@@ -53,51 +60,33 @@ def get_acvp_binary(tg):
     return f"{basedir}/{acvp_bin}"
 
 
-def run_keyGen_test(tg, tc):
-    info(f"Running keyGen test case {tc['tcId']} ... ", end="")
-    acvp_bin = get_acvp_binary(tg)
+def keyGen_case(tg, tc):
+    """Returns the input line and expected results of a keyGen test case."""
     assert tg["testType"] == "AFT"
-    acvp_call = exec_prefix + [
-        acvp_bin,
-        "keyGen",
-        f"seed={tc['seed']}",
-    ]
-    result = subprocess.run(acvp_call, encoding="utf-8", capture_output=True)
-    if result.returncode != 0:
-        err("FAIL!")
-        err(f"{acvp_call} failed with error code {result.returncode}")
-        err(result.stderr)
-        exit(1)
-    # Extract results and compare to expected data
-    for l in result.stdout.splitlines():
-        (k, v) = l.split("=")
-        if v != tc[k]:
-            err("FAIL!")
-            err(f"Mismatching result for {k}: expected {tc[k]}, got {v}")
-            exit(1)
-    info("OK")
-
+    line = f"keyGen seed={tc['seed']}"
+    return line, {"pk": tc["pk"], "sk": tc["sk"]}
 
-def run_sigGen_test(tg, tc):
-    info(f"Running sigGen test case {tc['tcId']} ... ", end="")
-    acvp_bin = get_acvp_binary(tg)
-
-    assert tg["testType"] == "AFT"
 
+def skip_sig_case(tg):
+    """Returns the reason for skipping a sigGen/sigVer test group, or None."""
     # TODO: implement pre-hashing mode
     if tg["preHash"] != "pure":
-        info("SKIP preHash")
-        return
+        return "preHash"
 
     # TODO: implement internal interface
     if tg["signatureInterface"] != "external":
-        info("SKIP internal")
-        return
+        return "internal"
 
     # TODO: implement external-mu mode
     if tg["externalMu"] is True:
-        info("SKIP externalMu")
-        return
+        return "externalMu"
+
+    return None
+
+
+def sigGen_case(tg, tc):
+    """Returns the input line and expected results of a sigGen test case."""
+    assert tg["testType"] == "AFT"
 
     # TODO: probably we want to handle handle the deterministic case differently
     if tg["deterministic"] is True:
@@ -107,80 +96,85 @@ def run_sigGen_test(tg, tc):
     assert len(tc["context"]) <= 2 * 255
     assert len(tc["message"]) <= 2 * 65536
 
-    acvp_call = exec_prefix + [
-        acvp_bin,
-        "sigGen",
-        f"message={tc['message']}",
-        f"rnd={tc['rnd']}",
-        f"sk={tc['sk']}",
-        f"context={tc['context']}",
-    ]
-    result = subprocess.run(acvp_call, encoding="utf-8", capture_output=True)
-    if result.returncode != 0:
-        err("FAIL!")
-        err(f"{acvp_call} failed with error code {result.returncode}")
-        err(result.stderr)
-        exit(1)
-    # Extract results and compare to expected data
-    for l in result.stdout.splitlines():
-        (k, v) = l.split("=")
-        if v != tc[k]:
-            err("FAIL!")
-            err(f"Mismatching result for {k}: expected {tc[k]}, got {v}")
-            exit(1)
-    info("OK")
-
+    line = (
+        f"sigGen message={tc['message']} rnd={tc['rnd']} "
+        f"sk={tc['sk']} context={tc['context']}"
+    )
+    return line, {"signature": tc["signature"]}
 
-def run_sigVer_test(tg, tc):
-    info(f"Running sigVer test case {tc['tcId']} ... ", end="")
-    acvp_bin = get_acvp_binary(tg)
-
-    # TODO: implement pre-hashing mode
-    if tg["preHash"] != "pure":
-        info("SKIP preHash")
-        return
-
-    # TODO: implement internal interface
-    if tg["signatureInterface"] != "external":
-        info("SKIP internal")
-        return
-
-    # TODO: implement external-mu mode
-    if tg["externalMu"] is True:
-        info("SKIP externalMu")
-        return
 
+def sigVer_case(tg, tc):
+    """Returns the input line and expected results of a sigVer test case."""
     assert tc["hashAlg"] == "none"
     assert len(tc["context"]) <= 2 * 255
     assert len(tc["message"]) <= 2 * 65536
 
-    acvp_call = exec_prefix + [
-        acvp_bin,
-        "sigVer",
-        f"message={tc['message']}",
-        f"context={tc['context']}",
-        f"signature={tc['signature']}",
-        f"pk={tc['pk']}",
-    ]
-    result = subprocess.run(acvp_call, encoding="utf-8", capture_output=True)
-
-    if (result.returncode == 0) != tc["testPassed"]:
-        err("FAIL!")
-        err(
-            f"Mismatching verification result: expected {tc['testPassed']}, got {result.returncode == 0}"
-        )
+    line = (
+        f"sigVer message={tc['message']} context={tc['context']} "
+        f"signature={tc['signature']} pk={tc['pk']}"
+    )
+    return line, {"testPassed": "true" if tc["testPassed"] else "false"}
+
+
+def collect_cases():
+    """Groups the test cases by ACVP binary, as lists of
+    (name, input line, expected results)."""
+    cases = {}
+
+    def add(kind, data, make_case, skip=None):
+        for tg in data["testGroups"]:
+            reason = skip(tg) if skip is not None else None
+            for tc in tg["tests"]:
+                name = f"{kind} test case {tc['tcId']}"
+                if reason is not None:
+                    info(f"Running {name} ... SKIP {reason}")
+                    continue
+                line, expected = make_case(tg, tc)
+                cases.setdefault(get_acvp_binary(tg), []).append(
+                    (name, line, expected)
+                )
+
+    add("keyGen", acvp_keygen_data, keyGen_case)
+    add("sigGen", acvp_sigGen_data, sigGen_case, skip_sig_case)
+    add("sigVer", acvp_sigVer_data, sigVer_case, skip_sig_case)
+    return cases
+
+
+def run_batch(acvp_bin, cases, jobs):
+    acvp_call = exec_prefix + [acvp_bin, "batch", f"jobs={jobs}"]
+    stdin = "".join(line + "\n" for (_, line, _) in cases)
+    result = subprocess.run(
+        acvp_call, input=stdin, encoding="utf-8", capture_output=True
+    )
+    if result.returncode != 0:
+        err(f"{acvp_call} failed with error code {result.returncode}")
+        err(result.stderr)
         exit(1)
-    info("OK")
 
-
-for tg in acvp_keygen_data["testGroups"]:
-    for tc in tg["tests"]:
-        run_keyGen_test(tg, tc)
-
-for tg in acvp_sigGen_data["testGroups"]:
-    for tc in tg["tests"]:
-        run_sigGen_test(tg, tc)
-
-for tg in acvp_sigVer_data["testGroups"]:
-    for tc in tg["tests"]:
-        run_sigVer_test(tg, tc)
+    # One line of results per test case, in order
+    lines = result.stdout.splitlines()
+    if len(lines) != len(cases):
+        err(f"{acvp_call}: expected {len(cases)} results, got {len(lines)}")
+        exit(1)
+    for (name, _, expected), l in zip(cases, lines):
+        info(f"Running {name} ... ", end="")
+        got = dict(f.split("=", 1) for f in l.split())
+        for k, v in expected.items():
+            if got.get(k) != v:
+                err("FAIL!")
+                err(f"Mismatching result for {k}: expected {v}, got {got.get(k)}")
+                exit(1)
+        info("OK")
+
+
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--jobs",
+    type=int,
+    default=os.cpu_count() or 1,
+    help="Number of worker threads per ACVP binary",
+)
+args = parser.parse_args()
+
+for acvp_bin, cases in collect_cases().items():
+    run_batch(acvp_bin, cases, args.jobs)
@@ -2,6 +2,7 @@
  * Copyright (c) The mldsa-native project authors
  * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
  */
+#include <pthread.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -9,12 +10,27 @@
 
 #include "../mldsa/sign.h"
 
-#define USAGE "acvp_mldsa{lvl} [keyGen|sigGen|sigVer] {test specific arguments}"
+#define USAGE                                                                \
+  "acvp_mldsa{lvl} [keyGen|sigGen|sigVer] {test specific arguments}\n"       \
+  "acvp_mldsa{lvl} batch [jobs=N] < FILE"
 #define KEYGEN_USAGE "acvp_mldsa{lvl} keyGen seed=HEX"
 #define SIGGEN_USAGE \
   "acvp_mldsa{lvl} sigGen message=HEX rng=HEX sk=HEX context=HEX"
 #define SIGVER_USAGE \
   "acvp_mldsa{lvl} sigVer message=HEX context=HEX signature=HEX pk=HEX"
+#define BATCH_USAGE "acvp_mldsa{lvl} batch [jobs=N] < FILE"
+
+/* Batch mode: FILE contains one test case per line, given by the arguments
+ * of the single-case invocation, e.g. `keyGen seed=HEX`. The cases are run
+ * in-process, optionally by N worker threads, and one line of results is
+ * printed per case and in the order of FILE:
+ *   keyGen: pk=HEX sk=HEX
+ *   sigGen: signature=HEX
+ *   sigVer: testPassed=true|false */
+/* maximum number of arguments of a test case, including the mode */
+#define MAX_CASE_ARGS 5
+/* maximum number of worker threads in batch mode */
+#define MAX_JOBS 256
 
 /* maximum message length used in the ACVP tests */
 #define MAX_MSG_LENGTH 65536
@@ -40,6 +56,14 @@ typedef enum
   sigVer
 } acvp_mode;
 
+typedef struct
+{
+  unsigned char pk[CRYPTO_PUBLICKEYBYTES];
+  unsigned char sk[CRYPTO_SECRETKEYBYTES];
+  unsigned char sig[CRYPTO_BYTES];
+  int verified; /* return value of crypto_sign_verify() */
+} acvp_result;
+
 /* Decode hex character [0-9A-Fa-f] into 0-15 */
 static unsigned char decode_hex_char(char hex)
 {
@@ -108,7 +132,8 @@ hex_usage:
   return 1;
 }
 
-static void print_hex(const char *name, const unsigned char *raw, size_t len)
+static void print_hex(const char *name, const unsigned char *raw, size_t len,
+                      char end)
 {
   if (name != NULL)
   {
@@ -118,26 +143,21 @@ static void print_hex(const char *name, const unsigned char *raw, size_t len)
   {
     printf("%02X", *raw);
   }
-  printf("\n");
+  putchar(end);
 }
 
-static void acvp_mldsa_keyGen_AFT(const unsigned char seed[MLDSA_RNDBYTES])
+static void acvp_mldsa_keyGen_AFT(acvp_result *res,
+                                  const unsigned char seed[MLDSA_RNDBYTES])
 {
-  unsigned char pk[CRYPTO_PUBLICKEYBYTES];
-  unsigned char sk[CRYPTO_SECRETKEYBYTES];
-
-  CHECK(crypto_sign_keypair_internal(pk, sk, seed) == 0);
-
-  print_hex("pk", pk, sizeof(pk));
-  print_hex("sk", sk, sizeof(sk));
+  CHECK(crypto_sign_keypair_internal(res->pk, res->sk, seed) == 0);
 }
 
-static void acvp_mldsa_sigGen_AFT(const unsigned char *message, size_t mlen,
+static void acvp_mldsa_sigGen_AFT(acvp_result *res,
+                                  const unsigned char *message, size_t mlen,
                                   const unsigned char rnd[MLDSA_SEEDBYTES],
                                   const unsigned char sk[CRYPTO_SECRETKEYBYTES],
                                   const unsigned char *context, size_t ctxlen)
 {
-  unsigned char sig[CRYPTO_BYTES];
   size_t siglen;
 
   /* TODO: shouldn't this be moved to be in the internal function? */
@@ -146,31 +166,28 @@ static void acvp_mldsa_sigGen_AFT(const unsigned char *message, size_t mlen,
   pre[1] = ctxlen;
   memcpy(pre + 2, context, ctxlen);
 
-  CHECK(crypto_sign_signature_internal(sig, &siglen, message, mlen, pre,
+  CHECK(crypto_sign_signature_internal(res->sig, &siglen, message, mlen, pre,
                                        ctxlen + 2, rnd, sk, 0) == 0);
-  print_hex("signature", sig, sizeof(sig));
 }
 
 
-static int acvp_mldsa_sigVer_AFT(const unsigned char *message, size_t mlen,
-                                 const unsigned char *context, size_t ctxlen,
-                                 const unsigned char signature[CRYPTO_BYTES],
-                                 const unsigned char pk[CRYPTO_PUBLICKEYBYTES])
+static void acvp_mldsa_sigVer_AFT(acvp_result *res,
+                                  const unsigned char *message, size_t mlen,
+                                  const unsigned char *context, size_t ctxlen,
+                                  const unsigned char signature[CRYPTO_BYTES],
+                                  const unsigned char pk[CRYPTO_PUBLICKEYBYTES])
 {
-  return crypto_sign_verify(signature, CRYPTO_BYTES, message, mlen, context,
-                            ctxlen, pk);
+  res->verified = crypto_sign_verify(signature, CRYPTO_BYTES, message, mlen,
+                                     context, ctxlen, pk);
 }
 
-int main(int argc, char *argv[])
+/* Parses the arguments of one test case, starting with the mode, and runs
+ * it. Returns 0 on success, or 1 if the arguments are invalid. */
+static int acvp_run(acvp_mode *mode_out, acvp_result *res, int argc,
+                    char *argv[])
 {
   acvp_mode mode;
 
-  if (argc == 0)
-  {
-    goto usage;
-  }
-  argc--, argv++;
-
   if (argc == 0)
   {
     goto usage;
@@ -193,6 +210,7 @@ int main(int argc, char *argv[])
     goto usage;
   }
   argc--, argv++;
+  *mode_out = mode;
 
   switch (mode)
   {
@@ -207,7 +225,7 @@ int main(int argc, char *argv[])
       argc--, argv++;
 
       /* Call function under test */
-      acvp_mldsa_keyGen_AFT(seed);
+      acvp_mldsa_keyGen_AFT(res, seed);
       break;
     }
 
@@ -260,7 +278,7 @@ int main(int argc, char *argv[])
       argc--, argv++;
 
       /* Call function under test */
-      acvp_mldsa_sigGen_AFT(message, mlen, rnd, sk, context, ctxlen);
+      acvp_mldsa_sigGen_AFT(res, message, mlen, rnd, sk, context, ctxlen);
       break;
     }
 
@@ -316,8 +334,9 @@ int main(int argc, char *argv[])
 
 
       /* Call function under test */
-      return acvp_mldsa_sigVer_AFT(message, mlen, context, ctxlen, signature,
-                                   pk);
+      acvp_mldsa_sigVer_AFT(res, message, mlen, context, ctxlen, signature,
+                            pk);
+      break;
     }
   }
 
@@ -339,3 +358,210 @@ sigver_usage:
   fprintf(stderr, SIGVER_USAGE "\n");
   return (1);
 }
+
+static void print_result(acvp_mode mode, const acvp_result *res, char sep)
+{
+  switch (mode)
+  {
+    case keyGen:
+      print_hex("pk", res->pk, sizeof(res->pk), sep);
+      print_hex("sk", res->sk, sizeof(res->sk), '\n');
+      break;
+    case sigGen:
+      print_hex("signature", res->sig, sizeof(res->sig), '\n');
+      break;
+    case sigVer:
+      /* Only printed in batch mode; otherwise it is the exit code */
+      printf("testPassed=%s\n", res->verified == 0 ? "true" : "false");
+      break;
+  }
+}
+
+typedef struct
+{
+  int argc;
+  char *argv[MAX_CASE_ARGS];
+  size_t line;
+  acvp_mode mode;
+  acvp_result res;
+  int rc;
+} acvp_case;
+
+typedef struct
+{
+  acvp_case *cases;
+  size_t num_cases;
+  unsigned job, num_jobs;
+} acvp_worker;
+
+static void *acvp_worker_run(void *arg)
+{
+  acvp_worker *w = (acvp_worker *)arg;
+  size_t i;
+
+  for (i = w->job; i < w->num_cases; i += w->num_jobs)
+  {
+    acvp_case *c = &w->cases[i];
+    c->rc = acvp_run(&c->mode, &c->res, c->argc, c->argv);
+  }
+  return NULL;
+}
+
+/* Reads all of f into a null-terminated buffer */
+static char *read_all(FILE *f)
+{
+  size_t cap = 1 << 20, len = 0, n;
+  char *buf = malloc(cap + 1), *tmp;
+
+  CHECK(buf != NULL);
+  while ((n = fread(buf + len, 1, cap - len, f)) > 0)
+  {
+    len += n;
+    if (len == cap)
+    {
+      cap *= 2;
+      tmp = realloc(buf, cap + 1);
+      CHECK(tmp != NULL);
+      buf = tmp;
+    }
+  }
+  CHECK(!ferror(f));
+  buf[len] = '\0';
+  return buf;
+}
+
+/* Splits buf in place into test cases, one per non-empty line, and returns
+ * their number, or 0 on error. */
+static size_t split_cases(acvp_case **cases_out, char *buf)
+{
+  size_t num_lines = 1, num_cases = 0, line = 0;
+  acvp_case *cases;
+  char *p, *next, *tok;
+
+  for (p = buf; *p != '\0'; p++)
+  {
+    num_lines += (*p == '\n');
+  }
+  cases = calloc(num_lines, sizeof(acvp_case));
+  CHECK(cases != NULL);
+
+  for (p = buf; p != NULL; p = next)
+  {
+    acvp_case *c = &cases[num_cases];
+    line++;
+    next = strchr(p, '\n');
+    if (next != NULL)
+    {
+      *next++ = '\0';
+    }
+
+    for (tok = strtok(p, " \t\r"); tok != NULL; tok = strtok(NULL, " \t\r"))
+    {
+      if (c->argc == MAX_CASE_ARGS)
+      {
+        fprintf(stderr, "line %u: too many arguments\n", (unsigned)line);
+        free(cases);
+        return 0;
+      }
+      c->argv[c->argc++] = tok;
+    }
+    if (c->argc != 0)
+    {
+      c->line = line;
+      num_cases++;
+    }
+  }
+
+  *cases_out = cases;
+  return num_cases;
+}
+
+static int acvp_batch(int argc, char *argv[])
+{
+  static acvp_worker workers[MAX_JOBS];
+  static pthread_t threads[MAX_JOBS];
+  acvp_case *cases;
+  size_t num_cases, i;
+  unsigned num_jobs = 1, j;
+  char *buf;
+  int ret = 0;
+
+  if (argc > 1 || (argc == 1 && (sscanf(*argv, "jobs=%u", &num_jobs) != 1 ||
+                                 num_jobs == 0 || num_jobs > MAX_JOBS)))
+  {
+    fprintf(stderr, BATCH_USAGE "\n");
+    return 1;
+  }
+
+  buf = read_all(stdin);
+  num_cases = split_cases(&cases, buf);
+  if (num_cases == 0)
+  {
+    fprintf(stderr, "No test cases\n");
+    free(buf);
+    return 1;
+  }
+
+  for (j = 0; j < num_jobs; j++)
+  {
+    workers[j].cases = cases;
+    workers[j].num_cases = num_cases;
+    workers[j].job = j;
+    workers[j].num_jobs = num_jobs;
+  }
+  /* The calling thread is the first worker */
+  for (j = 1; j < num_jobs; j++)
+  {
+    CHECK(pthread_create(&threads[j], NULL, acvp_worker_run, &workers[j]) ==
+          0);
+  }
+  acvp_worker_run(&workers[0]);
+  for (j = 1; j < num_jobs; j++)
+  {
+    CHECK(pthread_join(threads[j], NULL) == 0);
+  }
+
+  for (i = 0; i < num_cases; i++)
+  {
+    if (cases[i].rc != 0)
+    {
+      fprintf(stderr, "line %u: invalid test case\n", (unsigned)cases[i].line);
+      ret = 1;
+      break;
+    }
+    print_result(cases[i].mode, &cases[i].res, ' ');
+  }
+
+  free(cases);
+  free(buf);
+  return ret;
+}
+
+int main(int argc, char *argv[])
+{
+  acvp_mode mode;
+  static acvp_result res;
+
+  if (argc < 2)
+  {
+    fprintf(stderr, USAGE "\n");
+    return (1);
+  }
+  argc--, argv++;
+
+  if (strcmp(*argv, "batch") == 0)
+  {
+    return acvp_batch(argc - 1, argv + 1);
+  }
+
+  if (acvp_run(&mode, &res, argc, argv) != 0)
+  {
+    return (1);
+  }
+  if (mode == sigVer)
+  {
+    return res.verified;
+  }
+  print_result(mode, &res, '\n');
+  return (0);
+}
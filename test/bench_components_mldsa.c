@@ -8,8 +8,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "../mldsa/fips202/fips202.h"
+#include "../mldsa/fips202/fips202x4.h"
+#include "../mldsa/fips202/keccakf1600.h"
 #include "../mldsa/ntt.h"
+#include "../mldsa/packing.h"
 #include "../mldsa/poly.h"
+#include "../mldsa/polyvec.h"
 #include "../mldsa/randombytes.h"
 #include "hal.h"
 
@@ -17,41 +22,318 @@
 #define NITERATIONS 300
 #define NTESTS 20
 
+/* Length of the inputs to the SHAKE benchmarks */
+#define SHAKE_INLEN 1024
+#define BUFLEN 8192
+
+/* Each routine is reported in one line of the form
+ *   <name> cycles=<median> p10=<p10> p90=<p90> [bytes=<n> cpb=<c>]
+ * where cycles are per call, and cpb = median / bytes is only given for
+ * routines processing a meaningful number of bytes. scripts/tests converts
+ * these lines to JSON or CSV. */
+
+static MLD_ALIGN mld_poly pa, pb, pc, ph, pd;
+static MLD_ALIGN mld_polyvecl vl0, vl1, vl2;
+static MLD_ALIGN mld_polyveck vk0, vk1, vk2, vk3, vkh;
+static MLD_ALIGN mld_polyvecl mat[MLDSA_K];
+static MLD_ALIGN uint8_t matpacked[MLDSA_POLYMAT_PACKEDBYTES];
+static MLD_ALIGN mld_poly pchal;
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+static MLD_ALIGN mld_poly_small psmall;
+#endif
+static MLD_ALIGN uint8_t seed4[4][MLD_ALIGN_UP(MLDSA_SEEDBYTES + 2)];
+static MLD_ALIGN uint8_t crh[MLDSA_CRHBYTES];
+static MLD_ALIGN uint8_t extseed[4][MLD_ALIGN_UP(MLDSA_CRHBYTES + 2)];
+static MLD_ALIGN uint8_t rho[MLDSA_SEEDBYTES];
+static MLD_ALIGN uint8_t tr[MLDSA_TRBYTES];
+static MLD_ALIGN uint8_t key[MLDSA_SEEDBYTES];
+static MLD_ALIGN uint8_t ctilde[MLDSA_CTILDEBYTES];
+static MLD_ALIGN uint8_t buf[4][BUFLEN];
+static MLD_ALIGN uint8_t sig[CRYPTO_BYTES];
+static MLD_ALIGN uint64_t kstate[MLD_KECCAK_LANES * 4];
+static keccak_state ks, ks128, ks256;
+static mld_shake128x4ctx x4_128;
+static mld_shake256x4ctx x4_256;
+static unsigned int nhints;
+
 static int cmp_uint64_t(const void *a, const void *b)
 {
   return (int)((*((const uint64_t *)a)) - (*((const uint64_t *)b)));
 }
 
-#define BENCH(txt, code)                                \
-  for (i = 0; i < NTESTS; i++)                          \
-  {                                                     \
-    mld_randombytes((uint8_t *)data0, sizeof(data0));   \
-    for (j = 0; j < NWARMUP; j++)                       \
-    {                                                   \
-      code;                                             \
-    }                                                   \
-                                                        \
-    t0 = get_cyclecounter();                            \
-    for (j = 0; j < NITERATIONS; j++)                   \
-    {                                                   \
-      code;                                             \
-    }                                                   \
-    t1 = get_cyclecounter();                            \
-    (cyc)[i] = t1 - t0;                                 \
-  }                                                     \
-  qsort((cyc), NTESTS, sizeof(uint64_t), cmp_uint64_t); \
-  printf(txt " cycles=%" PRIu64 "\n", (cyc)[NTESTS >> 1] / NITERATIONS);
+static void rand_poly(mld_poly *p, uint32_t bound)
+{
+  uint32_t r[MLDSA_N];
+  unsigned i;
+  mld_randombytes((uint8_t *)r, sizeof(r));
+  for (i = 0; i < MLDSA_N; i++)
+  {
+    p->coeffs[i] = (int32_t)(r[i] % bound);
+  }
+}
+
+/* Refresh all inputs with random data of the expected ranges. Called before
+ * each measurement, as many routines operate in place. */
+static void init_inputs(void)
+{
+  unsigned i;
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+  mld_poly ps;
+#endif
+
+  rand_poly(&pa, MLDSA_Q);
+  rand_poly(&pb, MLDSA_Q);
+  rand_poly(&pc, MLDSA_Q);
+  rand_poly(&ph, 2);
+  for (i = 0; i < MLDSA_L; i++)
+  {
+    rand_poly(&vl0.vec[i], MLDSA_Q);
+    rand_poly(&vl1.vec[i], MLDSA_GAMMA1);
+  }
+  for (i = 0; i < MLDSA_K; i++)
+  {
+    rand_poly(&vk0.vec[i], MLDSA_Q);
+    rand_poly(&vk1.vec[i], MLDSA_Q);
+    rand_poly(&vk2.vec[i], MLDSA_Q);
+  }
+
+  /* A valid hint vector, for packing and unpacking of signatures */
+  memset(&vkh, 0, sizeof(vkh));
+  nhints = 0;
+  for (i = 0; i < MLDSA_OMEGA / 2; i++)
+  {
+    vkh.vec[i % MLDSA_K].coeffs[(7 * i) % MLDSA_N] = 1;
+    nhints++;
+  }
+
+  mld_randombytes((uint8_t *)seed4, sizeof(seed4));
+  mld_randombytes(crh, sizeof(crh));
+  mld_randombytes((uint8_t *)extseed, sizeof(extseed));
+  mld_randombytes(rho, sizeof(rho));
+  mld_randombytes(tr, sizeof(tr));
+  mld_randombytes(key, sizeof(key));
+  mld_randombytes(ctilde, sizeof(ctilde));
+  mld_randombytes((uint8_t *)buf, sizeof(buf));
+  mld_randombytes((uint8_t *)kstate, sizeof(kstate));
+
+  mld_polyvec_matrix_expand(mat, rho);
+  mld_polyvec_matrix_pack(matpacked, mat);
+  mld_poly_challenge(&pchal, ctilde);
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+  /* A secret polynomial with coefficients in [-MLDSA_ETA, MLDSA_ETA] */
+  rand_poly(&ps, 2 * MLDSA_ETA + 1);
+  for (i = 0; i < MLDSA_N; i++)
+  {
+    ps.coeffs[i] -= MLDSA_ETA;
+  }
+  mld_poly_small_from_poly(&psmall, &ps);
+#endif
+  mld_pack_sig(sig, ctilde, &vl1, &vkh, nhints);
+
+  shake256_init(&ks);
+  shake128_init(&ks128);
+  shake128_absorb(&ks128, rho, MLDSA_SEEDBYTES);
+  shake128_finalize(&ks128);
+  shake256_init(&ks256);
+  shake256_absorb(&ks256, crh, MLDSA_CRHBYTES);
+  shake256_finalize(&ks256);
+  mld_shake128x4_absorb_once(&x4_128, buf[0], buf[1], buf[2], buf[3],
+                             MLDSA_SEEDBYTES + 2);
+  mld_shake256x4_absorb_once(&x4_256, buf[0], buf[1], buf[2], buf[3],
+                             MLDSA_CRHBYTES + 2);
+}
+
+static void print_result(const char *txt, uint64_t cyc[NTESTS],
+                         unsigned bytes, const hal_events *ev)
+{
+  uint64_t median, p10, p90;
+
+  qsort(cyc, NTESTS, sizeof(uint64_t), cmp_uint64_t);
+  median = cyc[NTESTS >> 1] / NITERATIONS;
+  p10 = cyc[NTESTS * 10 / 100] / NITERATIONS;
+  p90 = cyc[NTESTS * 90 / 100] / NITERATIONS;
+
+  printf("%-44s cycles=%" PRIu64 " p10=%" PRIu64 " p90=%" PRIu64, txt, median,
+         p10, p90);
+  if (bytes != 0)
+  {
+    printf(" bytes=%u cpb=%.2f", bytes, (double)median / bytes);
+  }
+  print_perf_events(ev, (uint64_t)NTESTS * NITERATIONS);
+  printf("\n");
+}
+
+#define BENCH_BYTES(txt, bytes, code) \
+  for (i = 0; i < NTESTS; i++)        \
+  {                                   \
+    init_inputs();                    \
+    for (j = 0; j < NWARMUP; j++)     \
+    {                                 \
+      code;                           \
+    }                                 \
+                                      \
+    get_perf_events(&e0);             \
+    t0 = get_cyclecounter();          \
+    for (j = 0; j < NITERATIONS; j++) \
+    {                                 \
+      code;                           \
+    }                                 \
+    t1 = get_cyclecounter();          \
+    get_perf_events(&e1);             \
+    (cyc)[i] = t1 - t0;               \
+    add_perf_events(&ev, &e0, &e1);   \
+  }                                   \
+  print_result(txt, cyc, bytes, &ev); \
+  memset(&ev, 0, sizeof(ev));
+
+#define BENCH(txt, code) BENCH_BYTES(txt, 0, code)
 
 static int bench(void)
 {
-  MLD_ALIGN int32_t data0[256];
   uint64_t cyc[NTESTS];
+  hal_events ev = {{0}}, e0, e1;
   unsigned i, j;
   uint64_t t0, t1;
 
+  /* Routines whose output bound exceeds their input bound would overflow
+   * when applied in place over all iterations. They work on a copy of the
+   * input instead, so that their timings include that copy. */
+
   /* ntt */
-  BENCH("poly_ntt", mld_poly_ntt((mld_poly *)data0))
-  BENCH("poly_invntt_tomont", mld_poly_invntt_tomont((mld_poly *)data0))
+  BENCH("poly_ntt", pd = pa; mld_poly_ntt(&pd))
+  BENCH("poly_invntt_tomont", mld_poly_invntt_tomont(&pa))
+  BENCH("polyvecl_ntt", vl2 = vl0; mld_polyvecl_ntt(&vl2))
+  BENCH("polyveck_ntt", vk3 = vk0; mld_polyveck_ntt(&vk3))
+  BENCH("polyveck_invntt_tomont", mld_polyveck_invntt_tomont(&vk0))
+
+  /* arithmetic */
+  BENCH("poly_reduce", mld_poly_reduce(&pa))
+  BENCH("poly_caddq", mld_poly_caddq(&pa))
+  BENCH("poly_add", pd = pa; mld_poly_add(&pd, &pb))
+  BENCH("poly_sub", pd = pa; mld_poly_sub(&pd, &pb))
+  BENCH("poly_shiftl", pd = ph; mld_poly_shiftl(&pd))
+  BENCH("poly_pointwise_montgomery",
+        mld_poly_pointwise_montgomery(&pc, &pa, &pb))
+  BENCH("polyvecl_pointwise_acc_montgomery",
+        mld_polyvecl_pointwise_acc_montgomery(&pc, &vl0, &vl1))
+  BENCH("polyvec_matrix_pointwise_montgomery",
+        mld_polyvec_matrix_pointwise_montgomery(&vk2, mat, &vl0))
+  BENCH("polyvec_matrix_pointwise_montgomery_packed",
+        mld_polyvec_matrix_pointwise_montgomery_packed(&vk2, matpacked, &vl0))
+#if defined(MLD_CONFIG_REDUCE_RAM)
+  BENCH("polyvec_matrix_pointwise_montgomery_stream",
+        mld_polyvec_matrix_pointwise_montgomery_stream(&vk2, rho, &vl0))
+#endif
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+  BENCH("poly_challenge_mul_small",
+        mld_poly_challenge_mul_small(&pc, &pchal, &psmall))
+#endif
+
+  /* rounding and hints */
+  BENCH("poly_power2round", mld_poly_power2round(&pb, &pc, &pa))
+  BENCH("poly_decompose", mld_poly_decompose(&pb, &pc, &pa))
+  BENCH("poly_make_hint", (void)mld_poly_make_hint(&pc, &pa, &ph))
+  BENCH("poly_use_hint", mld_poly_use_hint(&pc, &pa, &ph))
+  BENCH("polyveck_power2round", mld_polyveck_power2round(&vk1, &vk2, &vk0))
+  BENCH("polyveck_decompose", mld_polyveck_decompose(&vk1, &vk2, &vk0))
+  BENCH("polyveck_make_hint", (void)mld_polyveck_make_hint(&vk2, &vk0, &vkh))
+  BENCH("polyveck_use_hint", mld_polyveck_use_hint(&vk2, &vk0, &vkh))
+
+  /* norm checks */
+  BENCH("poly_chknorm", (void)mld_poly_chknorm(&pa, MLDSA_Q / 2))
+  BENCH("polyvecl_chknorm", (void)mld_polyvecl_chknorm(&vl0, MLDSA_Q / 2))
+  BENCH("polyveck_chknorm", (void)mld_polyveck_chknorm(&vk0, MLDSA_Q / 2))
+
+  /* sampling */
+  BENCH("poly_uniform", mld_poly_uniform(&pa, seed4[0]))
+  BENCH("poly_uniform_4x", mld_poly_uniform_4x(&pa, &pb, &pc, &ph, seed4))
+  BENCH("poly_uniform_eta_4x",
+        mld_poly_uniform_eta_4x(&pa, &pb, &pc, &ph, crh, 0, 1, 2, 3))
+  BENCH("poly_uniform_eta_4x_seeds",
+        mld_poly_uniform_eta_4x_seeds(&pa, &pb, &pc, &ph, extseed))
+  BENCH("poly_uniform_gamma1", mld_poly_uniform_gamma1(&pa, crh, 0))
+  BENCH("poly_uniform_gamma1_4x",
+        mld_poly_uniform_gamma1_4x(&pa, &pb, &pc, &ph, crh, 0, 1, 2, 3))
+  BENCH("polyvecl_uniform_gamma1", mld_polyvecl_uniform_gamma1(&vl1, crh, 0))
+  BENCH("poly_challenge", mld_poly_challenge(&pa, ctilde))
+  BENCH_BYTES("polyvec_matrix_expand",
+              MLDSA_K * MLDSA_L * MLDSA_N * 3,
+              mld_polyvec_matrix_expand(mat, rho))
+#if defined(MLD_CONFIG_REDUCE_RAM)
+  BENCH_BYTES("polyvec_matrix_expand_row", MLDSA_L * MLDSA_N * 3,
+              mld_polyvec_matrix_expand_row(&vl2, rho, 0))
+  BENCH_BYTES("polyvec_matrix_expand_packed",
+              MLDSA_K * MLDSA_L * MLDSA_N * 3,
+              mld_polyvec_matrix_expand_packed(matpacked, rho))
+#endif
+
+  /* packing of polynomials */
+  BENCH_BYTES("polyeta_pack", MLDSA_POLYETA_PACKEDBYTES,
+              mld_polyeta_pack(buf[0], &pa))
+  BENCH_BYTES("polyeta_unpack", MLDSA_POLYETA_PACKEDBYTES,
+              mld_polyeta_unpack(&pa, buf[0]))
+  BENCH_BYTES("polyt1_pack", MLDSA_POLYT1_PACKEDBYTES,
+              mld_polyt1_pack(buf[0], &pa))
+  BENCH_BYTES("polyt1_unpack", MLDSA_POLYT1_PACKEDBYTES,
+              mld_polyt1_unpack(&pa, buf[0]))
+  BENCH_BYTES("polyt0_pack", MLDSA_POLYT0_PACKEDBYTES,
+              mld_polyt0_pack(buf[0], &pa))
+  BENCH_BYTES("polyt0_unpack", MLDSA_POLYT0_PACKEDBYTES,
+              mld_polyt0_unpack(&pa, buf[0]))
+  BENCH_BYTES("polya_pack", MLDSA_POLYA_PACKEDBYTES,
+              mld_polya_pack(buf[0], &mat[0].vec[0]))
+  BENCH_BYTES("polya_unpack", MLDSA_POLYA_PACKEDBYTES,
+              mld_polya_unpack(&pa, matpacked))
+  BENCH_BYTES("polyvec_matrix_pack", MLDSA_POLYMAT_PACKEDBYTES,
+              mld_polyvec_matrix_pack(matpacked, mat))
+  BENCH_BYTES("polyz_pack", MLDSA_POLYZ_PACKEDBYTES,
+              mld_polyz_pack(buf[0], &pa))
+  BENCH_BYTES("polyz_unpack", MLDSA_POLYZ_PACKEDBYTES,
+              mld_polyz_unpack(&pa, buf[0]))
+  BENCH_BYTES("polyw1_pack", MLDSA_POLYW1_PACKEDBYTES,
+              mld_polyw1_pack(buf[0], &pa))
+  BENCH_BYTES("polyveck_pack_w1", MLDSA_K * MLDSA_POLYW1_PACKEDBYTES,
+              mld_polyveck_pack_w1(buf[0], &vk0))
+
+  /* packing of keys and signatures */
+  BENCH_BYTES("pack_pk", CRYPTO_PUBLICKEYBYTES,
+              mld_pack_pk(buf[0], rho, &vk0))
+  BENCH_BYTES("unpack_pk", CRYPTO_PUBLICKEYBYTES,
+              mld_unpack_pk(rho, &vk0, buf[0]))
+  BENCH_BYTES("pack_sk", CRYPTO_SECRETKEYBYTES,
+              mld_pack_sk(buf[0], rho, tr, key, &vk0, &vl0, &vk1))
+  BENCH_BYTES("unpack_sk", CRYPTO_SECRETKEYBYTES,
+              mld_unpack_sk(rho, tr, key, &vk0, &vl0, &vk1, buf[0]))
+  BENCH_BYTES("pack_sig", CRYPTO_BYTES,
+              mld_pack_sig(buf[0], ctilde, &vl1, &vkh, nhints))
+  BENCH_BYTES("unpack_sig", CRYPTO_BYTES,
+              (void)mld_unpack_sig(ctilde, &vl0, &vk2, sig))
+
+  /* Keccak */
+  BENCH_BYTES("keccakf1600_permute", 8 * MLD_KECCAK_LANES,
+              mld_keccakf1600_permute(kstate))
+  BENCH_BYTES("keccakf1600x4_permute", 4 * 8 * MLD_KECCAK_LANES,
+              mld_keccakf1600x4_permute(kstate))
+  BENCH_BYTES("shake256_absorb", SHAKE_INLEN,
+              shake256_absorb(&ks, buf[0], SHAKE_INLEN))
+  BENCH_BYTES("shake256_squeeze", SHAKE_INLEN,
+              shake256_squeeze(buf[1], SHAKE_INLEN, &ks256))
+  BENCH_BYTES("shake256", SHAKE_INLEN,
+              shake256(buf[1], MLDSA_CRHBYTES, buf[0], SHAKE_INLEN))
+  BENCH_BYTES("shake128_squeezeblocks", 5 * SHAKE128_RATE,
+              shake128_squeezeblocks(buf[1], 5, &ks128))
+  BENCH_BYTES("shake128x4_absorb_once", 4 * (MLDSA_SEEDBYTES + 2),
+              mld_shake128x4_absorb_once(&x4_128, buf[0], buf[1], buf[2],
+                                         buf[3], MLDSA_SEEDBYTES + 2))
+  BENCH_BYTES("shake128x4_squeezeblocks", 4 * 5 * SHAKE128_RATE,
+              mld_shake128x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], 5,
+                                           &x4_128))
+  BENCH_BYTES("shake256x4_absorb_once", 4 * (MLDSA_CRHBYTES + 2),
+              mld_shake256x4_absorb_once(&x4_256, buf[0], buf[1], buf[2],
+                                         buf[3], MLDSA_CRHBYTES + 2))
+  BENCH_BYTES("shake256x4_squeezeblocks", 4 * 5 * SHAKE256_RATE,
+              mld_shake256x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], 5,
+                                           &x4_256))
 
   return 0;
 }
@@ -59,7 +341,9 @@ static int bench(void)
 int main(void)
 {
   enable_cyclecounter();
+  enable_perf_events();
   bench();
+  disable_perf_events();
   disable_cyclecounter();
 
   return 0;
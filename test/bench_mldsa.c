@@ -3,14 +3,26 @@
  * Copyright (c) The mlkem-native project authors
  * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
  */
+
+#if defined(__linux__)
+#if !defined(_GNU_SOURCE)
+/* Ensure that posix_memalign() is declared even when compiling with -std=c99
+ */
+#define _GNU_SOURCE
+#endif
+#endif
+
 #include <inttypes.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "../mldsa/randombytes.h"
+#include "../mldsa/fips202/fips202.h"
 #include "../mldsa/sign.h"
+#include "../mldsa/stats.h"
 #include "hal.h"
+#include "notrandombytes/notrandombytes.h"
+#include "profile.h"
 
 #define NWARMUP 3
 #define NITERATIONS 5
@@ -18,6 +30,42 @@
 #define MLEN 59
 #define CTXLEN 1
 
+/* Parameters of the message-size sweep (--sweep). Message sizes are 0 and
+ * the powers of 4 up to SWEEP_MAXLEN. Messages shorter than SWEEP_LONGLEN
+ * are processed SWEEP_NITERATIONS times per measurement. */
+#define SWEEP_NTESTS 7
+#define SWEEP_NITERATIONS 8
+#define SWEEP_MAXLEN ((size_t)64 * 1024 * 1024)
+#define SWEEP_LONGLEN ((size_t)1024 * 1024)
+#define SWEEP_CTX_MLEN 4096
+#define SWEEP_MAXCTXLEN 255
+
+/* Number of signatures of the attempts benchmark (--attempts) */
+#define ATTEMPTS_NTESTS 2000
+
+/* Number of operations of the phase profile (--profile) */
+#define PROFILE_NTESTS 1000
+
+/* Parameters of the key-rotation benchmark (--keys). Each scenario performs
+ * KEYS_NOPS operations with keys drawn at random from a set of 1, 10, ...,
+ * KEYS_MAX keys. The set is filled with copies of KEYS_DISTINCT distinct
+ * keys, which is enough to defeat any reuse of data between operations, as
+ * caches are indexed by address. Sets larger than KEYS_MAXMEM are skipped. */
+#define KEYS_NOPS 320
+#define KEYS_MAX 100000
+#define KEYS_DISTINCT 16
+#define KEYS_MAXMEM ((size_t)1024 * 1024 * 1024)
+
+/* Parameters of the latency benchmark (--latency). Every one of
+ * LATENCY_NTESTS signatures is timed individually, with a fresh key,
+ * message and rnd, and the inputs of the LATENCY_SLOWEST slowest ones are
+ * kept for replay. The histogram has 2^LATENCY_SUB_BITS buckets per power
+ * of two, i.e., a relative precision of 2^-LATENCY_SUB_BITS. */
+#define LATENCY_NTESTS 10000
+#define LATENCY_SLOWEST 10
+#define LATENCY_SUB_BITS 4
+#define LATENCY_NUM_BUCKETS ((64 - LATENCY_SUB_BITS + 1) << LATENCY_SUB_BITS)
+
 #define CHECK(x)                                              \
   do                                                          \
   {                                                           \
@@ -72,6 +120,16 @@ static void print_percentiles(const char *txt, uint64_t cyc[NTESTS])
   printf("\n");
 }
 
+/* Bitmask of the hardware events available, see enable_perf_events() */
+static int perf_events;
+
+static void print_events(const char *txt, const hal_events *ev)
+{
+  printf("%10s events (avg):", txt);
+  print_perf_events(ev, (uint64_t)NTESTS * NITERATIONS);
+  printf("\n");
+}
+
 static int bench(void)
 {
   uint8_t pk[CRYPTO_PUBLICKEYBYTES];
@@ -86,13 +144,14 @@ static int bench(void)
   uint64_t t0, t1;
 
   uint64_t cycles_kg[NTESTS], cycles_sign[NTESTS], cycles_verify[NTESTS];
+  hal_events ev_kg = {{0}}, ev_sign = {{0}}, ev_verify = {{0}}, e0, e1;
   unsigned char pre[CTXLEN + 2];
 
   for (i = 0; i < NTESTS; i++)
   {
     int ret = 0;
-    mld_randombytes(kg_rand, sizeof(kg_rand));
-    mld_randombytes(sig_rand, sizeof(sig_rand));
+    randombytes(kg_rand, sizeof(kg_rand));
+    randombytes(sig_rand, sizeof(sig_rand));
 
 
     /* Key-pair generation */
@@ -101,18 +160,21 @@ static int bench(void)
       ret |= crypto_sign_keypair_internal(pk, sk, kg_rand);
     }
 
+    get_perf_events(&e0);
     t0 = get_cyclecounter();
     for (j = 0; j < NITERATIONS; j++)
     {
       ret |= crypto_sign_keypair_internal(pk, sk, kg_rand);
     }
     t1 = get_cyclecounter();
+    get_perf_events(&e1);
     cycles_kg[i] = t1 - t0;
+    add_perf_events(&ev_kg, &e0, &e1);
 
 
     /* Signing */
-    mld_randombytes(ctx, CTXLEN);
-    mld_randombytes(m, MLEN);
+    randombytes(ctx, CTXLEN);
+    randombytes(m, MLEN);
 
     /* TODO: shouldn't this be moved to be in the internal function? */
     pre[0] = 0;
@@ -125,6 +187,7 @@ static int bench(void)
       ret |= crypto_sign_signature_internal(sig, &siglen, m, MLEN, pre,
                                             CTXLEN + 2, sig_rand, sk, 0);
     }
+    get_perf_events(&e0);
     t0 = get_cyclecounter();
     for (j = 0; j < NITERATIONS; j++)
     {
@@ -132,20 +195,25 @@ static int bench(void)
                                             CTXLEN + 2, sig_rand, sk, 0);
     }
     t1 = get_cyclecounter();
+    get_perf_events(&e1);
     cycles_sign[i] = t1 - t0;
+    add_perf_events(&ev_sign, &e0, &e1);
 
     /* Verification */
     for (j = 0; j < NWARMUP; j++)
     {
       ret |= crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
     }
+    get_perf_events(&e0);
     t0 = get_cyclecounter();
     for (j = 0; j < NITERATIONS; j++)
     {
       ret |= crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
     }
     t1 = get_cyclecounter();
+    get_perf_events(&e1);
     cycles_verify[i] = t1 - t0;
+    add_perf_events(&ev_verify, &e0, &e1);
 
     CHECK(ret == 0);
   }
@@ -167,14 +235,812 @@ static int bench(void)
   print_percentiles("sign", cycles_sign);
   print_percentiles("verify", cycles_verify);
 
+  if (perf_events)
+  {
+    printf("\n");
+    print_events("keypair", &ev_kg);
+    print_events("sign", &ev_sign);
+    print_events("verify", &ev_verify);
+  }
+
+  return 0;
+}
+
+#define SWEEP(res, niter, code)                                \
+  do                                                           \
+  {                                                            \
+    uint64_t cyc_[SWEEP_NTESTS], t0_, t1_;                     \
+    unsigned i_, j_;                                           \
+    code;                                                      \
+    for (i_ = 0; i_ < SWEEP_NTESTS; i_++)                      \
+    {                                                          \
+      t0_ = get_cyclecounter();                                \
+      for (j_ = 0; j_ < (niter); j_++)                         \
+      {                                                        \
+        code;                                                  \
+      }                                                        \
+      t1_ = get_cyclecounter();                                \
+      cyc_[i_] = (t1_ - t0_) / (niter);                        \
+    }                                                          \
+    qsort(cyc_, SWEEP_NTESTS, sizeof(uint64_t), cmp_uint64_t); \
+    (res) = cyc_[SWEEP_NTESTS >> 1];                           \
+  } while (0)
+
+static void print_sweep(const char *txt, size_t mlen, size_t ctxlen,
+                        uint64_t cyc)
+{
+  printf("%-12s mlen=%-9zu ctxlen=%-3zu cycles=%-12" PRIu64, txt, mlen,
+         ctxlen, cyc);
+  if (mlen != 0)
+  {
+    printf(" cpb=%.2f", (double)cyc / (double)mlen);
+  }
+  printf("\n");
+}
+
+/* Prints the smallest message size of the sweep at which hashing the
+ * message costs at least as much as the size-independent lattice work. */
+static void print_crossover(const char *txt, const size_t *mlens,
+                            const uint64_t *hash, unsigned n, uint64_t lattice)
+{
+  unsigned i;
+  for (i = 0; i < n; i++)
+  {
+    if (lattice != 0 && hash[i] >= lattice)
+    {
+      printf("%-12s crossover mlen=%zu (lattice cycles=%" PRIu64 ")\n", txt,
+             mlens[i], lattice);
+      return;
+    }
+  }
+  printf("%-12s crossover not reached\n", txt);
+}
+
+/* Message-size and context-length sweep of sign, verify, the external-mu
+ * path (mu from a cached midstate, then sign/verify_extmu), and SHAKE256
+ * over the message alone. */
+static int sweep(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t ctx[SWEEP_MAXCTXLEN];
+  uint8_t mu[MLDSA_CRHBYTES];
+  keccak_state midstate;
+  size_t mlens[16];
+  uint64_t cyc_shake[16];
+  uint64_t cyc, cyc_sign_lattice, cyc_verify_lattice;
+  size_t siglen, mlen, ctxlen;
+  unsigned k, n, niter;
+  uint8_t *m;
+  int ret = 0;
+
+  m = malloc(SWEEP_MAXLEN);
+  CHECK(m != NULL);
+  randombytes(m, SWEEP_MAXLEN);
+  randombytes(ctx, SWEEP_MAXCTXLEN);
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  CHECK(crypto_sign_mu_midstate(&midstate, pk) == 0);
+
+  /* Size-independent lattice work, i.e., everything after computing mu */
+  CHECK(crypto_sign_mu_from_midstate(mu, &midstate, m, 0, NULL, 0) == 0);
+  SWEEP(cyc_sign_lattice, SWEEP_NITERATIONS,
+        ret |= crypto_sign_signature_extmu(sig, &siglen, mu, sk));
+  SWEEP(cyc_verify_lattice, SWEEP_NITERATIONS,
+        ret |= crypto_sign_verify_extmu(sig, siglen, mu, pk));
+  print_sweep("sign_extmu", 0, 0, cyc_sign_lattice);
+  print_sweep("verify_extmu", 0, 0, cyc_verify_lattice);
+  printf("\n");
+
+  n = 0;
+  for (mlen = 0; mlen <= SWEEP_MAXLEN; mlen = (mlen == 0) ? 1 : 4 * mlen)
+  {
+    niter = (mlen < SWEEP_LONGLEN) ? SWEEP_NITERATIONS : 1;
+
+    SWEEP(cyc, niter, shake256(mu, MLDSA_CRHBYTES, m, mlen));
+    print_sweep("shake256", mlen, 0, cyc);
+    mlens[n] = mlen;
+    cyc_shake[n] = cyc;
+    n++;
+
+    SWEEP(cyc, niter,
+          ret |= crypto_sign_signature(sig, &siglen, m, mlen, NULL, 0, sk));
+    print_sweep("sign", mlen, 0, cyc);
+
+    SWEEP(cyc, niter,
+          ret |= crypto_sign_verify(sig, siglen, m, mlen, NULL, 0, pk));
+    print_sweep("verify", mlen, 0, cyc);
+
+    SWEEP(cyc, niter, {
+      ret |= crypto_sign_mu_from_midstate(mu, &midstate, m, mlen, NULL, 0);
+      ret |= crypto_sign_signature_extmu(sig, &siglen, mu, sk);
+    });
+    print_sweep("sign_mu", mlen, 0, cyc);
+
+    SWEEP(cyc, niter, {
+      ret |= crypto_sign_mu_from_midstate(mu, &midstate, m, mlen, NULL, 0);
+      ret |= crypto_sign_verify_extmu(sig, siglen, mu, pk);
+    });
+    print_sweep("verify_mu", mlen, 0, cyc);
+    printf("\n");
+  }
+
+  for (k = 0; k <= 8; k++)
+  {
+    ctxlen = (k == 0) ? 0 : ((k == 8) ? SWEEP_MAXCTXLEN : ((size_t)1 << k));
+
+    SWEEP(cyc, SWEEP_NITERATIONS,
+          ret |= crypto_sign_signature(sig, &siglen, m, SWEEP_CTX_MLEN, ctx,
+                                       ctxlen, sk));
+    print_sweep("sign", SWEEP_CTX_MLEN, ctxlen, cyc);
+
+    SWEEP(cyc, SWEEP_NITERATIONS,
+          ret |= crypto_sign_verify(sig, siglen, m, SWEEP_CTX_MLEN, ctx,
+                                    ctxlen, pk));
+    print_sweep("verify", SWEEP_CTX_MLEN, ctxlen, cyc);
+  }
+  printf("\n");
+
+  print_crossover("sign", mlens, cyc_shake, n, cyc_sign_lattice);
+  print_crossover("verify", mlens, cyc_shake, n, cyc_verify_lattice);
+
+  free(m);
+  CHECK(ret == 0);
+  return 0;
+}
+
+typedef enum
+{
+  KEYS_SIGN,
+  KEYS_SIGN_CTX,
+  KEYS_VERIFY,
+  KEYS_VERIFY_EXPANDED,
+  KEYS_NUM_PATHS
+} keys_path;
+
+static const char *keys_path_names[KEYS_NUM_PATHS] = {
+    "sign", "sign_ctx", "verify", "verify_expanded"};
+
+/* Number of key-set sizes 1, 10, ..., KEYS_MAX */
+#define KEYS_NUM_SIZES 6
+
+typedef struct
+{
+  uint8_t pk[KEYS_DISTINCT][CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[KEYS_DISTINCT][CRYPTO_SECRETKEYBYTES];
+  uint8_t epk[KEYS_DISTINCT][CRYPTO_EXPANDEDPUBLICKEYBYTES];
+  uint8_t sig[KEYS_DISTINCT][CRYPTO_BYTES];
+  mld_sign_ctx sctx[KEYS_DISTINCT];
+  uint8_t m[MLEN];
+} keys_material;
+
+static size_t keys_size(keys_path path)
+{
+  switch (path)
+  {
+    case KEYS_SIGN:
+      return CRYPTO_SECRETKEYBYTES;
+    case KEYS_SIGN_CTX:
+      return sizeof(mld_sign_ctx);
+    case KEYS_VERIFY:
+      return CRYPTO_PUBLICKEYBYTES;
+    case KEYS_VERIFY_EXPANDED:
+      return CRYPTO_EXPANDEDPUBLICKEYBYTES;
+    case KEYS_NUM_PATHS:
+      break;
+  }
+  return 0;
+}
+
+/* Distance between copies of a key, in whole cache lines, which also keeps
+ * every copy aligned */
+static size_t keys_stride(keys_path path)
+{
+  return (keys_size(path) + 63) & ~(size_t)63;
+}
+
+/* Whether a set of n keys fits into KEYS_MAXMEM */
+static int keys_fit(keys_path path, size_t n)
+{
+  return n <= KEYS_MAXMEM / keys_stride(path);
+}
+
+static const void *keys_distinct(const keys_material *km, keys_path path,
+                                 unsigned k)
+{
+  switch (path)
+  {
+    case KEYS_SIGN:
+      return km->sk[k];
+    case KEYS_SIGN_CTX:
+      return &km->sctx[k];
+    case KEYS_VERIFY:
+      return km->pk[k];
+    case KEYS_VERIFY_EXPANDED:
+      return km->epk[k];
+    case KEYS_NUM_PATHS:
+      break;
+  }
+  return NULL;
+}
+
+/* Runs one operation with the key at index idx of the set; the copies of
+ * distinct key k are at the indices congruent to k mod KEYS_DISTINCT. */
+static int keys_run(const keys_material *km, keys_path path, const void *key,
+                    size_t idx)
+{
+  uint8_t sig[CRYPTO_BYTES];
+  size_t siglen;
+  const uint8_t *s = km->sig[idx % KEYS_DISTINCT];
+
+  switch (path)
+  {
+    case KEYS_SIGN:
+      return crypto_sign_signature(sig, &siglen, km->m, MLEN, NULL, 0,
+                                   (const uint8_t *)key);
+    case KEYS_SIGN_CTX:
+      return crypto_sign_signature_ctx(sig, &siglen, km->m, MLEN, NULL, 0,
+                                       (const mld_sign_ctx *)key);
+    case KEYS_VERIFY:
+      return crypto_sign_verify(s, CRYPTO_BYTES, km->m, MLEN, NULL, 0,
+                                (const uint8_t *)key);
+    case KEYS_VERIFY_EXPANDED:
+      return crypto_sign_verify_expanded(s, CRYPTO_BYTES, km->m, MLEN, NULL, 0,
+                                         (const uint8_t *)key);
+    case KEYS_NUM_PATHS:
+      break;
+  }
+  return -1;
+}
+
+/* xorshift32, so that the key sequence is reproducible and does not follow
+ * a pattern that a hardware prefetcher could learn. */
+static uint32_t keys_rng = 0x9e3779b9;
+
+/* Index of the key of the i-th operation on a set of n keys. The copy is
+ * chosen at random, but the distinct key is i mod KEYS_DISTINCT (for
+ * n >= KEYS_DISTINCT), so that every key-set size and path performs the
+ * same sequence of signatures with the same number of attempts. */
+static size_t keys_next(size_t i, size_t n)
+{
+  if (n < KEYS_DISTINCT)
+  {
+    return i % n;
+  }
+  keys_rng ^= keys_rng << 13;
+  keys_rng ^= keys_rng >> 17;
+  keys_rng ^= keys_rng << 5;
+  return (keys_rng % (n / KEYS_DISTINCT)) * KEYS_DISTINCT +
+         i % KEYS_DISTINCT;
+}
+
+/* Median cycles of one operation on a set of n keys. With flush set, the
+ * key material is evicted from the caches before each operation. */
+static int keys_measure(uint64_t *median, const keys_material *km,
+                        keys_path path, size_t n, int flush)
+{
+  static uint64_t cyc[KEYS_NOPS];
+  size_t size = keys_size(path), stride = keys_stride(path);
+  uint64_t t0, t1;
+  void *p;
+  uint8_t *keys;
+  size_t i, idx;
+  int ret = 0;
+
+  CHECK(posix_memalign(&p, 64, n * stride) == 0);
+  keys = (uint8_t *)p;
+  for (i = 0; i < n; i++)
+  {
+    memcpy(keys + i * stride, keys_distinct(km, path, i % KEYS_DISTINCT),
+           size);
+  }
+
+  for (i = 0; i < NWARMUP; i++)
+  {
+    idx = keys_next(i, n);
+    ret |= keys_run(km, path, keys + idx * stride, idx);
+  }
+  for (i = 0; i < KEYS_NOPS; i++)
+  {
+    idx = keys_next(i, n);
+    if (flush)
+    {
+      flush_cache(keys + idx * stride, size);
+    }
+    /* Same signing randomness rnd for every operation */
+    randombytes_reset();
+    t0 = get_cyclecounter();
+    ret |= keys_run(km, path, keys + idx * stride, idx);
+    t1 = get_cyclecounter();
+    cyc[i] = t1 - t0;
+  }
+
+  /* The sign_ctx copies contain secret keys */
+  memset(keys, 0, n * stride);
+  free(keys);
+  CHECK(ret == 0);
+
+  qsort(cyc, KEYS_NOPS, sizeof(uint64_t), cmp_uint64_t);
+  *median = cyc[KEYS_NOPS >> 1];
+  return 0;
+}
+
+/* Skipped or unmeasured (CYCLES=NO) entries are 0 */
+static void print_keys_speedup(const char *txt, uint64_t raw, uint64_t ctx)
+{
+  if (raw == 0 || ctx == 0)
+  {
+    printf(" %s=-", txt);
+  }
+  else
+  {
+    printf(" %s=%.2f", txt, (double)raw / (double)ctx);
+  }
+}
+
+/* Cost of signing and verifying when rotating across many keys, with and
+ * without flushing the key material from the caches before each operation,
+ * for the raw API (sign, verify) and the precomputed-key API (sign_ctx,
+ * verify_expanded). The speedup of the latter shows where caching expanded
+ * keys pays off, relative to the number of keys that need to be cached. */
+static int keys(void)
+{
+  static keys_material km;
+  static uint64_t cyc[KEYS_NUM_PATHS][KEYS_NUM_SIZES][2];
+  size_t siglen, n;
+  unsigned k, s, flush;
+  keys_path path;
+
+  randombytes(km.m, MLEN);
+  for (k = 0; k < KEYS_DISTINCT; k++)
+  {
+    CHECK(crypto_sign_keypair_ctx(km.pk[k], km.sk[k], &km.sctx[k]) == 0);
+    CHECK(crypto_sign_expand_pk(km.epk[k], km.pk[k]) == 0);
+    CHECK(crypto_sign_signature(km.sig[k], &siglen, km.m, MLEN, NULL, 0,
+                                km.sk[k]) == 0);
+  }
+
+  printf("%-16s %7s %10s %10s %9s\n", "path", "keys", "warm", "cold",
+         "key_bytes");
+  for (path = KEYS_SIGN; path < KEYS_NUM_PATHS; path++)
+  {
+    for (s = 0, n = 1; s < KEYS_NUM_SIZES && n <= KEYS_MAX; s++, n *= 10)
+    {
+      if (!keys_fit(path, n))
+      {
+        printf("%-16s %7zu %10s %10s %9zu (exceeds KEYS_MAXMEM)\n",
+               keys_path_names[path], n, "-", "-", keys_size(path));
+        continue;
+      }
+      for (flush = 0; flush < 2; flush++)
+      {
+        CHECK(keys_measure(&cyc[path][s][flush], &km, path, n, (int)flush) ==
+              0);
+      }
+      printf("%-16s %7zu %10" PRIu64 " %10" PRIu64 " %9zu\n",
+             keys_path_names[path], n, cyc[path][s][0], cyc[path][s][1],
+             keys_size(path));
+    }
+    printf("\n");
+  }
+
+  /* Speedup of the precomputed-key API over the raw API */
+  for (s = 0, n = 1; s < KEYS_NUM_SIZES && n <= KEYS_MAX; s++, n *= 10)
+  {
+    printf("speedup keys=%-7zu", n);
+    print_keys_speedup("sign_warm", cyc[KEYS_SIGN][s][0],
+                       cyc[KEYS_SIGN_CTX][s][0]);
+    print_keys_speedup("sign_cold", cyc[KEYS_SIGN][s][1],
+                       cyc[KEYS_SIGN_CTX][s][1]);
+    print_keys_speedup("verify_warm", cyc[KEYS_VERIFY][s][0],
+                       cyc[KEYS_VERIFY_EXPANDED][s][0]);
+    print_keys_speedup("verify_cold", cyc[KEYS_VERIFY][s][1],
+                       cyc[KEYS_VERIFY_EXPANDED][s][1]);
+    printf("\n");
+  }
+  return 0;
+}
+
+/* HDR-style log-linear histogram: values below 2^LATENCY_SUB_BITS have a
+ * bucket each; above, each power of two is split into 2^LATENCY_SUB_BITS
+ * buckets of equal width. */
+static unsigned latency_bucket(uint64_t v)
+{
+  unsigned e = 0;
+
+  if (v < (1u << LATENCY_SUB_BITS))
+  {
+    return (unsigned)v;
+  }
+  while ((v >> e) > 1)
+  {
+    e++;
+  }
+  return ((e - LATENCY_SUB_BITS + 1) << LATENCY_SUB_BITS) |
+         (unsigned)((v >> (e - LATENCY_SUB_BITS)) &
+                    ((1u << LATENCY_SUB_BITS) - 1));
+}
+
+/* Smallest value of a bucket */
+static uint64_t latency_bucket_min(unsigned b)
+{
+  unsigned e, sub;
+
+  if (b < (1u << LATENCY_SUB_BITS))
+  {
+    return b;
+  }
+  e = (b >> LATENCY_SUB_BITS) + LATENCY_SUB_BITS - 1;
+  sub = b & ((1u << LATENCY_SUB_BITS) - 1);
+  return ((uint64_t)((1u << LATENCY_SUB_BITS) | sub)) << (e - LATENCY_SUB_BITS);
+}
+
+/* Value at quantile q, in thousandths, reported as the smallest value of
+ * the bucket that contains it */
+static uint64_t latency_quantile(const uint64_t *hist, uint64_t n, unsigned q)
+{
+  uint64_t rank = (n * q + 999) / 1000, sum = 0;
+  unsigned b;
+
+  for (b = 0; b < LATENCY_NUM_BUCKETS; b++)
+  {
+    sum += hist[b];
+    if (sum >= rank && sum != 0)
+    {
+      return latency_bucket_min(b);
+    }
+  }
+  return 0;
+}
+
+typedef struct
+{
+  uint64_t cycles;
+  uint64_t attempts; /* 0 unless built with MLD_CONFIG_STATS */
+  uint8_t seed[MLDSA_SEEDBYTES];
+  uint8_t rnd[MLDSA_RNDBYTES];
+  uint8_t ctx[CTXLEN];
+  uint8_t m[MLEN];
+} latency_call;
+
+/* Orders latency_call by decreasing cycles */
+static int cmp_latency_call(const void *a, const void *b)
+{
+  const latency_call *x = (const latency_call *)a;
+  const latency_call *y = (const latency_call *)b;
+  return (x->cycles < y->cycles) - (x->cycles > y->cycles);
+}
+
+static void print_hex(const char *name, const uint8_t *buf, size_t len)
+{
+  printf(" %s=", name);
+  for (; len > 0; len--, buf++)
+  {
+    printf("%02X", *buf);
+  }
+}
+
+/* Signs once with the inputs of c, through the same function as the
+ * latency measurement, and returns the cycles taken. */
+static uint64_t latency_sign(const latency_call *c, uint8_t *sig,
+                             uint64_t *attempts, int *ret)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t pre[CTXLEN + 2];
+  size_t siglen;
+  uint64_t t0, t1;
+
+  *ret |= crypto_sign_keypair_internal(pk, sk, c->seed);
+  pre[0] = 0;
+  pre[1] = CTXLEN;
+  memcpy(pre + 2, c->ctx, CTXLEN);
+
+  t0 = get_cyclecounter();
+  *ret |= crypto_sign_signature_internal(sig, &siglen, c->m, MLEN, pre,
+                                         CTXLEN + 2, c->rnd, sk, 0);
+  t1 = get_cyclecounter();
+
+#if defined(MLD_CONFIG_STATS)
+  {
+    mld_sign_stats stats;
+    crypto_sign_stats_get(&stats);
+    *attempts = stats.last_attempts;
+  }
+#else
+  *attempts = 0;
+#endif
+  return t1 - t0;
+}
+
+/* Tail latency of signing: every call is timed individually and recorded
+ * in a histogram, and the inputs of the slowest calls are printed. They
+ * are replayed here to check that the latency is reproducible, and can be
+ * replayed separately, e.g. with acvp_mldsa{lvl} keyGen seed=... to obtain
+ * sk, followed by acvp_mldsa{lvl} sigGen message=... rnd=... sk=...
+ * context=..., which signs through crypto_sign_signature_internal() as
+ * well. */
+static int latency(void)
+{
+  static uint64_t hist[LATENCY_NUM_BUCKETS];
+  static latency_call slowest[LATENCY_SLOWEST];
+  static const unsigned quantiles[] = {500, 900, 990, 999};
+  static const char *quantile_names[] = {"p50", "p90", "p99", "p99.9"};
+  uint8_t sig[CRYPTO_BYTES], sig2[CRYPTO_BYTES];
+  latency_call c;
+  uint64_t cyc, max = 0, attempts;
+  unsigned i, k, min_k, num_slowest = 0;
+  int ret = 0;
+
+  for (i = 0; i < LATENCY_NTESTS; i++)
+  {
+    randombytes(c.seed, sizeof(c.seed));
+    randombytes(c.rnd, sizeof(c.rnd));
+    randombytes(c.ctx, sizeof(c.ctx));
+    randombytes(c.m, sizeof(c.m));
+    c.cycles = latency_sign(&c, sig, &c.attempts, &ret);
+    hist[latency_bucket(c.cycles)]++;
+    max = (c.cycles > max) ? c.cycles : max;
+
+    /* Keep the LATENCY_SLOWEST slowest calls, replacing the fastest */
+    if (num_slowest < LATENCY_SLOWEST)
+    {
+      slowest[num_slowest++] = c;
+      continue;
+    }
+    min_k = 0;
+    for (k = 1; k < LATENCY_SLOWEST; k++)
+    {
+      if (slowest[k].cycles < slowest[min_k].cycles)
+      {
+        min_k = k;
+      }
+    }
+    if (c.cycles > slowest[min_k].cycles)
+    {
+      slowest[min_k] = c;
+    }
+  }
+  CHECK(ret == 0);
+
+  printf("sign latency over %d calls (cycles):", LATENCY_NTESTS);
+  for (k = 0; k < sizeof(quantiles) / sizeof(quantiles[0]); k++)
+  {
+    printf(" %s=%" PRIu64, quantile_names[k],
+           latency_quantile(hist, LATENCY_NTESTS, quantiles[k]));
+  }
+  printf(" max=%" PRIu64 "\n\n", max);
+
+  /* Non-empty buckets, by their smallest value */
+  for (k = 0; k < LATENCY_NUM_BUCKETS; k++)
+  {
+    if (hist[k] != 0)
+    {
+      printf("bucket=%-10" PRIu64 " count=%" PRIu64 "\n",
+             latency_bucket_min(k), hist[k]);
+    }
+  }
+  printf("\n");
+
+  /* Slowest calls, slowest first, each replayed once */
+  qsort(slowest, num_slowest, sizeof(latency_call), cmp_latency_call);
+  for (k = 0; k < num_slowest; k++)
+  {
+    const latency_call *s = &slowest[k];
+    latency_sign(s, sig, &attempts, &ret);
+    cyc = latency_sign(s, sig2, &attempts, &ret);
+    CHECK(memcmp(sig, sig2, CRYPTO_BYTES) == 0);
+    printf("cycles=%" PRIu64 " replay=%" PRIu64, s->cycles, cyc);
+#if defined(MLD_CONFIG_STATS)
+    printf(" attempts=%" PRIu64, s->attempts);
+#endif
+    print_hex("seed", s->seed, sizeof(s->seed));
+    print_hex("rnd", s->rnd, sizeof(s->rnd));
+    print_hex("context", s->ctx, sizeof(s->ctx));
+    print_hex("message", s->m, sizeof(s->m));
+    printf("\n");
+  }
+  CHECK(ret == 0);
+  return 0;
+}
+
+#if defined(MLD_CONFIG_STATS)
+typedef struct
+{
+  uint64_t cycles;
+  uint64_t attempts;
+} sign_sample;
+
+static int cmp_sample_cycles(const void *a, const void *b)
+{
+  const sign_sample *x = (const sign_sample *)a;
+  const sign_sample *y = (const sign_sample *)b;
+  return (x->cycles > y->cycles) - (x->cycles < y->cycles);
+}
+
+static int cmp_sample_attempts(const void *a, const void *b)
+{
+  const sign_sample *x = (const sign_sample *)a;
+  const sign_sample *y = (const sign_sample *)b;
+  if (x->attempts != y->attempts)
+  {
+    return (x->attempts > y->attempts) - (x->attempts < y->attempts);
+  }
+  return cmp_sample_cycles(a, b);
+}
+
+/* Correlates the latency of signing with the number of attempts of the
+ * rejection loop, as recorded by MLD_CONFIG_STATS. */
+static int attempts(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  static sign_sample samples[ATTEMPTS_NTESTS];
+  static const char *reasons[MLD_STATS_NUM_REJECTS] = {"z", "w0", "h",
+                                                       "hint"};
+  mld_sign_stats stats;
+  size_t siglen;
+  uint64_t t0, t1, sum;
+  unsigned i, j, k, from, to;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  crypto_sign_stats_reset();
+
+  for (i = 0; i < ATTEMPTS_NTESTS; i++)
+  {
+    randombytes(m, MLEN);
+    t0 = get_cyclecounter();
+    CHECK(crypto_sign_signature(sig, &siglen, m, MLEN, NULL, 0, sk) == 0);
+    t1 = get_cyclecounter();
+    crypto_sign_stats_get(&stats);
+    samples[i].cycles = t1 - t0;
+    samples[i].attempts = stats.last_attempts;
+  }
+
+  printf("signatures=%" PRIu64 " attempts=%" PRIu64 " (avg %.2f)\n",
+         stats.signatures, stats.attempts,
+         (double)stats.attempts / (double)stats.signatures);
+  for (k = 0; k < MLD_STATS_NUM_REJECTS; k++)
+  {
+    printf("%10s rejects=%" PRIu64 "\n", reasons[k], stats.rejects[k]);
+  }
+  printf("xof_extra_blocks=%" PRIu64 "\n\n", stats.xof_extra_blocks);
+
+  /* Latency by number of attempts */
+  qsort(samples, ATTEMPTS_NTESTS, sizeof(sign_sample), cmp_sample_attempts);
+  for (i = 0; i < ATTEMPTS_NTESTS; i = j)
+  {
+    j = i;
+    while (j < ATTEMPTS_NTESTS && samples[j].attempts == samples[i].attempts)
+    {
+      j++;
+    }
+    printf("attempts=%-3" PRIu64 " count=%-5u median=%" PRIu64 " p90=%" PRIu64
+           "\n",
+           samples[i].attempts, j - i, samples[i + (j - i) / 2].cycles,
+           samples[i + (j - i) * 9 / 10].cycles);
+  }
+  printf("\n");
+
+  /* Average number of attempts between consecutive latency percentiles */
+  qsort(samples, ATTEMPTS_NTESTS, sizeof(sign_sample), cmp_sample_cycles);
+  from = 0;
+  for (k = 0; k < sizeof(percentiles) / sizeof(percentiles[0]); k++)
+  {
+    to = ATTEMPTS_NTESTS * percentiles[k] / 100;
+    sum = 0;
+    for (i = from; i <= to; i++)
+    {
+      sum += samples[i].attempts;
+    }
+    printf("percentile=%-3d cycles=%-10" PRIu64 " avg_attempts=%.2f\n",
+           percentiles[k], samples[to].cycles,
+           (double)sum / (double)(to - from + 1));
+    from = to + 1;
+  }
+  return 0;
+}
+#else  /* MLD_CONFIG_STATS */
+static int attempts(void)
+{
+  fprintf(stderr, "--attempts requires building with MLD_CONFIG_STATS\n");
+  return 1;
+}
+#endif /* !MLD_CONFIG_STATS */
+
+#if defined(MLD_CONFIG_PROFILE_HOOK)
+#if MLDSA_MODE == 2
+#define PROFILE_PREFIX "ML-DSA-44"
+#elif MLDSA_MODE == 3
+#define PROFILE_PREFIX "ML-DSA-65"
+#elif MLDSA_MODE == 5
+#define PROFILE_PREFIX "ML-DSA-87"
+#endif
+
+/* Prints the average cycles per operation spent in each phase, as recorded
+ * by the reference collector in test/hal/profile.c. The output is in folded
+ * stack format, e.g. for `flamegraph.pl --countname cycles`. */
+static int profile(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  size_t siglen;
+  unsigned i;
+
+  randombytes(m, MLEN);
+  randombytes(ctx, CTXLEN);
+  profile_reset();
+
+  for (i = 0; i < PROFILE_NTESTS; i++)
+  {
+    CHECK(crypto_sign_keypair(pk, sk) == 0);
+    CHECK(crypto_sign_signature(sig, &siglen, m, MLEN, ctx, CTXLEN, sk) == 0);
+    CHECK(crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk) == 0);
+  }
+
+  profile_print(stdout, PROFILE_PREFIX, PROFILE_NTESTS);
   return 0;
 }
+#else  /* MLD_CONFIG_PROFILE_HOOK */
+static int profile(void)
+{
+  fprintf(stderr,
+          "--profile requires building with MLD_CONFIG_PROFILE_HOOK\n");
+  return 1;
+}
+#endif /* !MLD_CONFIG_PROFILE_HOOK */
 
-int main(void)
+int main(int argc, char **argv)
 {
+  int r;
+
+  if (argc > 2 || (argc == 2 && strcmp(argv[1], "--sweep") != 0 &&
+                    strcmp(argv[1], "--attempts") != 0 &&
+                    strcmp(argv[1], "--profile") != 0 &&
+                    strcmp(argv[1], "--keys") != 0 &&
+                    strcmp(argv[1], "--latency") != 0))
+  {
+    fprintf(stderr,
+            "Usage: %s [--sweep | --attempts | --profile | --keys | "
+            "--latency]\n",
+            argv[0]);
+    return 1;
+  }
+
   enable_cyclecounter();
-  bench();
+  perf_events = enable_perf_events();
+  if (argc == 1)
+  {
+    r = bench();
+  }
+  else if (strcmp(argv[1], "--sweep") == 0)
+  {
+    r = sweep();
+  }
+  else if (strcmp(argv[1], "--attempts") == 0)
+  {
+    r = attempts();
+  }
+  else if (strcmp(argv[1], "--keys") == 0)
+  {
+    r = keys();
+  }
+  else if (strcmp(argv[1], "--latency") == 0)
+  {
+    r = latency();
+  }
+  else
+  {
+    r = profile();
+  }
+  disable_perf_events();
   disable_cyclecounter();
 
-  return 0;
+  return r;
 }
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "../mldsa/opcount.h"
+#include "../mldsa/randombytes.h"
+#include "../mldsa/sign.h"
+
+/* Operation-count benchmark.
+ *
+ * For each API operation, prints the average number of Keccak permutations,
+ * NTTs, matrix polynomials and rejection-sampler refills, as recorded by
+ * MLD_CONFIG_OPCOUNT. With the deterministic test randomness, the output is
+ * reproducible and can be compared across commits without measurement
+ * noise. The counts of signing include all rejected attempts. */
+
+#define NTESTS 100
+#define MLEN 59
+#define CTXLEN 1
+
+#if MLDSA_MODE == 2
+#define LEVEL 44
+#elif MLDSA_MODE == 3
+#define LEVEL 65
+#elif MLDSA_MODE == 5
+#define LEVEL 87
+#endif
+
+#define CHECK(x)                                              \
+  do                                                          \
+  {                                                           \
+    int rc;                                                   \
+    rc = (x);                                                 \
+    if (!rc)                                                  \
+    {                                                         \
+      fprintf(stderr, "ERROR (%s,%d)\n", __FILE__, __LINE__); \
+      return 1;                                               \
+    }                                                         \
+  } while (0)
+
+#if defined(MLD_CONFIG_OPCOUNT)
+
+typedef enum
+{
+  OP_KEYPAIR,
+  OP_KEYPAIR_CTX,
+  OP_SIGN,
+  OP_SIGN_CTX,
+  OP_VERIFY,
+  OP_VERIFY_EXPANDED,
+  OP_NUM
+} bench_op;
+
+static const char *op_names[OP_NUM] = {"keypair", "keypair_ctx",
+                                       "sign",    "sign_ctx",
+                                       "verify",  "verify_expanded"};
+
+static const char *count_names[MLD_OPCOUNT_NUM] = {
+    "keccak_x1", "keccak_x4", "ntt", "invntt", "matrix_poly", "xof_refill"};
+
+static MLD_ALIGN mld_sign_ctx sctx;
+
+static int run_op(bench_op op, uint8_t *pk, uint8_t *sk, uint8_t *epk,
+                  uint8_t *sig, const uint8_t *m, const uint8_t *ctx)
+{
+  size_t siglen;
+
+  switch (op)
+  {
+    case OP_KEYPAIR:
+      return crypto_sign_keypair(pk, sk);
+    case OP_KEYPAIR_CTX:
+      return crypto_sign_keypair_ctx(pk, sk, &sctx);
+    case OP_SIGN:
+      return crypto_sign_signature(sig, &siglen, m, MLEN, ctx, CTXLEN, sk);
+    case OP_SIGN_CTX:
+      return crypto_sign_signature_ctx(sig, &siglen, m, MLEN, ctx, CTXLEN,
+                                       &sctx);
+    case OP_VERIFY:
+      return crypto_sign_verify(sig, CRYPTO_BYTES, m, MLEN, ctx, CTXLEN, pk);
+    case OP_VERIFY_EXPANDED:
+      return crypto_sign_verify_expanded(sig, CRYPTO_BYTES, m, MLEN, ctx,
+                                         CTXLEN, epk);
+    case OP_NUM:
+      break;
+  }
+  return -1;
+}
+
+int main(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  static uint8_t epk[CRYPTO_EXPANDEDPUBLICKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  uint64_t total[OP_NUM][MLD_OPCOUNT_NUM] = {{0}};
+  mld_opcount counts;
+  unsigned i, k;
+  bench_op op;
+
+  for (i = 0; i < NTESTS; i++)
+  {
+    /* Each round uses a fresh key and message. Signing and verification
+     * use the key from crypto_sign_keypair_ctx(), and verification the
+     * signature from crypto_sign_signature_ctx(). */
+    for (op = OP_KEYPAIR; op < OP_NUM; op++)
+    {
+      if (op == OP_SIGN)
+      {
+        mld_randombytes(m, MLEN);
+        mld_randombytes(ctx, CTXLEN);
+        CHECK(crypto_sign_expand_pk(epk, pk) == 0);
+      }
+      crypto_sign_opcount_reset();
+      CHECK(run_op(op, pk, sk, epk, sig, m, ctx) == 0);
+      crypto_sign_opcount_get(&counts);
+      for (k = 0; k < MLD_OPCOUNT_NUM; k++)
+      {
+        total[op][k] += counts.count[k];
+      }
+    }
+  }
+
+  printf("ML-DSA-%d operation counts (average over %d operations)\n", LEVEL,
+         NTESTS);
+  printf("%-16s", "operation");
+  for (k = 0; k < MLD_OPCOUNT_NUM; k++)
+  {
+    printf(" %12s", count_names[k]);
+  }
+  printf("\n");
+  for (op = OP_KEYPAIR; op < OP_NUM; op++)
+  {
+    printf("%-16s", op_names[op]);
+    for (k = 0; k < MLD_OPCOUNT_NUM; k++)
+    {
+      printf(" %12.2f", (double)total[op][k] / NTESTS);
+    }
+    printf("\n");
+  }
+  return 0;
+}
+
+#else /* MLD_CONFIG_OPCOUNT */
+
+int main(void)
+{
+  fprintf(stderr,
+          "bench_opcount requires building with MLD_CONFIG_OPCOUNT, e.g.\n"
+          "  CFLAGS=-DMLD_CONFIG_OPCOUNT make run_bench_opcount\n");
+  return 1;
+}
+
+#endif /* !MLD_CONFIG_OPCOUNT */
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+
+#if defined(__linux__)
+#if !defined(_GNU_SOURCE)
+/* Ensure that clock_gettime(), nanosleep() and sysconf() are declared even
+ * when compiling with -std=c99 */
+#define _GNU_SOURCE
+#endif
+#endif
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../mldsa/fips202/fips202.h"
+#include "../mldsa/sign.h"
+
+/* Multi-threaded throughput benchmark.
+ *
+ * For every thread count from 1 to the number of online CPUs, and for each
+ * of keypair, sign and verify, the benchmark runs that many threads doing
+ * the operation in a loop for a fixed wall time. It reports the aggregate
+ * number of operations per second and the scaling efficiency relative to
+ * the single-threaded run,
+ *
+ *   efficiency(n) = ops/sec(n) / (n * ops/sec(1)).
+ *
+ * With -c, signing and verification use cached key contexts
+ * (crypto_sign_signature_ctx() and crypto_sign_verify_expanded()), and key
+ * generation additionally fills a signing context.
+ *
+ * Usage: bench_throughput_mldsaXX [-c] [-t <ms per run>] [-n <max threads>]
+ */
+
+#define MLEN 59
+#define CTXLEN 1
+#define DEFAULT_DURATION_MS 1000
+
+#if MLDSA_MODE == 2
+#define LEVEL 44
+#elif MLDSA_MODE == 3
+#define LEVEL 65
+#elif MLDSA_MODE == 5
+#define LEVEL 87
+#endif
+
+#define CHECK(x)                                              \
+  do                                                          \
+  {                                                           \
+    int rc;                                                   \
+    rc = (x);                                                 \
+    if (!rc)                                                  \
+    {                                                         \
+      fprintf(stderr, "ERROR (%s,%d)\n", __FILE__, __LINE__); \
+      exit(1);                                                \
+    }                                                         \
+  } while (0)
+
+/* WARNING: Test-only
+ * The test randomness in test/notrandombytes is not thread-safe, so this
+ * benchmark provides its own randombytes(): a counter, incremented under a
+ * lock, is expanded with SHAKE256. This is NOT a source of randomness. */
+static pthread_mutex_t rng_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t rng_ctr = 0;
+
+void randombytes(uint8_t *out, size_t outlen);
+void randombytes(uint8_t *out, size_t outlen)
+{
+  uint8_t ctr[8];
+  uint64_t c;
+  unsigned i;
+
+  pthread_mutex_lock(&rng_lock);
+  c = rng_ctr++;
+  pthread_mutex_unlock(&rng_lock);
+
+  for (i = 0; i < 8; i++)
+  {
+    ctr[i] = (uint8_t)(c >> (8 * i));
+  }
+  shake256(out, outlen, ctr, sizeof(ctr));
+}
+
+typedef enum
+{
+  OP_KEYPAIR,
+  OP_SIGN,
+  OP_VERIFY
+} bench_op;
+
+static const char *op_names[] = {"keypair", "sign", "verify"};
+
+/* Per-thread keys, signature and cached contexts, allocated on the heap to
+ * keep thread stacks small. */
+typedef struct
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  uint8_t epk[CRYPTO_EXPANDEDPUBLICKEYBYTES];
+  mld_sign_ctx sctx;
+  /* Outputs of the key generation runs, kept apart from the key used for
+   * signing and verification */
+  uint8_t kg_pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t kg_sk[CRYPTO_SECRETKEYBYTES];
+  mld_sign_ctx kg_sctx;
+} thread_data;
+
+typedef struct
+{
+  pthread_t thread;
+  thread_data *data;
+  bench_op op;
+  int cached;
+  uint64_t ops;
+  int err;
+} worker;
+
+static int go = 0;
+static int stop = 0;
+static unsigned ready = 0;
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int do_op(worker *w)
+{
+  thread_data *d = w->data;
+  size_t siglen;
+
+  switch (w->op)
+  {
+    case OP_KEYPAIR:
+      if (w->cached)
+      {
+        return crypto_sign_keypair_ctx(d->kg_pk, d->kg_sk, &d->kg_sctx);
+      }
+      return crypto_sign_keypair(d->kg_pk, d->kg_sk);
+    case OP_SIGN:
+      if (w->cached)
+      {
+        return crypto_sign_signature_ctx(d->sig, &siglen, d->m, MLEN, d->ctx,
+                                         CTXLEN, &d->sctx);
+      }
+      return crypto_sign_signature(d->sig, &siglen, d->m, MLEN, d->ctx, CTXLEN,
+                                   d->sk);
+    case OP_VERIFY:
+      if (w->cached)
+      {
+        return crypto_sign_verify_expanded(d->sig, CRYPTO_BYTES, d->m, MLEN,
+                                           d->ctx, CTXLEN, d->epk);
+      }
+      return crypto_sign_verify(d->sig, CRYPTO_BYTES, d->m, MLEN, d->ctx,
+                                CTXLEN, d->pk);
+  }
+  return -1;
+}
+
+static void *worker_main(void *arg)
+{
+  worker *w = (worker *)arg;
+
+  __atomic_add_fetch(&ready, 1, __ATOMIC_SEQ_CST);
+  while (!__atomic_load_n(&go, __ATOMIC_ACQUIRE))
+  {
+  }
+
+  while (!__atomic_load_n(&stop, __ATOMIC_RELAXED))
+  {
+    w->err |= do_op(w);
+    w->ops++;
+  }
+  return NULL;
+}
+
+/* Runs nthreads workers for duration_ms and returns the aggregate number of
+ * operations per second. */
+static double run(worker *workers, unsigned nthreads, bench_op op, int cached,
+                  unsigned duration_ms)
+{
+  struct timespec ts;
+  double t0, t1;
+  uint64_t ops = 0;
+  unsigned i;
+
+  __atomic_store_n(&go, 0, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&stop, 0, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&ready, 0, __ATOMIC_SEQ_CST);
+
+  for (i = 0; i < nthreads; i++)
+  {
+    workers[i].op = op;
+    workers[i].cached = cached;
+    workers[i].ops = 0;
+    workers[i].err = 0;
+    CHECK(pthread_create(&workers[i].thread, NULL, worker_main,
+                         &workers[i]) == 0);
+  }
+  while (__atomic_load_n(&ready, __ATOMIC_SEQ_CST) != nthreads)
+  {
+  }
+
+  t0 = now();
+  __atomic_store_n(&go, 1, __ATOMIC_RELEASE);
+
+  ts.tv_sec = duration_ms / 1000;
+  ts.tv_nsec = (long)(duration_ms % 1000) * 1000000;
+  nanosleep(&ts, NULL);
+
+  __atomic_store_n(&stop, 1, __ATOMIC_RELAXED);
+  for (i = 0; i < nthreads; i++)
+  {
+    CHECK(pthread_join(workers[i].thread, NULL) == 0);
+    CHECK(workers[i].err == 0);
+    ops += workers[i].ops;
+  }
+  t1 = now();
+
+  return (double)ops / (t1 - t0);
+}
+
+int main(int argc, char **argv)
+{
+  worker *workers;
+  unsigned duration_ms = DEFAULT_DURATION_MS;
+  unsigned max_threads;
+  unsigned i, n;
+  int cached = 0;
+  long ncpu;
+  bench_op op;
+
+  ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+  max_threads = ncpu > 0 ? (unsigned)ncpu : 1;
+
+  for (i = 1; i < (unsigned)argc; i++)
+  {
+    if (strcmp(argv[i], "-c") == 0)
+    {
+      cached = 1;
+    }
+    else if (strcmp(argv[i], "-t") == 0 && i + 1 < (unsigned)argc)
+    {
+      duration_ms = (unsigned)strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "-n") == 0 && i + 1 < (unsigned)argc)
+    {
+      max_threads = (unsigned)strtoul(argv[++i], NULL, 10);
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [-c] [-t <ms per run>] [-n <max threads>]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  if (max_threads == 0 || duration_ms == 0)
+  {
+    fprintf(stderr, "Thread count and duration must be positive\n");
+    return 1;
+  }
+
+  workers = calloc(max_threads, sizeof(worker));
+  CHECK(workers != NULL);
+
+  /* Every thread signs and verifies under its own key */
+  for (i = 0; i < max_threads; i++)
+  {
+    size_t siglen;
+    void *p;
+    thread_data *d;
+    /* The signing context requires the alignment of MLD_ALIGN */
+    CHECK(posix_memalign(&p, 64, sizeof(thread_data)) == 0);
+    d = (thread_data *)p;
+    workers[i].data = d;
+
+    randombytes(d->m, MLEN);
+    randombytes(d->ctx, CTXLEN);
+    CHECK(crypto_sign_keypair_ctx(d->pk, d->sk, &d->sctx) == 0);
+    CHECK(crypto_sign_expand_pk(d->epk, d->pk) == 0);
+    CHECK(crypto_sign_signature(d->sig, &siglen, d->m, MLEN, d->ctx, CTXLEN,
+                                d->sk) == 0);
+  }
+
+  printf("ML-DSA-%d throughput (%s keys, %u ms per run, up to %u threads)\n",
+         LEVEL, cached ? "cached" : "uncached",
+         duration_ms, max_threads);
+
+  for (op = OP_KEYPAIR; op <= OP_VERIFY; op++)
+  {
+    double base = 0;
+    for (n = 1; n <= max_threads; n++)
+    {
+      double rate = run(workers, n, op, cached, duration_ms);
+      if (n == 1)
+      {
+        base = rate;
+      }
+      printf("%-8s threads=%-3u ops/sec=%.1f efficiency=%.2f\n",
+             op_names[op], n, rate, rate / (n * base));
+    }
+  }
+
+  for (i = 0; i < max_threads; i++)
+  {
+    free(workers[i].data);
+  }
+  free(workers);
+  return 0;
+}
@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#ifndef MLD_CONFIG_H
+#define MLD_CONFIG_H
+
+#define MLD_RANDOMIZED_SIGNING
+
+#ifndef MLDSA_MODE
+#define MLDSA_MODE 2
+#endif
+
+#if MLDSA_MODE == 2
+#define MLD_NAMESPACETOP MLD_44_ref
+#define MLD_NAMESPACE(s) MLD_44_ref_##s
+#elif MLDSA_MODE == 3
+#define MLD_NAMESPACETOP MLD_65_ref
+#define MLD_NAMESPACE(s) MLD_65_ref_##s
+#elif MLDSA_MODE == 5
+#define MLD_NAMESPACETOP MLD_87_ref
+#define MLD_NAMESPACE(s) MLD_87_ref_##s
+#endif
+
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_FILE
+ *
+ * Description: If defined, this is a header that will be included instead
+ *              of this default configuration file mldsa/config.h.
+ *
+ *              When you need to build mldsa-native in multiple configurations,
+ *              using varying MLD_CONFIG_FILE can be more convenient
+ *              then configuring everything through CFLAGS.
+ *
+ *              To use, MLD_CONFIG_FILE _must_ be defined prior
+ *              to the inclusion of any mldsa-native headers. For example,
+ *              it can be set by passing `-DMLD_CONFIG_FILE="..."`
+ *              on the command line.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_FILE "config.h" */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_MULTILEVEL_BUILD
+ *
+ * Description: Set this option when building mldsa-native for multiple
+ *              parameter sets into a single library or binary.
+ *
+ *              Level-independent code (FIPS202, NTT, modular reduction,
+ *              constant-time helpers, native backends) is then namespaced
+ *              without the parameter set (MLD_ref_*) and shared between
+ *              the levels. The dispatchers mldsa_keypair(), mldsa_sign()
+ *              and mldsa_verify() from api.h are also provided.
+ *
+ *              Exactly one of the builds must include the shared code;
+ *              all others must set MLD_CONFIG_MULTILEVEL_NO_SHARED.
+ *              All builds must use the same configuration apart from
+ *              MLDSA_MODE and MLD_CONFIG_MULTILEVEL_NO_SHARED.
+ *
+ *              See the `$(BUILD_DIR)/libmldsa_multilevel.a` target in
+ *              test/mk/components.mk, which `make lib` builds.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_MULTILEVEL_BUILD */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_MULTILEVEL_NO_SHARED
+ *
+ * Description: If this option is set, level-independent code is omitted
+ *              from the build. This is used for all but one of the builds
+ *              in a multilevel build; see MLD_CONFIG_MULTILEVEL_BUILD.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_MULTILEVEL_NO_SHARED */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_ARITH_BACKEND_FILE
+ *
+ * Description: The arithmetic backend to use.
+ *
+ *              If MLD_CONFIG_USE_NATIVE_BACKEND_ARITH is unset, this option
+ *              is ignored.
+ *
+ *              If MLD_CONFIG_USE_NATIVE_BACKEND_ARITH is set, this option must
+ *              either be undefined or the filename of an arithmetic backend.
+ *              If unset, the default backend will be used.
+ *
+ *              This can be set using CFLAGS.
+ *
+ *****************************************************************************/
+#if defined(MLD_CONFIG_USE_NATIVE_BACKEND_ARITH) && \
+    !defined(MLD_CONFIG_ARITH_BACKEND_FILE)
+#define MLD_CONFIG_ARITH_BACKEND_FILE "native/meta.h"
+#endif
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_FIPS202_BACKEND_FILE
+ *
+ * Description: The FIPS-202 backend to use.
+ *
+ *              If MLD_CONFIG_USE_NATIVE_BACKEND_FIPS202 is set, this option
+ *              must either be undefined or the filename of a FIPS202 backend.
+ *              If unset, the default backend will be used.
+ *
+ *              This can be set using CFLAGS.
+ *
+ *****************************************************************************/
+#if defined(MLD_CONFIG_USE_NATIVE_BACKEND_FIPS202) && \
+    !defined(MLD_CONFIG_FIPS202_BACKEND_FILE)
+#define MLD_CONFIG_FIPS202_BACKEND_FILE "fips202/native/auto.h"
+#endif
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_CUSTOM_ZEROIZE
+ *
+ * Description: In compliance with FIPS 204 Section 3.6.3, mldsa-native zeroizes
+ *              intermediate stack buffers before returning from function calls.
+ *
+ *              Set this option and define `mld_zeroize_native` if you want to
+ *              use a custom method to zeroize intermediate stack buffers.
+ *              The default implementation uses SecureZeroMemory on Windows
+ *              and a memset + compiler barrier otherwise. If neither of those
+ *              is available on the target platform, compilation will fail,
+ *              and you will need to use MLD_CONFIG_CUSTOM_ZEROIZE to provide
+ *              a custom implementation of `mld_zeroize_native()`.
+ *
+ *              WARNING:
+ *              The explicit stack zeroization conducted by mldsa-native
+ *              reduces the likelihood of data leaking on the stack, but
+ *              does not eliminate it! The C standard makes no guarantee about
+ *              where a compiler allocates structures and whether/where it makes
+ *              copies of them. Also, in addition to entire structures, there
+ *              may also be potentially exploitable leakage of individual values
+ *              on the stack.
+ *
+ *              If you need bullet-proof zeroization of the stack, you need to
+ *              consider additional measures instead of what this feature
+ *              provides. In this case, you can set mld_zeroize_native to a
+ *              no-op.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_CUSTOM_ZEROIZE
+   #if !defined(__ASSEMBLER__)
+   #include <stdint.h>
+   #include "sys.h"
+   static MLD_INLINE void mld_zeroize_native(void *ptr, size_t len)
+   {
+       ... your implementation ...
+   }
+   #endif
+*/
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_KEYGEN_PCT
+ *
+ * Description: Compliance with @[FIPS140_3_IG, p.87] requires a
+ *              Pairwise Consistency Test (PCT) to be carried out on a freshly
+ *              generated keypair before it can be exported.
+ *
+ *              Set this option if such a check should be implemented.
+ *              In this case, crypto_sign_keypair_internal and
+ *              crypto_sign_keypair will return a non-zero error code if the
+ *              PCT failed.
+ *
+ *              NOTE: This feature will drastically lower the performance of
+ *              key generation.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_KEYGEN_PCT */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_KEYGEN_PCT_BREAKAGE_TEST
+ *
+ * Description: If this option is set, the user must provide a runtime
+ *              function `static inline int mld_break_pct() { ... }` to
+ *              indicate whether the PCT should be made fail.
+ *
+ *              This option only has an effect if MLD_CONFIG_KEYGEN_PCT is set.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_KEYGEN_PCT_BREAKAGE_TEST
+   #if !defined(__ASSEMBLER__)
+   #include "sys.h"
+   static MLD_INLINE int mld_break_pct(void)
+   {
+       ... return 0/1 depending on whether PCT should be broken ...
+   }
+   #endif
+*/
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_CT_TESTING_ENABLED
+ *
+ * Description: If set, mldsa-native annotates data as secret / public using
+ *              valgrind's annotations VALGRIND_MAKE_MEM_UNDEFINED and
+ *              VALGRIND_MAKE_MEM_DEFINED, enabling various checks for secret-
+ *              dependent control flow of variable time execution (depending
+ *              on the exact version of valgrind installed).
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_CT_TESTING_ENABLED */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_NO_ASM
+ *
+ * Description: If this option is set, mldsa-native will be built without
+ *              use of native code or inline assembly.
+ *
+ *              By default, inline assembly is used to implement value barriers.
+ *              Without inline assembly, mldsa-native will use a global volatile
+ *              'opt blocker' instead; see ct.h.
+ *
+ *              Inline assembly is also used to implement a secure zeroization
+ *              function on non-Windows platforms. If this option is set and
+ *              the target platform is not Windows, you MUST set
+ *              MLD_CONFIG_CUSTOM_ZEROIZE and provide a custom zeroization
+ *              function.
+ *
+ *              If this option is set, MLD_CONFIG_USE_NATIVE_BACKEND_FIPS202 and
+ *              and MLD_CONFIG_USE_NATIVE_BACKEND_ARITH will be ignored, and no
+ *              native backends will be used.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_NO_ASM */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_NO_ASM_VALUE_BARRIER
+ *
+ * Description: If this option is set, mldsa-native will be built without
+ *              use of native code or inline assembly for value barriers.
+ *
+ *              By default, inline assembly (if available) is used to implement
+ *              value barriers.
+ *              Without inline assembly, mldsa-native will use a global volatile
+ *              'opt blocker' instead; see ct.h.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_NO_ASM_VALUE_BARRIER */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_RUNTIME_CPU_DISPATCH
+ *
+ * Description: If this option is set, the x86_64 AVX2 backends for
+ *              arithmetic and FIPS202 are compiled in even if the compiler
+ *              does not target AVX2 (i.e. __AVX2__ is unset). On first use,
+ *              CPUID is queried once, and the native functions fall back to
+ *              the portable C code if the CPU or OS lacks AVX2/BMI2 support.
+ *
+ *              This allows a single binary built for baseline x86_64 to run
+ *              at full speed on AVX2-capable CPUs. If AVX2 is enabled at
+ *              compile-time, this option has no effect.
+ *
+ *              Requires GCC or clang, and inline assembly (CPUID).
+ *
+ *              Note: The output of crypto_sign_expand_pk() uses the backend's
+ *              NTT order and must not be shared between machines.
+ *
+ *****************************************************************************/
+#define MLD_CONFIG_RUNTIME_CPU_DISPATCH
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_RUNTIME_CPU_DISPATCH_FALLBACK_TEST
+ *
+ * Description: If this option is set, the user must provide a runtime
+ *              function `static inline int mld_force_cpu_fallback() { ... }`
+ *              to indicate whether the CPU check should report AVX2 as
+ *              unavailable. This allows testing the portable fallback on
+ *              AVX2-capable machines. Like CPUID, the function is only
+ *              evaluated once.
+ *
+ *              This option only has an effect if
+ *              MLD_CONFIG_RUNTIME_CPU_DISPATCH is set.
+ *
+ *****************************************************************************/
+#define MLD_CONFIG_RUNTIME_CPU_DISPATCH_FALLBACK_TEST
+#if !defined(__ASSEMBLER__)
+#include <stdlib.h>
+#include <string.h>
+#include "../mldsa/sys.h"
+static MLD_INLINE int mld_force_cpu_fallback(void)
+{
+  /* Ignore AVX2 if and only if MLD_FORCE_CPU_FALLBACK is set to 1 */
+  const char *val = getenv("MLD_FORCE_CPU_FALLBACK");
+  return val != NULL && strcmp(val, "1") == 0;
+}
+#endif
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_SMALL_SECRETS
+ *
+ * Description: If this option is set, the secret vectors s1 and s2 are kept
+ *              in normal domain with int16_t coefficients during signing,
+ *              rather than in NTT domain with int32_t coefficients. The
+ *              products c*s1 and c*s2 are then computed directly from the
+ *              sparse challenge c, without NTT.
+ *
+ *              This halves the memory footprint of s1 and s2 and avoids
+ *              MLDSA_K + MLDSA_L inverse NTTs per signing attempt.
+ *              On targets with a fast native NTT, the sparse multiplication
+ *              is typically slower, so this is not enabled by default.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_SMALL_SECRETS */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_REDUCE_RAM
+ *
+ * Description: If this option is set, the matrix A is never held in memory
+ *              as a whole. Instead, each row is regenerated from rho when
+ *              it is needed, so that only a single row is live at any time.
+ *              In addition, signing keeps the mask vector y bit-packed
+ *              between its uses, computes z one polynomial at a time and
+ *              bit-packs it straight into the signature, and lets the NTT
+ *              of y share storage with w0, and w1 with the hint vector.
+ *
+ *              This roughly halves the peak stack usage of key generation,
+ *              signing and verification, at the cost of re-sampling A in
+ *              every signing attempt. The remaining footprint is dominated
+ *              by the unpacked secret key (s1, s2, t0) and the K-vectors
+ *              w0, w2 and h. Use `make run_stack` to measure the effect on
+ *              a given target.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_REDUCE_RAM */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_REDUCE_RAM_CACHE_ROWS
+ *
+ * Description: Only relevant if MLD_CONFIG_REDUCE_RAM is set.
+ *
+ *              If this option is set, signing generates the rows of A once
+ *              per signature and caches them in the 23-bit packed format of
+ *              mld_polyvec_matrix_pack(), rather than re-sampling them in
+ *              every rejection-sampling attempt. This trades
+ *              MLDSA_POLYMAT_PACKEDBYTES of memory for signing speed.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_REDUCE_RAM_CACHE_ROWS */
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_VERIFY_CACHE
+ *
+ * Description: If this option is set, crypto_sign_verify() (and hence
+ *              crypto_sign_open()) remembers successful verifications in a
+ *              bounded in-memory cache keyed by a SHAKE256 digest of the
+ *              public key, signature, context string and message. Verifying
+ *              the same tuple again then costs one hash and a lookup.
+ *              Failed verifications are never cached.
+ *
+ *              The cache holds MLD_CONFIG_VERIFY_CACHE_SIZE entries
+ *              (default 256) per parameter set, in sets of 8 selected by
+ *              the digest, so that a lookup only compares 8 entries. Each
+ *              set evicts entries using the CLOCK policy. If the size is
+ *              not a multiple of 8, the remaining entries are unused.
+ *              crypto_sign_verify_cache_clear() empties the cache, and
+ *              crypto_sign_verify_cache_counters() reports the number of
+ *              cache hits and misses.
+ *
+ *              Accesses are serialized by a spinlock based on the GCC/clang
+ *              __atomic builtins. To use a different lock, or if those are
+ *              unavailable, set MLD_CONFIG_VERIFY_CACHE_CUSTOM_LOCK and
+ *              define `mld_verify_cache_lock_native()` and
+ *              `mld_verify_cache_unlock_native()`.
+ *
+ *              Note: The time taken by crypto_sign_verify() reveals whether
+ *              a tuple has been verified before. Verification inputs are
+ *              usually public, but consider this before enabling the cache.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_VERIFY_CACHE */
+/* #define MLD_CONFIG_VERIFY_CACHE_SIZE 256 */
+/* #define MLD_CONFIG_VERIFY_CACHE_CUSTOM_LOCK
+   #if !defined(__ASSEMBLER__)
+   static MLD_INLINE void mld_verify_cache_lock_native(void)
+   {
+       ... your implementation ...
+   }
+   static MLD_INLINE void mld_verify_cache_unlock_native(void)
+   {
+       ... your implementation ...
+   }
+   #endif
+*/
+
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_STATS
+ *
+ * Description: If this option is set, the signing functions record
+ *              statistics about the rejection loop in thread-local
+ *              counters: the number of attempts per signature, the
+ *              reasons for rejected attempts, and the number of XOF blocks
+ *              the rejection samplers squeeze beyond their initial
+ *              estimate. crypto_sign_stats_get() and
+ *              crypto_sign_stats_reset() read and clear the counters of
+ *              the calling thread.
+ *
+ *              Thread-local storage requires C11 or a compiler supporting
+ *              `__thread` (GCC, clang) or `__declspec(thread)` (MSVC).
+ *
+ *              Note: The counters reveal the number of signing attempts,
+ *              which is not secret but also observable through timing.
+ *              This option is meant for profiling and is unset by default.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_STATS */
+
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_PROFILE_HOOK
+ *
+ * Description: If this option is set, key generation, signing and
+ *              verification call the hooks
+ *
+ *              void mld_profile_begin(unsigned phase);
+ *              void mld_profile_end(unsigned phase);
+ *
+ *              at the start and end of each of their phases (hashing,
+ *              matrix expansion, sampling, NTTs, rounding, packing, ...),
+ *              see mldsa/profile.h for the list of phases. The hooks must
+ *              be provided by the user; test/hal/profile.c is a reference
+ *              implementation producing a per-phase cycle breakdown in
+ *              flame graph format.
+ *
+ *              If this option is unset (the default), the hooks compile to
+ *              nothing.
+ *
+ *              Note: The hooks observe the number of signing attempts,
+ *              which is not secret but also observable through timing.
+ *              This option is meant for profiling only.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_PROFILE_HOOK */
+
+
+/******************************************************************************
+ * Name:        MLD_CONFIG_OPCOUNT
+ *
+ * Description: If this option is set, the library counts, in thread-local
+ *              counters, the Keccak-f[1600] permutations (1-way and 4-way),
+ *              the forward and inverse NTTs, the polynomials of the matrix
+ *              A expanded from rho, and the refill iterations of the
+ *              rejection samplers. crypto_sign_opcount_get() and
+ *              crypto_sign_opcount_reset() read and clear the counters of
+ *              the calling thread.
+ *
+ *              Unlike cycle counts, these counts are deterministic for a
+ *              fixed key, message and randomness, and are meant as a cost
+ *              model for regression tracking; see test/bench_opcount.c.
+ *
+ *              In multilevel builds, the counters are level-independent
+ *              and shared between all parameter sets.
+ *
+ *              Thread-local storage is required as for MLD_CONFIG_STATS.
+ *              This option is meant for profiling and is unset by default.
+ *
+ *****************************************************************************/
+/* #define MLD_CONFIG_OPCOUNT */
+
+
+#endif /* !MLD_CONFIG_H */
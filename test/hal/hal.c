@@ -33,6 +33,11 @@
 #endif
 
 #include "hal.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/* Bitmask of the events counted by the perf_event group */
+static int perf_events_mask = 0;
 
 #if defined(PMU_CYCLES)
 
@@ -90,6 +95,17 @@ uint64_t get_cyclecounter(void)
 #error PMU_CYCLES option only supported on x86_64 and AArch64
 #endif
 
+int enable_perf_events(void) { return 0; }
+void disable_perf_events(void) {}
+void get_perf_events(hal_events *ev)
+{
+  unsigned i;
+  for (i = 0; i < HAL_NUM_EVENTS; i++)
+  {
+    ev->count[i] = 0;
+  }
+}
+
 #elif defined(PERF_CYCLES)
 
 #include <asm/unistd.h>
@@ -144,6 +160,117 @@ uint64_t get_cyclecounter(void)
   ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
   return cpu_cycles;
 }
+
+static const struct
+{
+  uint32_t type;
+  uint64_t config;
+} perf_event_types[HAL_NUM_EVENTS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND}};
+
+static int perf_group_fds[HAL_NUM_EVENTS];
+/* HAL_EVENT_xxx of the i-th member of the group, in the order of read() */
+static unsigned perf_group_events[HAL_NUM_EVENTS];
+static unsigned perf_group_size = 0;
+static int perf_multiplexed = 0;
+
+int enable_perf_events(void)
+{
+  struct perf_event_attr pe;
+  unsigned i;
+  int fd;
+
+  perf_group_size = 0;
+  perf_events_mask = 0;
+  for (i = 0; i < HAL_NUM_EVENTS; i++)
+  {
+    memset(&pe, 0, sizeof(struct perf_event_attr));
+    pe.type = perf_event_types[i].type;
+    pe.size = sizeof(struct perf_event_attr);
+    pe.config = perf_event_types[i].config;
+    pe.disabled = (perf_group_size == 0);
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    pe.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    /* The first event that opens is the group leader */
+    fd = (int)syscall(__NR_perf_event_open, &pe, 0, -1,
+                      perf_group_size == 0 ? -1 : perf_group_fds[0], 0);
+    if (fd < 0)
+    {
+      /* Not supported by this CPU or kernel, or not permitted */
+      continue;
+    }
+    perf_group_fds[perf_group_size] = fd;
+    perf_group_events[perf_group_size] = i;
+    perf_group_size++;
+    perf_events_mask |= 1 << i;
+  }
+
+  if (perf_group_size != 0)
+  {
+    ioctl(perf_group_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf_group_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+  return perf_events_mask;
+}
+
+void disable_perf_events(void)
+{
+  unsigned i;
+
+  if (perf_group_size != 0)
+  {
+    ioctl(perf_group_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  }
+  /* Close the members before the leader */
+  for (i = perf_group_size; i > 0; i--)
+  {
+    close(perf_group_fds[i - 1]);
+  }
+  perf_group_size = 0;
+  perf_events_mask = 0;
+}
+
+void get_perf_events(hal_events *ev)
+{
+  /* nr, time_enabled, time_running, then one value per member */
+  uint64_t buf[3 + HAL_NUM_EVENTS];
+  unsigned i;
+
+  memset(ev, 0, sizeof(hal_events));
+  if (perf_group_size == 0)
+  {
+    return;
+  }
+  if (read(perf_group_fds[0], buf, sizeof(buf)) <
+      (ssize_t)((3 + perf_group_size) * sizeof(uint64_t)))
+  {
+    perror("read");
+    exit(EXIT_FAILURE);
+  }
+  /* The members of a group are scheduled together. If the PMU cannot hold
+   * all of them at once, the group is multiplexed with other events and the
+   * counts cover only part of the run; they remain consistent with each
+   * other, so ratios such as the IPC are still meaningful. */
+  if (buf[2] < buf[1] && !perf_multiplexed)
+  {
+    fprintf(stderr, "warning: perf events are multiplexed\n");
+    perf_multiplexed = 1;
+  }
+  for (i = 0; i < perf_group_size && i < buf[0]; i++)
+  {
+    ev->count[perf_group_events[i]] = buf[3 + i];
+  }
+}
 #elif defined(MAC_CYCLES)
 /*
  * based on
@@ -297,10 +424,149 @@ uint64_t get_cyclecounter(void)
   return g_counters[2];
 }
 
+int enable_perf_events(void) { return 0; }
+void disable_perf_events(void) {}
+void get_perf_events(hal_events *ev)
+{
+  unsigned i;
+  for (i = 0; i < HAL_NUM_EVENTS; i++)
+  {
+    ev->count[i] = 0;
+  }
+}
+
 #else
 
 void enable_cyclecounter(void) { return; }
 void disable_cyclecounter(void) { return; }
 uint64_t get_cyclecounter(void) { return (0); }
 
+int enable_perf_events(void) { return 0; }
+void disable_perf_events(void) {}
+void get_perf_events(hal_events *ev)
+{
+  unsigned i;
+  for (i = 0; i < HAL_NUM_EVENTS; i++)
+  {
+    ev->count[i] = 0;
+  }
+}
+
+#endif
+
+void add_perf_events(hal_events *acc, const hal_events *start,
+                     const hal_events *end)
+{
+  unsigned i;
+  for (i = 0; i < HAL_NUM_EVENTS; i++)
+  {
+    acc->count[i] += end->count[i] - start->count[i];
+  }
+}
+
+static const char *perf_event_names[HAL_NUM_EVENTS] = {
+    "insn", "cyc", "l1d_miss", "llc_miss", "br_miss", "stall"};
+
+void print_perf_events(const hal_events *ev, uint64_t ops)
+{
+  const int ipc_mask =
+      (1 << HAL_EVENT_INSTRUCTIONS) | (1 << HAL_EVENT_CYCLES);
+  unsigned i;
+
+  if (perf_events_mask == 0 || ops == 0)
+  {
+    return;
+  }
+  if ((perf_events_mask & ipc_mask) == ipc_mask &&
+      ev->count[HAL_EVENT_CYCLES] != 0)
+  {
+    printf(" ipc=%.2f", (double)ev->count[HAL_EVENT_INSTRUCTIONS] /
+                            (double)ev->count[HAL_EVENT_CYCLES]);
+  }
+  for (i = 0; i < HAL_NUM_EVENTS; i++)
+  {
+    /* Cycles are reported by get_cyclecounter() already */
+    if (i == HAL_EVENT_CYCLES || !(perf_events_mask & (1 << i)))
+    {
+      continue;
+    }
+    if (i == HAL_EVENT_INSTRUCTIONS)
+    {
+      printf(" %s=%" PRIu64, perf_event_names[i], ev->count[i] / ops);
+    }
+    else
+    {
+      printf(" %s=%.2f", perf_event_names[i],
+             (double)ev->count[i] / (double)ops);
+    }
+  }
+}
+
+#if defined(__x86_64__)
+
+void flush_cache(const void *addr, size_t len)
+{
+  const char *p = (const char *)addr;
+  size_t i;
+  for (i = 0; i < len; i += 64)
+  {
+    __asm__ volatile("clflush (%0)" : : "r"(p + i) : "memory");
+  }
+  /* The final line may start within the last 64 bytes */
+  if (len != 0)
+  {
+    __asm__ volatile("clflush (%0)" : : "r"(p + len - 1) : "memory");
+  }
+  __asm__ volatile("mfence" : : : "memory");
+}
+
+#elif defined(__AARCH64EL__) && defined(__linux__)
+
+void flush_cache(const void *addr, size_t len)
+{
+  /* Linux permits cache maintenance by VA at EL0. 64 bytes is the smallest
+   * cache line size on current cores, so this may clean lines repeatedly,
+   * but never skips one. */
+  const char *p = (const char *)addr;
+  size_t i;
+  for (i = 0; i < len; i += 64)
+  {
+    __asm__ volatile("dc civac, %0" : : "r"(p + i) : "memory");
+  }
+  if (len != 0)
+  {
+    __asm__ volatile("dc civac, %0" : : "r"(p + len - 1) : "memory");
+  }
+  __asm__ volatile("dsb ish" : : : "memory");
+}
+
+#else
+
+#include <stdlib.h>
+
+/* Without a cache maintenance instruction, overwrite a buffer larger than
+ * any last-level cache, which evicts everything else. */
+#define FLUSH_EVICT_BYTES ((size_t)64 * 1024 * 1024)
+
+void flush_cache(const void *addr, size_t len)
+{
+  static volatile unsigned char *evict = NULL;
+  size_t i;
+
+  (void)addr;
+  (void)len;
+  if (evict == NULL)
+  {
+    evict = (volatile unsigned char *)malloc(FLUSH_EVICT_BYTES);
+    if (evict == NULL)
+    {
+      return;
+    }
+  }
+  for (i = 0; i < FLUSH_EVICT_BYTES; i += 64)
+  {
+    evict[i]++;
+  }
+}
+
 #endif
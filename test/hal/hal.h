@@ -26,10 +26,45 @@
 #ifndef HAL_H
 #define HAL_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 void enable_cyclecounter(void);
 void disable_cyclecounter(void);
 uint64_t get_cyclecounter(void);
 
+/* Hardware events of the perf_event group, indexing hal_events.count */
+#define HAL_EVENT_INSTRUCTIONS 0
+#define HAL_EVENT_CYCLES 1
+#define HAL_EVENT_L1D_MISSES 2     /* L1 data cache read misses */
+#define HAL_EVENT_LLC_MISSES 3     /* last-level cache misses */
+#define HAL_EVENT_BRANCH_MISSES 4  /* mispredicted branches */
+#define HAL_EVENT_STALLED_CYCLES 5 /* cycles stalled in the backend */
+#define HAL_NUM_EVENTS 6
+
+typedef struct
+{
+  uint64_t count[HAL_NUM_EVENTS];
+} hal_events;
+
+/* Opens the event group and returns the bitmask (1 << HAL_EVENT_xxx) of the
+ * events that are counted. Events that the CPU or kernel do not support are
+ * skipped; 0 is returned if no event is available, which is always the case
+ * unless built with CYCLES=PERF. */
+int enable_perf_events(void);
+void disable_perf_events(void);
+/* Reads the current event counts; unavailable events read as 0. */
+void get_perf_events(hal_events *ev);
+/* Adds the difference end - start to acc. */
+void add_perf_events(hal_events *acc, const hal_events *start,
+                     const hal_events *end);
+/* Prints the IPC and the per-operation counts of the available events,
+ * for ev accumulated over ops operations, as ` ipc=X insn=X ...` without
+ * a trailing newline. Prints nothing if no event is available. */
+void print_perf_events(const hal_events *ev, uint64_t ops);
+
+/* Evicts the cache lines of [addr, addr + len) from all levels of the cache
+ * hierarchy, to measure accesses to data that was not used recently. */
+void flush_cache(const void *addr, size_t len);
+
 #endif
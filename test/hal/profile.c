@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+
+#if defined(MLD_CONFIG_PROFILE_HOOK)
+
+#include "profile.h"
+#include <string.h>
+#include "../../mldsa/profile.h"
+#include "hal.h"
+
+#define PROFILE_MAX_NODES 256
+#define PROFILE_MAX_DEPTH 16
+
+/* The call tree is kept per thread so that concurrent signing does not
+ * interleave samples. MLD_THREAD_LOCAL comes from mldsa/sys.h. */
+#if !defined(MLD_THREAD_LOCAL)
+#error MLD_CONFIG_PROFILE_HOOK requires thread-local storage support
+#endif
+
+static const char *phase_names[MLD_PROFILE_NUM_PHASES] = {
+    "keypair", "sign", "verify", "attempt", "hash",
+    "expand_matrix", "sample_s", "sample_y", "sample_challenge", "ntt",
+    "rounding", "pack", "unpack"};
+
+typedef struct
+{
+  int parent; /* index of the parent node, or -1 for a root */
+  unsigned phase;
+  uint64_t self; /* cycles spent in this node, excluding children */
+  uint64_t calls;
+} profile_node;
+
+typedef struct
+{
+  int node; /* -1 if the tree was full */
+  uint64_t start;
+  uint64_t children; /* cycles spent in child nodes */
+} profile_frame;
+
+typedef struct
+{
+  profile_node nodes[PROFILE_MAX_NODES];
+  unsigned num_nodes;
+  profile_frame stack[PROFILE_MAX_DEPTH];
+  /* May exceed PROFILE_MAX_DEPTH; deeper phases are not recorded */
+  unsigned depth;
+} profile_state;
+
+static MLD_THREAD_LOCAL profile_state prof;
+
+static int profile_node_get(int parent, unsigned phase)
+{
+  unsigned i;
+  for (i = 0; i < prof.num_nodes; i++)
+  {
+    if (prof.nodes[i].parent == parent && prof.nodes[i].phase == phase)
+    {
+      return (int)i;
+    }
+  }
+  if (prof.num_nodes == PROFILE_MAX_NODES)
+  {
+    return -1;
+  }
+  prof.nodes[i].parent = parent;
+  prof.nodes[i].phase = phase;
+  prof.nodes[i].self = 0;
+  prof.nodes[i].calls = 0;
+  prof.num_nodes++;
+  return (int)i;
+}
+
+void mld_profile_begin(unsigned phase)
+{
+  profile_frame *f;
+  int parent = -1, node = -1;
+
+  if (prof.depth >= PROFILE_MAX_DEPTH || phase >= MLD_PROFILE_NUM_PHASES)
+  {
+    prof.depth++;
+    return;
+  }
+  if (prof.depth > 0)
+  {
+    parent = prof.stack[prof.depth - 1].node;
+  }
+  /* Below a phase that could not be recorded, nothing is recorded */
+  if (prof.depth == 0 || parent >= 0)
+  {
+    node = profile_node_get(parent, phase);
+  }
+
+  f = &prof.stack[prof.depth++];
+  f->node = node;
+  f->children = 0;
+  /* Read the counter last, so that the bookkeeping above is attributed to
+   * the parent rather than to this phase. */
+  f->start = get_cyclecounter();
+}
+
+void mld_profile_end(unsigned phase)
+{
+  uint64_t elapsed, end = get_cyclecounter();
+  profile_frame *f;
+
+  (void)phase;
+  if (prof.depth == 0)
+  {
+    return;
+  }
+  if (prof.depth-- > PROFILE_MAX_DEPTH)
+  {
+    return;
+  }
+
+  f = &prof.stack[prof.depth];
+  elapsed = end - f->start;
+  if (f->node >= 0)
+  {
+    prof.nodes[f->node].self += elapsed - f->children;
+    prof.nodes[f->node].calls++;
+  }
+  if (prof.depth > 0)
+  {
+    prof.stack[prof.depth - 1].children += elapsed;
+  }
+}
+
+void profile_reset(void) { memset(&prof, 0, sizeof(prof)); }
+
+static void profile_print_path(FILE *out, int node)
+{
+  if (prof.nodes[node].parent >= 0)
+  {
+    profile_print_path(out, prof.nodes[node].parent);
+  }
+  fprintf(out, ";%s", phase_names[prof.nodes[node].phase]);
+}
+
+void profile_print(FILE *out, const char *prefix, uint64_t iterations)
+{
+  unsigned i;
+
+  if (iterations == 0)
+  {
+    iterations = 1;
+  }
+  for (i = 0; i < prof.num_nodes; i++)
+  {
+    fputs(prefix, out);
+    profile_print_path(out, (int)i);
+    fprintf(out, " %llu\n",
+            (unsigned long long)(prof.nodes[i].self / iterations));
+  }
+}
+
+#else /* MLD_CONFIG_PROFILE_HOOK */
+
+/* Avoid an empty translation unit */
+extern int profile_empty_cu;
+
+#endif /* !MLD_CONFIG_PROFILE_HOOK */
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/* Reference collector for the profiling hooks of MLD_CONFIG_PROFILE_HOOK.
+ *
+ * It implements mld_profile_begin() and mld_profile_end() by building, per
+ * thread, the tree of nested phases and accumulating the cycles spent in
+ * each node exclusive of its children ("self" cycles), as measured by
+ * get_cyclecounter() from hal.h.
+ *
+ * The tree is printed in the folded-stack format understood by flame graph
+ * tools such as flamegraph.pl or speedscope, one line per node:
+ *
+ *   <prefix>;sign;attempt;ntt 12345
+ *
+ * Without MLD_CONFIG_PROFILE_HOOK, this file is empty. */
+
+/* Clears the profile of the calling thread */
+void profile_reset(void);
+
+/* Prints the profile of the calling thread in folded-stack format, each
+ * line prefixed with prefix. Cycle counts are divided by iterations. */
+void profile_print(FILE *out, const char *prefix, uint64_t iterations);
+
+#endif /* !PROFILE_H */
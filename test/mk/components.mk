@@ -8,13 +8,17 @@ ifeq ($(OPT),1)
 endif
 
 
-SOURCES += $(wildcard mldsa/*.c)
+SOURCES += $(filter-out mldsa/mldsa_native.c,$(wildcard mldsa/*.c))
 ifeq ($(OPT),1)
 	SOURCES += $(wildcard mldsa/native/aarch64/src/*.[csS]) $(wildcard mldsa/native/x86_64/src/*.[csS])
 	CFLAGS += -DMLD_CONFIG_USE_NATIVE_BACKEND_ARITH -DMLD_CONFIG_USE_NATIVE_BACKEND_FIPS202
 endif
 
-ALL_TESTS = test_mldsa acvp_mldsa bench_mldsa bench_components_mldsa gen_KAT test_stack
+ALL_TESTS = test_mldsa test_mldsa_internal acvp_mldsa bench_mldsa bench_components_mldsa bench_opcount_mldsa gen_KAT test_stack
+
+# The reference collector for MLD_CONFIG_PROFILE_HOOK is linked into every
+# test binary, so that all of them link when the hook is enabled.
+HAL_SRCS = test/hal/hal.c test/hal/profile.c
 
 MLDSA44_DIR = $(BUILD_DIR)/mldsa44
 MLDSA65_DIR = $(BUILD_DIR)/mldsa65
@@ -33,6 +37,23 @@ $(BUILD_DIR)/libmldsa87.a: $(MLDSA87_OBJS)
 
 $(BUILD_DIR)/libmldsa.a: $(MLDSA44_OBJS) $(MLDSA65_OBJS) $(MLDSA87_OBJS)
 
+# Multilevel build: level-independent code is only compiled into the
+# ML-DSA-44 objects and shared by all three parameter sets.
+MULTILEVEL_DIR = $(BUILD_DIR)/multilevel
+
+MULTILEVEL44_OBJS = $(call MAKE_OBJS,$(MULTILEVEL_DIR)/mldsa44,$(SOURCES) $(FIPS202_SRCS))
+$(MULTILEVEL44_OBJS): CFLAGS += -DMLDSA_MODE=2 -DMLD_CONFIG_MULTILEVEL_BUILD
+MULTILEVEL65_OBJS = $(call MAKE_OBJS,$(MULTILEVEL_DIR)/mldsa65,$(SOURCES) $(FIPS202_SRCS))
+$(MULTILEVEL65_OBJS): CFLAGS += -DMLDSA_MODE=3 -DMLD_CONFIG_MULTILEVEL_BUILD -DMLD_CONFIG_MULTILEVEL_NO_SHARED
+MULTILEVEL87_OBJS = $(call MAKE_OBJS,$(MULTILEVEL_DIR)/mldsa87,$(SOURCES) $(FIPS202_SRCS))
+$(MULTILEVEL87_OBJS): CFLAGS += -DMLDSA_MODE=5 -DMLD_CONFIG_MULTILEVEL_BUILD -DMLD_CONFIG_MULTILEVEL_NO_SHARED
+
+$(BUILD_DIR)/libmldsa_multilevel.a: $(MULTILEVEL44_OBJS) $(MULTILEVEL65_OBJS) $(MULTILEVEL87_OBJS)
+
+$(MULTILEVEL_DIR)/bin/test_multilevel: LDLIBS += -L$(BUILD_DIR) -lmldsa_multilevel
+$(MULTILEVEL_DIR)/bin/test_multilevel: $(MULTILEVEL_DIR)/test/test_multilevel.c.o $(BUILD_DIR)/libmldsa_multilevel.a \
+	$(call MAKE_OBJS, $(MULTILEVEL_DIR), $(wildcard test/notrandombytes/*.c) $(HAL_SRCS))
+
 $(MLDSA44_DIR)/bin/bench_mldsa44: CFLAGS += -Itest/hal
 $(MLDSA65_DIR)/bin/bench_mldsa65: CFLAGS += -Itest/hal
 $(MLDSA87_DIR)/bin/bench_mldsa87: CFLAGS += -Itest/hal
@@ -40,17 +61,15 @@ $(MLDSA44_DIR)/bin/bench_components_mldsa44: CFLAGS += -Itest/hal
 $(MLDSA65_DIR)/bin/bench_components_mldsa65: CFLAGS += -Itest/hal
 $(MLDSA87_DIR)/bin/bench_components_mldsa87: CFLAGS += -Itest/hal
 
+# acvp_mldsa runs batches of test cases on worker threads
+$(MLDSA44_DIR)/bin/acvp_mldsa44: CFLAGS += -pthread
+$(MLDSA65_DIR)/bin/acvp_mldsa65: CFLAGS += -pthread
+$(MLDSA87_DIR)/bin/acvp_mldsa87: CFLAGS += -pthread
+
 $(MLDSA44_DIR)/bin/test_stack44: CFLAGS += -Imldsa -fstack-usage
 $(MLDSA65_DIR)/bin/test_stack65: CFLAGS += -Imldsa -fstack-usage
 $(MLDSA87_DIR)/bin/test_stack87: CFLAGS += -Imldsa -fstack-usage
 
-$(MLDSA44_DIR)/bin/bench_mldsa44: $(MLDSA44_DIR)/test/hal/hal.c.o
-$(MLDSA65_DIR)/bin/bench_mldsa65: $(MLDSA65_DIR)/test/hal/hal.c.o
-$(MLDSA87_DIR)/bin/bench_mldsa87: $(MLDSA87_DIR)/test/hal/hal.c.o
-$(MLDSA44_DIR)/bin/bench_components_mldsa44: $(MLDSA44_DIR)/test/hal/hal.c.o
-$(MLDSA65_DIR)/bin/bench_components_mldsa65: $(MLDSA65_DIR)/test/hal/hal.c.o
-$(MLDSA87_DIR)/bin/bench_components_mldsa87: $(MLDSA87_DIR)/test/hal/hal.c.o
-
 $(MLDSA44_DIR)/bin/%: CFLAGS += -DMLDSA_MODE=2
 $(MLDSA65_DIR)/bin/%: CFLAGS += -DMLDSA_MODE=3
 $(MLDSA87_DIR)/bin/%: CFLAGS += -DMLDSA_MODE=5
@@ -70,3 +89,77 @@ $(foreach scheme,mldsa44 mldsa65 mldsa87, \
 $(ALL_TESTS:%=$(MLDSA44_DIR)/bin/%44): $(call MAKE_OBJS, $(MLDSA44_DIR), $(wildcard test/notrandombytes/*.c))
 $(ALL_TESTS:%=$(MLDSA65_DIR)/bin/%65): $(call MAKE_OBJS, $(MLDSA65_DIR), $(wildcard test/notrandombytes/*.c))
 $(ALL_TESTS:%=$(MLDSA87_DIR)/bin/%87): $(call MAKE_OBJS, $(MLDSA87_DIR), $(wildcard test/notrandombytes/*.c))
+
+$(ALL_TESTS:%=$(MLDSA44_DIR)/bin/%44): $(call MAKE_OBJS, $(MLDSA44_DIR), $(HAL_SRCS))
+$(ALL_TESTS:%=$(MLDSA65_DIR)/bin/%65): $(call MAKE_OBJS, $(MLDSA65_DIR), $(HAL_SRCS))
+$(ALL_TESTS:%=$(MLDSA87_DIR)/bin/%87): $(call MAKE_OBJS, $(MLDSA87_DIR), $(HAL_SRCS))
+
+# Multi-threaded throughput benchmark. It provides its own thread-safe
+# randombytes() and is therefore not linked with test/notrandombytes.
+define ADD_THROUGHPUT_SOURCE
+$(BUILD_DIR)/$(1)/bin/bench_throughput_$(1): CFLAGS += -pthread
+$(BUILD_DIR)/$(1)/bin/bench_throughput_$(1): LDLIBS += -L$(BUILD_DIR) -l$(1)
+$(BUILD_DIR)/$(1)/bin/bench_throughput_$(1): $(BUILD_DIR)/$(1)/test/bench_throughput_mldsa.c.o $(BUILD_DIR)/lib$(1).a \
+	$(call MAKE_OBJS, $(BUILD_DIR)/$(1), $(HAL_SRCS))
+endef
+
+$(foreach scheme,mldsa44 mldsa65 mldsa87, \
+	$(eval $(call ADD_THROUGHPUT_SOURCE,$(scheme))) \
+)
+
+# Single-compilation-unit build: all C sources are compiled through
+# mldsa/mldsa_native.c; assembly sources are still built separately.
+SCU_SOURCES = mldsa/mldsa_native.c $(filter %.S,$(SOURCES) $(FIPS202_SRCS))
+
+SCU44_DIR = $(BUILD_DIR)/scu/mldsa44
+SCU65_DIR = $(BUILD_DIR)/scu/mldsa65
+SCU87_DIR = $(BUILD_DIR)/scu/mldsa87
+
+SCU44_OBJS = $(call MAKE_OBJS,$(SCU44_DIR),$(SCU_SOURCES))
+$(SCU44_OBJS): CFLAGS += -DMLDSA_MODE=2
+SCU65_OBJS = $(call MAKE_OBJS,$(SCU65_DIR),$(SCU_SOURCES))
+$(SCU65_OBJS): CFLAGS += -DMLDSA_MODE=3
+SCU87_OBJS = $(call MAKE_OBJS,$(SCU87_DIR),$(SCU_SOURCES))
+$(SCU87_OBJS): CFLAGS += -DMLDSA_MODE=5
+
+$(BUILD_DIR)/libmldsa44_scu.a: $(SCU44_OBJS)
+$(BUILD_DIR)/libmldsa65_scu.a: $(SCU65_OBJS)
+$(BUILD_DIR)/libmldsa87_scu.a: $(SCU87_OBJS)
+
+$(SCU44_DIR)/bin/%: CFLAGS += -DMLDSA_MODE=2
+$(SCU65_DIR)/bin/%: CFLAGS += -DMLDSA_MODE=3
+$(SCU87_DIR)/bin/%: CFLAGS += -DMLDSA_MODE=5
+
+$(SCU44_DIR)/bin/bench_mldsa44: CFLAGS += -Itest/hal
+$(SCU65_DIR)/bin/bench_mldsa65: CFLAGS += -Itest/hal
+$(SCU87_DIR)/bin/bench_mldsa87: CFLAGS += -Itest/hal
+
+define ADD_SCU_SOURCE
+$(BUILD_DIR)/scu/$(1)/bin/$(2)$(shell echo $(1) | tr -d -c 0-9): LDLIBS += -L$(BUILD_DIR) -l$(1)_scu
+$(BUILD_DIR)/scu/$(1)/bin/$(2)$(shell echo $(1) | tr -d -c 0-9): $(BUILD_DIR)/scu/$(1)/test/$(2).c.o $(BUILD_DIR)/lib$(1)_scu.a \
+	$(call MAKE_OBJS, $(BUILD_DIR)/scu/$(1), $(wildcard test/notrandombytes/*.c) $(HAL_SRCS))
+endef
+
+$(foreach scheme,mldsa44 mldsa65 mldsa87, \
+	$(foreach test,test_mldsa test_mldsa_internal bench_mldsa, \
+		$(eval $(call ADD_SCU_SOURCE,$(scheme),$(test))) \
+	) \
+)
+
+# Multilevel SCU build: as for the multilevel build above, level-independent
+# code is only compiled into the ML-DSA-44 SCU, so that the three SCU objects
+# can be linked together.
+SCU_MULTILEVEL_DIR = $(BUILD_DIR)/scu/multilevel
+
+SCU_MULTILEVEL44_OBJS = $(call MAKE_OBJS,$(SCU_MULTILEVEL_DIR)/mldsa44,$(SCU_SOURCES) mldsa/multilevel.c)
+$(SCU_MULTILEVEL44_OBJS): CFLAGS += -DMLDSA_MODE=2 -DMLD_CONFIG_MULTILEVEL_BUILD
+SCU_MULTILEVEL65_OBJS = $(call MAKE_OBJS,$(SCU_MULTILEVEL_DIR)/mldsa65,$(SCU_SOURCES))
+$(SCU_MULTILEVEL65_OBJS): CFLAGS += -DMLDSA_MODE=3 -DMLD_CONFIG_MULTILEVEL_BUILD -DMLD_CONFIG_MULTILEVEL_NO_SHARED
+SCU_MULTILEVEL87_OBJS = $(call MAKE_OBJS,$(SCU_MULTILEVEL_DIR)/mldsa87,$(SCU_SOURCES))
+$(SCU_MULTILEVEL87_OBJS): CFLAGS += -DMLDSA_MODE=5 -DMLD_CONFIG_MULTILEVEL_BUILD -DMLD_CONFIG_MULTILEVEL_NO_SHARED
+
+$(BUILD_DIR)/libmldsa_multilevel_scu.a: $(SCU_MULTILEVEL44_OBJS) $(SCU_MULTILEVEL65_OBJS) $(SCU_MULTILEVEL87_OBJS)
+
+$(SCU_MULTILEVEL_DIR)/bin/test_multilevel: LDLIBS += -L$(BUILD_DIR) -lmldsa_multilevel_scu
+$(SCU_MULTILEVEL_DIR)/bin/test_multilevel: $(SCU_MULTILEVEL_DIR)/test/test_multilevel.c.o $(BUILD_DIR)/libmldsa_multilevel_scu.a \
+	$(call MAKE_OBJS, $(SCU_MULTILEVEL_DIR), $(wildcard test/notrandombytes/*.c) $(HAL_SRCS))
@@ -15,6 +15,17 @@
 #endif
 #define MLEN 59
 #define CTXLEN 1
+/* Number of signatures recorded in the statistics test */
+#define NSTATS 8
+/* Length of the challenge hash at the start of a signature, which is
+ * followed by z, see FIPS 204 Table 1 */
+#if MLDSA_MODE == 2
+#define CTILDEBYTES 32
+#elif MLDSA_MODE == 3
+#define CTILDEBYTES 48
+#elif MLDSA_MODE == 5
+#define CTILDEBYTES 64
+#endif
 
 #define CHECK(x)                                              \
   do                                                          \
@@ -83,6 +94,56 @@ static int test_sign(void)
   return 0;
 }
 
+static int test_sign_inplace(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sm[MLEN + CRYPTO_BYTES];
+  uint8_t m2[MLEN + CRYPTO_BYTES];
+  uint8_t ctx[CTXLEN];
+  const uint8_t *m;
+  size_t smlen;
+  size_t mlen;
+  int rc;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  randombytes(ctx, CTXLEN);
+  MLD_CT_TESTING_SECRET(ctx, sizeof(ctx));
+  randombytes(sm + CRYPTO_BYTES, MLEN);
+  MLD_CT_TESTING_SECRET(sm + CRYPTO_BYTES, MLEN);
+
+  CHECK(crypto_sign_inplace(sm, &smlen, MLEN, ctx, CTXLEN, sk) == 0);
+  CHECK(smlen == MLEN + CRYPTO_BYTES);
+
+  /* The in-place signed message must open with the copying API */
+  rc = crypto_sign_open(m2, &mlen, sm, smlen, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (rc)
+  {
+    printf("ERROR: crypto_sign_inplace\n");
+    return 1;
+  }
+
+  rc = crypto_sign_open_inplace(&m, &mlen, sm, smlen, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (rc || m != sm + CRYPTO_BYTES || mlen != MLEN)
+  {
+    printf("ERROR: crypto_sign_open_inplace\n");
+    return 1;
+  }
+
+  sm[0] ^= 1;
+  rc = crypto_sign_open_inplace(&m, &mlen, sm, smlen, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (!rc || m != NULL || mlen != 0)
+  {
+    printf("ERROR: crypto_sign_open_inplace - wrong signature\n");
+    return 1;
+  }
+
+  return 0;
+}
+
 static int test_wrong_pk(void)
 {
   uint8_t pk[CRYPTO_PUBLICKEYBYTES];
@@ -237,6 +298,268 @@ static int test_wrong_ctx(void)
   return 0;
 }
 
+static int test_sig_precheck(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t sig2[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  size_t siglen;
+  int rc;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  randombytes(m, MLEN);
+  MLD_CT_TESTING_SECRET(m, sizeof(m));
+
+  CHECK(crypto_sign_signature(sig, &siglen, m, MLEN, NULL, 0, sk) == 0);
+  MLD_CT_TESTING_DECLASSIFY(sig, sizeof(sig));
+  CHECK(crypto_sign_sig_precheck(sig, siglen) == 0);
+  CHECK(crypto_sign_sig_precheck(sig, siglen - 1) == -1);
+
+  /* Hint count exceeding omega */
+  memcpy(sig2, sig, CRYPTO_BYTES);
+  sig2[CRYPTO_BYTES - 1] = 0xFF;
+  CHECK(crypto_sign_sig_precheck(sig2, siglen) == -1);
+  rc = crypto_sign_verify(sig2, siglen, m, MLEN, NULL, 0, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  CHECK(rc == -1);
+
+  /* First coefficients of z set to -(gamma1 - 1), exceeding the norm bound */
+  memcpy(sig2, sig, CRYPTO_BYTES);
+  memset(sig2 + CTILDEBYTES, 0xFF, 16);
+  CHECK(crypto_sign_sig_precheck(sig2, siglen) == -1);
+  rc = crypto_sign_verify(sig2, siglen, m, MLEN, NULL, 0, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  CHECK(rc == -1);
+
+  return 0;
+}
+
+static int test_verify_expanded(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t epk[CRYPTO_EXPANDEDPUBLICKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  size_t siglen;
+  size_t idx;
+  int rc;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  CHECK(crypto_sign_expand_pk(epk, pk) == 0);
+  randombytes(ctx, CTXLEN);
+  MLD_CT_TESTING_SECRET(ctx, sizeof(ctx));
+  randombytes(m, MLEN);
+  MLD_CT_TESTING_SECRET(m, sizeof(m));
+
+  CHECK(crypto_sign_signature(sig, &siglen, m, MLEN, ctx, CTXLEN, sk) == 0);
+
+  rc = crypto_sign_verify_expanded(sig, siglen, m, MLEN, ctx, CTXLEN, epk);
+
+  /* Constant time: Declassify outputs to check them. */
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (rc)
+  {
+    printf("ERROR: crypto_sign_verify_expanded\n");
+    return 1;
+  }
+
+  /* flip bit in signature */
+  randombytes((uint8_t *)&idx, sizeof(size_t));
+  idx %= CRYPTO_BYTES;
+
+  sig[idx] ^= 1;
+
+  rc = crypto_sign_verify_expanded(sig, siglen, m, MLEN, ctx, CTXLEN, epk);
+
+  /* Constant time: Declassify outputs to check them. */
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (!rc)
+  {
+    printf("ERROR: wrong_sig: crypto_sign_verify_expanded\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+static int test_sign_iov(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  mld_iovec iov[4];
+  size_t siglen;
+  int rc;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  randombytes(ctx, CTXLEN);
+  MLD_CT_TESTING_SECRET(ctx, sizeof(ctx));
+  randombytes(m, MLEN);
+  MLD_CT_TESTING_SECRET(m, sizeof(m));
+
+  /* Split m into segments, including an empty one */
+  iov[0].ptr = m;
+  iov[0].len = 7;
+  iov[1].ptr = NULL;
+  iov[1].len = 0;
+  iov[2].ptr = m + 7;
+  iov[2].len = 40;
+  iov[3].ptr = m + 47;
+  iov[3].len = MLEN - 47;
+
+  /* Segmented and contiguous messages must be interchangeable */
+  CHECK(crypto_sign_signature_iov(sig, &siglen, iov, 4, ctx, CTXLEN, sk) ==
+        0);
+  rc = crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (rc)
+  {
+    printf("ERROR: crypto_sign_signature_iov\n");
+    return 1;
+  }
+
+  CHECK(crypto_sign_signature(sig, &siglen, m, MLEN, ctx, CTXLEN, sk) == 0);
+  rc = crypto_sign_verify_iov(sig, siglen, iov, 4, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (rc)
+  {
+    printf("ERROR: crypto_sign_verify_iov\n");
+    return 1;
+  }
+
+  /* Dropping a segment must make verification fail */
+  rc = crypto_sign_verify_iov(sig, siglen, iov, 3, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (!rc)
+  {
+    printf("ERROR: crypto_sign_verify_iov - truncated message\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+#if defined(MLD_CONFIG_VERIFY_CACHE)
+static int test_verify_cache(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  size_t siglen;
+  uint64_t hits, misses;
+  int i, rc;
+
+  /* Key generation, including the PCT, must not touch the cache */
+  crypto_sign_verify_cache_clear();
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  crypto_sign_verify_cache_counters(&hits, &misses);
+  CHECK(hits == 0 && misses == 0);
+
+  randombytes(ctx, CTXLEN);
+  randombytes(m, MLEN);
+  CHECK(crypto_sign_signature(sig, &siglen, m, MLEN, ctx, CTXLEN, sk) == 0);
+  MLD_CT_TESTING_DECLASSIFY(sig, sizeof(sig));
+
+  /* Repeated verifications, the later ones served from the cache */
+  for (i = 0; i < 3; i++)
+  {
+    rc = crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
+    MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+    CHECK(rc == 0);
+  }
+  crypto_sign_verify_cache_counters(&hits, &misses);
+  CHECK(hits == 2 && misses == 1);
+
+  /* A cached signature must not verify with a different message,
+   * context or public key */
+  m[0] ^= 1;
+  CHECK(crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk) == -1);
+  m[0] ^= 1;
+  CHECK(crypto_sign_verify(sig, siglen, m, MLEN, NULL, 0, pk) == -1);
+  pk[0] ^= 1;
+  CHECK(crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk) == -1);
+  pk[0] ^= 1;
+
+  /* Failures must not be cached */
+  sig[0] ^= 1;
+  for (i = 0; i < 2; i++)
+  {
+    rc = crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
+    MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+    CHECK(rc == -1);
+  }
+  sig[0] ^= 1;
+  crypto_sign_verify_cache_counters(&hits, &misses);
+  CHECK(hits == 2 && misses == 6);
+
+  crypto_sign_verify_cache_clear();
+  rc = crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  CHECK(rc == 0);
+  crypto_sign_verify_cache_counters(&hits, &misses);
+  CHECK(hits == 0 && misses == 1);
+  return 0;
+}
+#endif /* MLD_CONFIG_VERIFY_CACHE */
+
+#if defined(MLD_CONFIG_STATS)
+static int test_stats(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  mld_sign_stats stats;
+  uint64_t rejects, hist;
+  size_t siglen;
+  unsigned i;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  randombytes(m, MLEN);
+
+  /* Key generation may sign for the PCT, so reset only now */
+  crypto_sign_stats_reset();
+  for (i = 0; i < NSTATS; i++)
+  {
+    m[0] = (uint8_t)i;
+    CHECK(crypto_sign_signature(sig, &siglen, m, MLEN, NULL, 0, sk) == 0);
+  }
+
+  crypto_sign_stats_get(&stats);
+  CHECK(stats.signatures == NSTATS);
+  CHECK(stats.attempts >= NSTATS);
+  CHECK(stats.last_attempts >= 1);
+
+  /* Every attempt but the last one of each signature is a rejection */
+  rejects = 0;
+  for (i = 0; i < MLD_STATS_NUM_REJECTS; i++)
+  {
+    rejects += stats.rejects[i];
+  }
+  CHECK(rejects == stats.attempts - stats.signatures);
+
+  hist = 0;
+  for (i = 0; i < MLD_STATS_MAX_ATTEMPTS; i++)
+  {
+    hist += stats.attempts_hist[i];
+  }
+  CHECK(hist == NSTATS);
+
+  crypto_sign_stats_reset();
+  crypto_sign_stats_get(&stats);
+  CHECK(stats.signatures == 0 && stats.attempts == 0);
+  return 0;
+}
+#endif /* MLD_CONFIG_STATS */
+
 int main(void)
 {
   unsigned i;
@@ -249,9 +572,19 @@ int main(void)
   for (i = 0; i < NTESTS; i++)
   {
     r = test_sign();
+    r |= test_sign_inplace();
     r |= test_wrong_pk();
     r |= test_wrong_sig();
     r |= test_wrong_ctx();
+    r |= test_verify_expanded();
+    r |= test_sig_precheck();
+    r |= test_sign_iov();
+#if defined(MLD_CONFIG_VERIFY_CACHE)
+    r |= test_verify_cache();
+#endif
+#if defined(MLD_CONFIG_STATS)
+    r |= test_stats();
+#endif
     if (r)
     {
       return 1;
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+
+/* Functional tests of the APIs that are only declared in the internal
+ * header sign.h. The public API in api.h is covered by test_mldsa.c. */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "../mldsa/opcount.h"
+#include "../mldsa/sign.h"
+#include "../mldsa/sys.h"
+#include "notrandombytes/notrandombytes.h"
+
+#ifndef NTESTS
+#define NTESTS 100
+#endif
+#define MLEN 59
+#define CTXLEN 1
+/* Not a multiple of 4, to cover the remainder of batched key generation */
+#define NBATCH 9
+
+#define CHECK(x)                                              \
+  do                                                          \
+  {                                                           \
+    int r;                                                    \
+    r = (x);                                                  \
+    if (!r)                                                   \
+    {                                                         \
+      fprintf(stderr, "ERROR (%s,%d)\n", __FILE__, __LINE__); \
+      return 1;                                               \
+    }                                                         \
+  } while (0)
+
+static int test_sign_ctx(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  mld_sign_ctx sctx;
+  size_t siglen;
+  int rc;
+
+  CHECK(crypto_sign_keypair_ctx(pk, sk, &sctx) == 0);
+  randombytes(ctx, CTXLEN);
+  MLD_CT_TESTING_SECRET(ctx, sizeof(ctx));
+  randombytes(m, MLEN);
+  MLD_CT_TESTING_SECRET(m, sizeof(m));
+
+  /* Signatures from the signing context and from sk must both verify */
+  CHECK(crypto_sign_signature_ctx(sig, &siglen, m, MLEN, ctx, CTXLEN, &sctx) ==
+        0);
+  rc = crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (rc)
+  {
+    printf("ERROR: crypto_sign_signature_ctx\n");
+    return 1;
+  }
+
+  CHECK(crypto_sign_signature(sig, &siglen, m, MLEN, ctx, CTXLEN, sk) == 0);
+  rc = crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (rc)
+  {
+    printf("ERROR: crypto_sign_keypair_ctx - sk\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+static int test_mu_midstate(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  uint8_t mu[MLDSA_CRHBYTES];
+  keccak_state state;
+  size_t siglen;
+  int rc;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  randombytes(ctx, CTXLEN);
+  MLD_CT_TESTING_SECRET(ctx, sizeof(ctx));
+  randombytes(m, MLEN);
+  MLD_CT_TESTING_SECRET(m, sizeof(m));
+
+  /* mu from the midstate must match the one computed from the message */
+  CHECK(crypto_sign_mu_midstate(&state, pk) == 0);
+  CHECK(crypto_sign_mu_from_midstate(mu, &state, m, MLEN, ctx, CTXLEN) == 0);
+  CHECK(crypto_sign_signature_extmu(sig, &siglen, mu, sk) == 0);
+
+  rc = crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
+  rc |= crypto_sign_verify_extmu(sig, siglen, mu, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (rc)
+  {
+    printf("ERROR: crypto_sign_mu_from_midstate\n");
+    return 1;
+  }
+
+  /* The state must be reusable for further messages */
+  m[0] ^= 1;
+  CHECK(crypto_sign_mu_from_midstate(mu, &state, m, MLEN, ctx, CTXLEN) == 0);
+  rc = crypto_sign_verify_extmu(sig, siglen, mu, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (!rc)
+  {
+    printf("ERROR: crypto_sign_mu_from_midstate - modified message\n");
+    return 1;
+  }
+
+  CHECK(crypto_sign_mu_from_midstate(mu, &state, m, MLEN, NULL, 256) == -1);
+  return 0;
+}
+
+static int test_sign_resumable(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  mld_sign_state state;
+  size_t siglen;
+  int rc;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  randombytes(ctx, CTXLEN);
+  MLD_CT_TESTING_SECRET(ctx, sizeof(ctx));
+  randombytes(m, MLEN);
+  MLD_CT_TESTING_SECRET(m, sizeof(m));
+
+  /* One attempt per step until done */
+  CHECK(crypto_sign_start(&state, m, MLEN, ctx, CTXLEN, sk) == 0);
+  CHECK(crypto_sign_step(sig, &state, 0) == 1);
+  do
+  {
+    rc = crypto_sign_step(sig, &state, 1);
+    MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  } while (rc == 1);
+  CHECK(rc == 0);
+  CHECK(crypto_sign_step(sig, &state, 1) == 0);
+  CHECK(crypto_sign_finish(sig, &siglen, &state) == 0);
+  CHECK(siglen == CRYPTO_BYTES);
+
+  rc = crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk);
+  MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  if (rc)
+  {
+    printf("ERROR: crypto_sign_step\n");
+    return 1;
+  }
+
+  /* Aborting before any attempt must fail cleanly */
+  CHECK(crypto_sign_start(&state, m, MLEN, ctx, CTXLEN, sk) == 0);
+  CHECK(crypto_sign_finish(sig, &siglen, &state) == -1);
+  CHECK(siglen == 0);
+
+  /* A failed start must leave a state that step and finish reject */
+  CHECK(crypto_sign_start(&state, m, MLEN, NULL, 256, sk) == -1);
+  CHECK(crypto_sign_step(sig, &state, 1) == -1);
+  CHECK(crypto_sign_finish(sig, &siglen, &state) == -1);
+  CHECK(siglen == 0);
+  return 0;
+}
+
+/* Given the same randomness, resumable signing must produce the signature
+ * of crypto_sign_signature(). Both read rnd from randombytes(), which is
+ * reset before each of them; this is run once, since the reset also
+ * restarts the randomness of all later tests. */
+static int test_sign_resumable_matches(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t sig_ref[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  mld_sign_state state;
+  size_t siglen;
+  int rc;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  randombytes(ctx, CTXLEN);
+  MLD_CT_TESTING_SECRET(ctx, sizeof(ctx));
+  randombytes(m, MLEN);
+  MLD_CT_TESTING_SECRET(m, sizeof(m));
+
+  randombytes_reset();
+  CHECK(crypto_sign_signature(sig_ref, &siglen, m, MLEN, ctx, CTXLEN, sk) ==
+        0);
+  randombytes_reset();
+  CHECK(crypto_sign_start(&state, m, MLEN, ctx, CTXLEN, sk) == 0);
+  do
+  {
+    rc = crypto_sign_step(sig, &state, 1);
+    MLD_CT_TESTING_DECLASSIFY(rc, sizeof(int));
+  } while (rc == 1);
+  CHECK(crypto_sign_finish(sig, &siglen, &state) == 0);
+  CHECK(siglen == CRYPTO_BYTES);
+
+  /* Constant time: Declassify outputs to check them. */
+  MLD_CT_TESTING_DECLASSIFY(sig, sizeof(sig));
+  MLD_CT_TESTING_DECLASSIFY(sig_ref, sizeof(sig_ref));
+  CHECK(memcmp(sig, sig_ref, CRYPTO_BYTES) == 0);
+  return 0;
+}
+
+#if defined(MLD_CONFIG_OPCOUNT)
+static int test_opcount(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  static uint8_t epk[CRYPTO_EXPANDEDPUBLICKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  mld_opcount counts;
+  size_t siglen;
+  unsigned i;
+
+  CHECK(crypto_sign_keypair(pk, sk) == 0);
+  CHECK(crypto_sign_expand_pk(epk, pk) == 0);
+  randombytes(m, MLEN);
+  CHECK(crypto_sign_signature(sig, &siglen, m, MLEN, NULL, 0, sk) == 0);
+
+  /* Verification expands A and transforms z, c and t1 exactly once */
+  crypto_sign_opcount_reset();
+  CHECK(crypto_sign_verify(sig, siglen, m, MLEN, NULL, 0, pk) == 0);
+  crypto_sign_opcount_get(&counts);
+  CHECK(counts.count[MLD_OPCOUNT_MATRIX_POLY] == MLDSA_K * MLDSA_L);
+  CHECK(counts.count[MLD_OPCOUNT_NTT] == MLDSA_L + 1 + MLDSA_K);
+  CHECK(counts.count[MLD_OPCOUNT_INVNTT] == MLDSA_K);
+  CHECK(counts.count[MLD_OPCOUNT_KECCAK_X1] > 0);
+
+  /* ... and with an expanded public key, A is not expanded at all */
+  crypto_sign_opcount_reset();
+  CHECK(crypto_sign_verify_expanded(sig, siglen, m, MLEN, NULL, 0, epk) == 0);
+  crypto_sign_opcount_get(&counts);
+  CHECK(counts.count[MLD_OPCOUNT_MATRIX_POLY] == 0);
+  CHECK(counts.count[MLD_OPCOUNT_KECCAK_X4] == 0);
+
+  crypto_sign_opcount_reset();
+  crypto_sign_opcount_get(&counts);
+  for (i = 0; i < MLD_OPCOUNT_NUM; i++)
+  {
+    CHECK(counts.count[i] == 0);
+  }
+  return 0;
+}
+#endif /* MLD_CONFIG_OPCOUNT */
+
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+/* The sparse product c*s of MLD_CONFIG_SMALL_SECRETS must agree modulo q
+ * with the NTT-based product of the default configuration. */
+static int test_small_secrets(void)
+{
+  uint8_t seed[MLDSA_CTILDEBYTES];
+  uint8_t rnd[MLDSA_N];
+  mld_poly c, s, r_ntt, r_sparse;
+  mld_poly_small s_small;
+  unsigned i;
+
+  randombytes(seed, sizeof(seed));
+  randombytes(rnd, sizeof(rnd));
+  mld_poly_challenge(&c, seed);
+  for (i = 0; i < MLDSA_N; i++)
+  {
+    s.coeffs[i] = (int32_t)(rnd[i] % (2 * MLDSA_ETA + 1)) - MLDSA_ETA;
+  }
+
+  mld_poly_small_from_poly(&s_small, &s);
+  mld_poly_challenge_mul_small(&r_sparse, &c, &s_small);
+
+  mld_poly_ntt(&c);
+  mld_poly_ntt(&s);
+  mld_poly_pointwise_montgomery(&r_ntt, &c, &s);
+  mld_poly_invntt_tomont(&r_ntt);
+
+  mld_poly_reduce(&r_ntt);
+  mld_poly_caddq(&r_ntt);
+  mld_poly_reduce(&r_sparse);
+  mld_poly_caddq(&r_sparse);
+  CHECK(memcmp(&r_ntt, &r_sparse, sizeof(mld_poly)) == 0);
+  return 0;
+}
+#endif /* MLD_CONFIG_SMALL_SECRETS */
+
+#if defined(MLD_CONFIG_RUNTIME_CPU_DISPATCH_FALLBACK_TEST) && \
+    defined(MLD_SYS_X86_64_AVX2_DISPATCH)
+/* When the fallback is forced, the AVX2 backends must not be selected, so
+ * that the remaining tests exercise the portable code. */
+static int test_cpu_fallback(void)
+{
+  if (mld_force_cpu_fallback())
+  {
+    CHECK(mld_sys_has_avx2() == 0);
+  }
+  printf("Runtime CPU dispatch: %s\n",
+         mld_sys_has_avx2() ? "AVX2" : "portable fallback");
+  return 0;
+}
+#endif /* MLD_CONFIG_RUNTIME_CPU_DISPATCH_FALLBACK_TEST && \
+          MLD_SYS_X86_64_AVX2_DISPATCH */
+
+#if defined(MLD_CONFIG_KEYGEN_PCT_BREAKAGE_TEST)
+static int is_zero(const uint8_t *buf, size_t len)
+{
+  size_t i;
+  uint8_t acc = 0;
+  for (i = 0; i < len; i++)
+  {
+    acc |= buf[i];
+  }
+  return acc == 0;
+}
+
+/* With the PCT broken, key generation must fail and must not leave the
+ * rejected key pairs in the output buffers. */
+static int test_pct_failure(void)
+{
+  static uint8_t pks[NBATCH][CRYPTO_PUBLICKEYBYTES];
+  static uint8_t sks[NBATCH][CRYPTO_SECRETKEYBYTES];
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t seeds[NBATCH][MLDSA_SEEDBYTES];
+  mld_sign_ctx sctx;
+
+  CHECK(crypto_sign_keypair(pk, sk) == -1);
+  CHECK(is_zero(pk, sizeof(pk)));
+  CHECK(is_zero(sk, sizeof(sk)));
+
+  CHECK(crypto_sign_keypair_ctx(pk, sk, &sctx) == -1);
+  CHECK(is_zero(pk, sizeof(pk)));
+  CHECK(is_zero(sk, sizeof(sk)));
+  CHECK(is_zero((const uint8_t *)&sctx, sizeof(sctx)));
+
+  randombytes(seeds[0], sizeof(seeds));
+  CHECK(crypto_sign_keypair_batch(pks[0], sks[0], seeds[0], NBATCH) == -1);
+  CHECK(is_zero(pks[0], sizeof(pks)));
+  CHECK(is_zero(sks[0], sizeof(sks)));
+
+  printf("PCT failure: key generation failed and zeroized its outputs\n");
+  return 0;
+}
+#endif /* MLD_CONFIG_KEYGEN_PCT_BREAKAGE_TEST */
+
+static int test_keypair_batch(void)
+{
+  static uint8_t pks[NBATCH][CRYPTO_PUBLICKEYBYTES];
+  static uint8_t sks[NBATCH][CRYPTO_SECRETKEYBYTES];
+  static uint8_t pk[NBATCH][CRYPTO_PUBLICKEYBYTES];
+  static uint8_t sk[NBATCH][CRYPTO_SECRETKEYBYTES];
+  uint8_t seeds[NBATCH][MLDSA_SEEDBYTES];
+  unsigned i;
+
+  randombytes(seeds[0], sizeof(seeds));
+  MLD_CT_TESTING_SECRET(seeds, sizeof(seeds));
+
+  for (i = 0; i < NBATCH; i++)
+  {
+    CHECK(crypto_sign_keypair_internal(pk[i], sk[i], seeds[i]) == 0);
+  }
+
+  CHECK(crypto_sign_keypair_batch(pks[0], sks[0], seeds[0], NBATCH) == 0);
+
+  /* Constant time: Declassify outputs to check them. */
+  MLD_CT_TESTING_DECLASSIFY(sks, sizeof(sks));
+  MLD_CT_TESTING_DECLASSIFY(sk, sizeof(sk));
+  CHECK(memcmp(pks, pk, sizeof(pk)) == 0);
+  CHECK(memcmp(sks, sk, sizeof(sk)) == 0);
+  return 0;
+}
+
+int main(void)
+{
+  unsigned i;
+  int r;
+
+  /* WARNING: Test-only
+   * Normally, you would want to seed a PRNG with trustworthy entropy here. */
+  randombytes_reset();
+
+#if defined(MLD_CONFIG_KEYGEN_PCT_BREAKAGE_TEST)
+  if (mld_break_pct())
+  {
+    return test_pct_failure();
+  }
+#endif
+
+#if defined(MLD_CONFIG_RUNTIME_CPU_DISPATCH_FALLBACK_TEST) && \
+    defined(MLD_SYS_X86_64_AVX2_DISPATCH)
+  if (test_cpu_fallback())
+  {
+    return 1;
+  }
+#endif
+
+  if (test_keypair_batch())
+  {
+    return 1;
+  }
+
+  if (test_sign_resumable_matches())
+  {
+    return 1;
+  }
+
+  for (i = 0; i < NTESTS; i++)
+  {
+    r = test_sign_ctx();
+    r |= test_mu_midstate();
+    r |= test_sign_resumable();
+#if defined(MLD_CONFIG_SMALL_SECRETS)
+    r |= test_small_secrets();
+#endif
+#if defined(MLD_CONFIG_OPCOUNT)
+    r |= test_opcount();
+#endif
+    if (r)
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
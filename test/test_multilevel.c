@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) The mldsa-native project authors
+ * SPDX-License-Identifier: Apache-2.0 OR ISC OR MIT
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "../mldsa/api.h"
+#include "notrandombytes/notrandombytes.h"
+
+#ifndef NTESTS
+#define NTESTS 10
+#endif
+#define MLEN 59
+#define CTXLEN 1
+
+#define MAX_PUBLICKEYBYTES MLD_87_PUBLICKEYBYTES
+#define MAX_SECRETKEYBYTES MLD_87_SECRETKEYBYTES
+#define MAX_BYTES MLD_87_BYTES
+
+#define CHECK(x)                                              \
+  do                                                          \
+  {                                                           \
+    int r;                                                    \
+    r = (x);                                                  \
+    if (!r)                                                   \
+    {                                                         \
+      fprintf(stderr, "ERROR (%s,%d)\n", __FILE__, __LINE__); \
+      return 1;                                               \
+    }                                                         \
+  } while (0)
+
+typedef struct
+{
+  int level;
+  size_t pkbytes;
+  size_t skbytes;
+  size_t sigbytes;
+  int (*keypair)(uint8_t *pk, uint8_t *sk);
+  int (*verify)(const uint8_t *sig, size_t siglen, const uint8_t *m,
+                size_t mlen, const uint8_t *ctx, size_t ctxlen,
+                const uint8_t *pk);
+} level_info;
+
+static const level_info levels[] = {
+    {44, MLD_44_PUBLICKEYBYTES, MLD_44_SECRETKEYBYTES, MLD_44_BYTES,
+     MLD_44_ref_keypair, MLD_44_ref_verify},
+    {65, MLD_65_PUBLICKEYBYTES, MLD_65_SECRETKEYBYTES, MLD_65_BYTES,
+     MLD_65_ref_keypair, MLD_65_ref_verify},
+    {87, MLD_87_PUBLICKEYBYTES, MLD_87_SECRETKEYBYTES, MLD_87_BYTES,
+     MLD_87_ref_keypair, MLD_87_ref_verify},
+};
+
+#define NLEVELS (sizeof(levels) / sizeof(levels[0]))
+
+static int test_keypair_matches(const level_info *l)
+{
+  uint8_t pk[MAX_PUBLICKEYBYTES], pk2[MAX_PUBLICKEYBYTES];
+  uint8_t sk[MAX_SECRETKEYBYTES], sk2[MAX_SECRETKEYBYTES];
+
+  /* The dispatcher must produce the same key as the level's own API */
+  randombytes_reset();
+  CHECK(mldsa_keypair(l->level, pk, sk) == 0);
+  randombytes_reset();
+  CHECK(l->keypair(pk2, sk2) == 0);
+
+  CHECK(memcmp(pk, pk2, l->pkbytes) == 0);
+  CHECK(memcmp(sk, sk2, l->skbytes) == 0);
+  return 0;
+}
+
+static int test_sign_verify(const level_info *l, const level_info *other)
+{
+  uint8_t pk[MAX_PUBLICKEYBYTES];
+  uint8_t sk[MAX_SECRETKEYBYTES];
+  uint8_t sig[MAX_BYTES];
+  uint8_t m[MLEN];
+  uint8_t ctx[CTXLEN];
+  size_t siglen;
+
+  CHECK(mldsa_keypair(l->level, pk, sk) == 0);
+  randombytes(ctx, CTXLEN);
+  randombytes(m, MLEN);
+
+  CHECK(mldsa_sign(l->level, sig, &siglen, m, MLEN, ctx, CTXLEN, sk) == 0);
+  CHECK(siglen == l->sigbytes);
+
+  CHECK(mldsa_verify(l->level, sig, siglen, m, MLEN, ctx, CTXLEN, pk) == 0);
+  CHECK(l->verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk) == 0);
+
+  /* A signature must not verify under a different parameter set */
+  if (other != l)
+  {
+    CHECK(mldsa_verify(other->level, sig, siglen, m, MLEN, ctx, CTXLEN, pk) !=
+          0);
+  }
+
+  sig[0] ^= 1;
+  CHECK(mldsa_verify(l->level, sig, siglen, m, MLEN, ctx, CTXLEN, pk) != 0);
+  return 0;
+}
+
+static int test_invalid_level(void)
+{
+  uint8_t pk[MAX_PUBLICKEYBYTES] = {0};
+  uint8_t sk[MAX_SECRETKEYBYTES] = {0};
+  uint8_t sig[MAX_BYTES] = {0};
+  uint8_t m[MLEN] = {0};
+  size_t siglen;
+
+  CHECK(mldsa_keypair(2, pk, sk) == -1);
+  CHECK(mldsa_sign(0, sig, &siglen, m, MLEN, NULL, 0, sk) == -1);
+  CHECK(mldsa_verify(-44, sig, MAX_BYTES, m, MLEN, NULL, 0, pk) == -1);
+  return 0;
+}
+
+int main(void)
+{
+  unsigned i, j;
+  int r = 0;
+
+  /* WARNING: Test-only
+   * Normally, you would want to seed a PRNG with trustworthy entropy here. */
+  randombytes_reset();
+
+  for (j = 0; j < NLEVELS; j++)
+  {
+    r |= test_keypair_matches(&levels[j]);
+  }
+
+  /* Interleave the parameter sets to exercise the shared code */
+  for (i = 0; i < NTESTS && r == 0; i++)
+  {
+    for (j = 0; j < NLEVELS; j++)
+    {
+      r |= test_sign_verify(&levels[j], &levels[(i + j) % NLEVELS]);
+    }
+  }
+
+  r |= test_invalid_level();
+  if (r)
+  {
+    return 1;
+  }
+
+  printf("Multilevel tests passed for ML-DSA-44, ML-DSA-65, ML-DSA-87\n");
+  return 0;
+}
@@ -8,6 +8,24 @@
 
 #include "api.h"
 
+#if defined(MLD_CONFIG_FILE)
+#include MLD_CONFIG_FILE
+#else
+#include "config.h"
+#endif
+
+/* Memory profile of this build, see MLD_CONFIG_REDUCE_RAM */
+static const char *memory_profile(void)
+{
+#if defined(MLD_CONFIG_REDUCE_RAM) && defined(MLD_CONFIG_REDUCE_RAM_CACHE_ROWS)
+  return "reduce-ram (cached rows)";
+#elif defined(MLD_CONFIG_REDUCE_RAM)
+  return "reduce-ram";
+#else
+  return "default";
+#endif
+}
+
 static void test_keygen_only(void)
 {
   unsigned char pk[CRYPTO_PUBLICKEYBYTES];
@@ -52,7 +70,7 @@ int main(int argc, char *argv[])
 {
   if (argc != 2)
   {
-    fprintf(stderr, "Usage: %s <keygen|sign|verify>\n", argv[0]);
+    fprintf(stderr, "Usage: %s <keygen|sign|verify|profile>\n", argv[0]);
     return 1;
   }
 
@@ -68,6 +86,10 @@ int main(int argc, char *argv[])
   {
     test_verify_only();
   }
+  else if (strcmp(argv[1], "profile") == 0)
+  {
+    printf("%s\n", memory_profile());
+  }
   else
   {
     fprintf(stderr, "Unknown test: %s\n", argv[1]);